@@ -34,8 +34,8 @@ OpenChestResult Chest::open() {
 Item* Chest::getItem() const { return item; }
 
 int Chest::randomInt(int min, int max) {
-    static std::random_device rd;
-    static std::mt19937 gen(rd());
+    // Thread-local so sessions on different server shards never share an engine
+    static thread_local std::mt19937 gen(std::random_device{}());
     std::uniform_int_distribution<> dist(min, max);
     return dist(gen);
 }
@@ -0,0 +1,132 @@
+//
+// Created by Connor on 19/10/2026.
+//
+
+#include "damagepipeline.hpp"
+
+#include <algorithm>
+#include <initializer_list>
+
+namespace {
+constexpr int UNARMED_MIN_DAMAGE = 3;
+constexpr int UNARMED_MAX_DAMAGE = 8;
+constexpr int UNARMED_POWER_MIN_DAMAGE = 6;
+constexpr int UNARMED_POWER_MAX_DAMAGE = 16;
+constexpr int POWER_ACCURACY_PENALTY = 10;
+constexpr int CRITICAL_CHANCE = 10;
+
+int rollMt19937(void* state, DamageRoll, int min, int max) {
+    std::uniform_int_distribution<> distribution(min, max);
+    return distribution(*static_cast<std::mt19937*>(state));
+}
+
+int roll(DamageContext& context, DamageRoll die, int min, int max) {
+    return context.roller(context.rollerState, die, min, max);
+}
+
+DamagePipeline makePipeline(std::initializer_list<DamageStage> stages) {
+    DamagePipeline pipeline;
+    for (DamageStage stage : stages) pipeline.addStage(stage);
+    return pipeline;
+}
+}  // namespace
+
+DamageContext makeDamageContext(std::mt19937& rng) {
+    DamageContext context{};
+    context.roller = rollMt19937;
+    context.rollerState = &rng;
+    return context;
+}
+
+DamagePipeline::DamagePipeline() : stages{}, stageCount(0) {}
+
+bool DamagePipeline::addStage(DamageStage stage) {
+    if (stageCount == MAX_STAGES) return false;
+    stages[stageCount++] = stage;
+    return true;
+}
+
+size_t DamagePipeline::getStageCount() const { return stageCount; }
+
+void DamagePipeline::run(DamageContext& context) const {
+    for (size_t i = 0; i < stageCount; ++i) stages[i](context);
+}
+
+void rollAccuracyStage(DamageContext& context) {
+    if (!context.armed) return;
+    int accuracy = context.accuracy - (context.power ? POWER_ACCURACY_PENALTY : 0);
+    context.missed = roll(context, DamageRoll::ACCURACY, 1, 100) > accuracy;
+}
+
+void rollStrikeStage(DamageContext& context) {
+    if (context.missed) return;
+    if (context.armed) {
+        context.damage = roll(context, DamageRoll::DAMAGE, context.minDamage, context.maxDamage) *
+                         (context.power ? 2 : 1);
+    } else if (context.power) {
+        context.damage =
+            roll(context, DamageRoll::DAMAGE, UNARMED_POWER_MIN_DAMAGE, UNARMED_POWER_MAX_DAMAGE);
+    } else {
+        context.damage = roll(context, DamageRoll::DAMAGE, UNARMED_MIN_DAMAGE, UNARMED_MAX_DAMAGE);
+    }
+}
+
+void rollAttackStage(DamageContext& context) {
+    context.damage = roll(context, DamageRoll::DAMAGE, context.minDamage, context.maxDamage);
+}
+
+void fixedDamageStage(DamageContext& context) { context.damage = context.baseDamage; }
+
+void weaponWearStage(DamageContext& context) {
+    if (!context.armed || context.missed || context.durability <= 0) return;
+    context.wear = std::min(context.power ? 2 : 1, context.durability);
+    context.durability -= context.wear;
+    context.weaponBroke = context.durability <= 0;
+}
+
+void damageBonusStage(DamageContext& context) {
+    if (context.damage > 0) context.damage += context.damageBonus;
+}
+
+void rollCriticalStage(DamageContext& context) {
+    if (context.power || context.damage <= 0) return;
+    if (roll(context, DamageRoll::CRIT, 1, 100) <= CRITICAL_CHANCE) {
+        context.damage *= 2;
+        context.critical = true;
+    }
+}
+
+void defendingStage(DamageContext& context) {
+    if (context.targetDefending) context.damage /= 2;
+}
+
+void defenceStage(DamageContext& context) {
+    context.dealt = std::max(context.damage - context.targetDefence, 0);
+}
+
+void armorWearStage(DamageContext& context) {
+    if (context.armorDurability <= 0 || context.damage <= 0) return;
+    context.armorWear = 1;
+    context.armorDurability -= context.armorWear;
+    context.armorBroke = context.armorDurability <= 0;
+}
+
+const DamagePipeline& getPlayerStrikePipeline() {
+    static const DamagePipeline pipeline =
+        makePipeline({rollAccuracyStage, rollStrikeStage, weaponWearStage, damageBonusStage,
+                      rollCriticalStage, defenceStage});
+    return pipeline;
+}
+
+const DamagePipeline& getEnemyAttackPipeline() {
+    static const DamagePipeline pipeline =
+        makePipeline({rollAttackStage, damageBonusStage, defendingStage, defenceStage,
+                      armorWearStage});
+    return pipeline;
+}
+
+const DamagePipeline& getSpellPipeline() {
+    static const DamagePipeline pipeline =
+        makePipeline({fixedDamageStage, defendingStage});
+    return pipeline;
+}
@@ -0,0 +1,93 @@
+//
+// Created by Connor on 19/10/2026.
+//
+
+#ifndef TERMINAL_RPG_DAMAGEPIPELINE_HPP
+#define TERMINAL_RPG_DAMAGEPIPELINE_HPP
+
+#include <cstddef>
+#include <random>
+
+// Which die a stage is rolling, so a roller can hand out pre-drawn values (batch simulation)
+enum class DamageRoll { ACCURACY, DAMAGE, CRIT };
+
+// Returns a uniform value in [min, max]
+using DamageRoller = int (*)(void* state, DamageRoll roll, int min, int max);
+
+// Everything one hit needs, and everything the stages work out. Plain data, so the same
+// pipeline serves the interactive game (items, encounters) and simulators (raw arrays):
+// callers copy their numbers in, run the pipeline, and copy the results back out.
+struct DamageContext {
+    DamageRoller roller;
+    void* rollerState;
+
+    // The attack
+    bool power;       // Power attack: double damage, -10 accuracy, double wear, no crits
+    bool armed;       // The range, accuracy and durability below are a weapon's
+    int minDamage;    // Weapon damage, or an enemy's attack range
+    int maxDamage;
+    int accuracy;     // Out of 100
+    int durability;   // Weapon durability, worn down on hits (0 = doesn't wear)
+    int baseDamage;   // Fixed amount, for attacks that don't roll (spells)
+    int damageBonus;  // Buffs
+
+    // The target
+    int targetDefence;  // Defence, or resistance against spells
+    bool targetDefending;
+    int armorDurability;  // Target's armour, worn down by hits that land (0 = none / doesn't wear)
+
+    // Results
+    bool missed;
+    bool critical;
+    int wear;  // Durability lost
+    bool weaponBroke;
+    int armorWear;
+    bool armorBroke;
+    int damage;  // Before the target's defence; what the combat log reports
+    int dealt;   // Health the target actually loses
+};
+
+// Zeroed context rolling with rng
+DamageContext makeDamageContext(std::mt19937& rng);
+
+using DamageStage = void (*)(DamageContext&);
+
+// An ordered list of stages, set up once and then run as a flat loop over function pointers
+class DamagePipeline {
+public:
+    static constexpr size_t MAX_STAGES = 8;
+
+    DamagePipeline();
+
+    // Returns false if the pipeline is full
+    bool addStage(DamageStage stage);
+    size_t getStageCount() const;
+
+    void run(DamageContext& context) const;
+
+private:
+    DamageStage stages[MAX_STAGES];
+    size_t stageCount;
+};
+
+// Stages, in the order the standard pipelines use them
+void rollAccuracyStage(DamageContext& context);    // Armed only: may miss
+void rollStrikeStage(DamageContext& context);      // Weapon roll, or bare hands
+void rollAttackStage(DamageContext& context);      // Enemy attack range
+void fixedDamageStage(DamageContext& context);     // damage = baseDamage
+void weaponWearStage(DamageContext& context);      // Armed hits wear the weapon down
+void damageBonusStage(DamageContext& context);     // Adds buffs to anything that landed
+void rollCriticalStage(DamageContext& context);    // 10% to double a normal attack
+void defendingStage(DamageContext& context);       // Halved against a defending target
+void defenceStage(DamageContext& context);         // dealt = damage - defence, at least 0
+void armorWearStage(DamageContext& context);       // Hits that land wear the target's armour
+
+// Player weapon or bare-handed strikes
+const DamagePipeline& getPlayerStrikePipeline();
+// Enemy physical attacks (spells go around armour, so they don't wear it)
+const DamagePipeline& getEnemyAttackPipeline();
+// Fixed-damage spells. They stop short of resistance: the target's takeSpellDamage applies it to
+// damage, and dealt is left at 0.
+const DamagePipeline& getSpellPipeline();
+
+#endif  // TERMINAL_RPG_DAMAGEPIPELINE_HPP
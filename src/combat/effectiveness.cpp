@@ -0,0 +1,166 @@
+//
+// Created by Connor on 19/10/2026.
+//
+
+#include "effectiveness.hpp"
+
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+
+namespace {
+constexpr const char* WEAPON_TYPE_NAMES[WEAPON_TYPE_COUNT] = {
+    "SWORD", "AXE", "BOW", "DAGGER", "STAFF", "MACE", "SPEAR", "CROSSBOW", "HAMMER"};
+constexpr const char* ENEMY_TYPE_NAMES[ENEMY_TYPE_COUNT] = {
+    "BEAST", "UNDEAD", "HUMANOID", "DRAGON", "ELEMENTAL", "DEMON", "GOBLINOID"};
+
+// Rows are weapon types, columns enemy types, both in enum order
+constexpr uint16_t DEFAULT_PERCENT[WEAPON_TYPE_COUNT][ENEMY_TYPE_COUNT] = {
+    //  BEAST UNDEAD HUMANOID DRAGON ELEMENTAL DEMON GOBLINOID
+    {100, 100, 110, 90, 90, 100, 110},   // SWORD: an all-rounder
+    {120, 90, 110, 100, 80, 100, 110},   // AXE: cleaves flesh
+    {125, 70, 100, 110, 80, 100, 110},   // BOW: hunting, useless against bones
+    {110, 60, 130, 60, 70, 90, 120},     // DAGGER: finds gaps in armour, not in scales
+    {100, 130, 100, 80, 70, 120, 100},   // STAFF: holy fire for the dead and damned
+    {90, 150, 100, 90, 110, 110, 100},   // MACE: shatters skeletons
+    {130, 80, 100, 120, 80, 100, 110},   // SPEAR: keeps big things at a distance
+    {120, 80, 110, 120, 80, 100, 100},   // CROSSBOW: punches through hide
+    {90, 140, 100, 100, 130, 110, 90},   // HAMMER: breaks bone and stone
+};
+
+static_assert(DEFAULT_PERCENT[SWORD][static_cast<size_t>(EnemyType::BEAST)] ==
+                  EffectivenessMatrix::NEUTRAL_PERCENT,
+              "Swords are the baseline");
+
+size_t cell(WeaponType weaponType, EnemyType enemyType) {
+    return static_cast<size_t>(weaponType) * ENEMY_TYPE_COUNT + static_cast<size_t>(enemyType);
+}
+
+template <size_t N>
+bool findName(const char* const (&names)[N], const std::string& name, size_t& index) {
+    for (size_t i = 0; i < N; ++i) {
+        if (name == names[i]) {
+            index = i;
+            return true;
+        }
+    }
+    return false;
+}
+}  // namespace
+
+DamageChannel getDamageChannel(WeaponType weaponType) {
+    return weaponType == STAFF ? DamageChannel::SPELL : DamageChannel::PHYSICAL;
+}
+
+const char* getWeaponTypeName(WeaponType weaponType) {
+    return WEAPON_TYPE_NAMES[static_cast<size_t>(weaponType)];
+}
+
+const char* getEnemyTypeName(EnemyType enemyType) {
+    return ENEMY_TYPE_NAMES[static_cast<size_t>(enemyType)];
+}
+
+EffectivenessMatrix& EffectivenessMatrix::getInstance() {
+    static EffectivenessMatrix instance;
+    return instance;
+}
+
+EffectivenessMatrix::EffectivenessMatrix() : percent{} { initialize(); }
+
+void EffectivenessMatrix::initialize() {
+    for (size_t weapon = 0; weapon < WEAPON_TYPE_COUNT; ++weapon) {
+        for (size_t enemy = 0; enemy < ENEMY_TYPE_COUNT; ++enemy) {
+            percent[weapon * ENEMY_TYPE_COUNT + enemy] = DEFAULT_PERCENT[weapon][enemy];
+        }
+    }
+}
+
+int EffectivenessMatrix::getPercent(WeaponType weaponType, EnemyType enemyType) const {
+    return percent[cell(weaponType, enemyType)];
+}
+
+int EffectivenessMatrix::getDefaultPercent(WeaponType weaponType, EnemyType enemyType) {
+    return DEFAULT_PERCENT[static_cast<size_t>(weaponType)][static_cast<size_t>(enemyType)];
+}
+
+bool EffectivenessMatrix::setPercent(WeaponType weaponType, EnemyType enemyType, int value) {
+    if (value < 0 || value > MAX_PERCENT) return false;
+    percent[cell(weaponType, enemyType)] = static_cast<uint16_t>(value);
+    return true;
+}
+
+bool EffectivenessMatrix::loadOverrides(std::istream& in, std::string& error) {
+    // Parsed into a copy, so a bad file leaves the current table alone
+    std::array<uint16_t, WEAPON_TYPE_COUNT * ENEMY_TYPE_COUNT> loaded = percent;
+
+    std::string line;
+    int lineNumber = 0;
+    while (std::getline(in, line)) {
+        ++lineNumber;
+        size_t comment = line.find('#');
+        if (comment != std::string::npos) line.erase(comment);
+
+        std::istringstream fields(line);
+        std::string weaponName;
+        if (!(fields >> weaponName)) continue;  // Blank
+
+        std::string enemyName;
+        int value = 0;
+        std::string extra;
+        size_t weapon = 0;
+        size_t enemy = 0;
+        if (!(fields >> enemyName >> value) || (fields >> extra)) {
+            error = "line " + std::to_string(lineNumber) + ": expected <WEAPON> <ENEMY> <PERCENT>";
+            return false;
+        }
+        if (!findName(WEAPON_TYPE_NAMES, weaponName, weapon)) {
+            error = "line " + std::to_string(lineNumber) + ": unknown weapon type " + weaponName;
+            return false;
+        }
+        if (!findName(ENEMY_TYPE_NAMES, enemyName, enemy)) {
+            error = "line " + std::to_string(lineNumber) + ": unknown enemy type " + enemyName;
+            return false;
+        }
+        if (value < 0 || value > MAX_PERCENT) {
+            error = "line " + std::to_string(lineNumber) + ": percent must be 0-" +
+                    std::to_string(MAX_PERCENT);
+            return false;
+        }
+        loaded[weapon * ENEMY_TYPE_COUNT + enemy] = static_cast<uint16_t>(value);
+    }
+
+    percent = loaded;
+    return true;
+}
+
+bool EffectivenessMatrix::loadOverridesFile(const std::string& path, std::string& error) {
+    std::ifstream file(path);
+    if (!file) {
+        error = "can't open " + path;
+        return false;
+    }
+    return loadOverrides(file, error);
+}
+
+bool EffectivenessMatrix::loadOverridesFromEnvironment(std::string& error) {
+    const char* path = std::getenv("TERMINAL_RPG_EFFECTIVENESS");
+    if (!path) return true;
+    return loadOverridesFile(path, error);
+}
+
+int applyEffectiveness(int damage, int percent) {
+    return damage * percent / EffectivenessMatrix::NEUTRAL_PERCENT;
+}
+
+void aimStrike(DamageContext& strike, WeaponType weaponType, EnemyType target, int defence,
+               int resistance) {
+    if (!strike.armed) {
+        strike.targetDefence = defence;
+        return;
+    }
+    int percent = EffectivenessMatrix::getInstance().getPercent(weaponType, target);
+    strike.minDamage = applyEffectiveness(strike.minDamage, percent);
+    strike.maxDamage = applyEffectiveness(strike.maxDamage, percent);
+    strike.targetDefence =
+        getDamageChannel(weaponType) == DamageChannel::SPELL ? resistance : defence;
+}
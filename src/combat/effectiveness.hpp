@@ -0,0 +1,76 @@
+//
+// Created by Connor on 19/10/2026.
+//
+
+#ifndef TERMINAL_RPG_EFFECTIVENESS_HPP
+#define TERMINAL_RPG_EFFECTIVENESS_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <istream>
+#include <string>
+
+#include "../enemies/enemy.hpp"
+#include "../items/item.hpp"
+#include "damagepipeline.hpp"
+
+constexpr size_t WEAPON_TYPE_COUNT = static_cast<size_t>(HAMMER) + 1;
+
+// Which of the target's stats a hit goes against
+enum class DamageChannel : uint8_t {
+    PHYSICAL,  // Defence
+    SPELL      // Resistance
+};
+
+// Staves cast; everything else is physical
+DamageChannel getDamageChannel(WeaponType weaponType);
+
+const char* getWeaponTypeName(WeaponType weaponType);
+const char* getEnemyTypeName(EnemyType enemyType);
+
+// How well each weapon type does against each enemy type, as a percentage of the damage roll.
+// Starts from a built-in constexpr table; designers can override single entries from a content
+// file. Stored flat, so a lookup is one indexed load.
+class EffectivenessMatrix {
+public:
+    static constexpr int NEUTRAL_PERCENT = 100;
+    static constexpr int MAX_PERCENT = 500;
+
+    static EffectivenessMatrix& getInstance();
+
+    // Back to the built-in table
+    void initialize();
+
+    int getPercent(WeaponType weaponType, EnemyType enemyType) const;
+    static int getDefaultPercent(WeaponType weaponType, EnemyType enemyType);
+    // Returns false if value is outside [0, MAX_PERCENT]
+    bool setPercent(WeaponType weaponType, EnemyType enemyType, int value);
+
+    // One "<WEAPON TYPE> <ENEMY TYPE> <PERCENT>" override per line (e.g. "MACE UNDEAD 175"),
+    // with blank lines and '#' comments ignored. All or nothing: on a bad line nothing changes
+    // and error says which line and why.
+    bool loadOverrides(std::istream& in, std::string& error);
+    bool loadOverridesFile(const std::string& path, std::string& error);
+    // Loads the file named by TERMINAL_RPG_EFFECTIVENESS, if it's set
+    bool loadOverridesFromEnvironment(std::string& error);
+
+private:
+    EffectivenessMatrix();
+    ~EffectivenessMatrix() = default;
+    EffectivenessMatrix(const EffectivenessMatrix&) = delete;
+    EffectivenessMatrix& operator=(const EffectivenessMatrix&) = delete;
+
+    std::array<uint16_t, WEAPON_TYPE_COUNT * ENEMY_TYPE_COUNT> percent;
+};
+
+// Scales a damage figure by an effectiveness percentage
+int applyEffectiveness(int damage, int percent);
+
+// Points a player strike at an enemy. Armed strikes get their damage range scaled by the matrix
+// and go against the defence or resistance their channel calls for; bare hands are physical
+// and neutral. Call after filling in the weapon.
+void aimStrike(DamageContext& strike, WeaponType weaponType, EnemyType target, int defence,
+               int resistance);
+
+#endif  // TERMINAL_RPG_EFFECTIVENESS_HPP
@@ -0,0 +1,102 @@
+//
+// Created by Connor on 19/10/2026.
+//
+
+#include "statuseffects.hpp"
+
+#include <algorithm>
+
+StatusEffects::StatusEffects() : turn(0), activeCount(0), freeList(NONE) {
+    modifiers.fill(0);
+    innerWheel.fill(NONE);
+    outerWheel.fill(NONE);
+}
+
+void StatusEffects::apply(StatusEffectType type, int magnitude, uint32_t duration) {
+    if (duration == 0) return;
+    duration = std::min(duration, MAX_DURATION);
+
+    int32_t index;
+    if (freeList != NONE) {
+        index = freeList;
+        freeList = effects[index].next;
+    } else {
+        index = static_cast<int32_t>(effects.size());
+        effects.push_back({});
+    }
+    effects[index] = {type, magnitude, turn + duration, NONE};
+
+    modifiers[static_cast<size_t>(type)] += magnitude;
+    ++activeCount;
+    schedule(index);
+}
+
+StatusTick StatusEffects::tick() {
+    StatusTick result{modifiers[static_cast<size_t>(StatusEffectType::POISON)],
+                      modifiers[static_cast<size_t>(StatusEffectType::STAMINA_REGEN)]};
+    if (activeCount == 0) {
+        ++turn;
+        return result;
+    }
+
+    ++turn;
+    size_t innerSlot = turn % WHEEL_SLOTS;
+    if (innerSlot == 0) {
+        // Start of a new lap: bring down everything expiring during it
+        size_t outerSlot = (turn / WHEEL_SLOTS) % WHEEL_SLOTS;
+        int32_t index = outerWheel[outerSlot];
+        outerWheel[outerSlot] = NONE;
+        while (index != NONE) {
+            int32_t next = effects[index].next;
+            schedule(index);
+            index = next;
+        }
+    }
+
+    int32_t index = innerWheel[innerSlot];
+    innerWheel[innerSlot] = NONE;
+    while (index != NONE) {
+        int32_t next = effects[index].next;
+        expire(index);
+        index = next;
+    }
+    return result;
+}
+
+void StatusEffects::clear() {
+    modifiers.fill(0);
+    innerWheel.fill(NONE);
+    outerWheel.fill(NONE);
+    effects.clear();
+    freeList = NONE;
+    activeCount = 0;
+}
+
+int StatusEffects::getModifier(StatusEffectType type) const {
+    return modifiers[static_cast<size_t>(type)];
+}
+
+size_t StatusEffects::getActiveCount() const { return activeCount; }
+
+uint64_t StatusEffects::getTurn() const { return turn; }
+
+void StatusEffects::schedule(int32_t index) {
+    Effect& effect = effects[index];
+    uint64_t remaining = effect.expiresAt - turn;
+    int32_t* slot;
+    if (remaining < WHEEL_SLOTS) {
+        slot = &innerWheel[effect.expiresAt % WHEEL_SLOTS];
+    } else {
+        slot = &outerWheel[(effect.expiresAt / WHEEL_SLOTS) % WHEEL_SLOTS];
+    }
+    effect.next = *slot;
+    *slot = index;
+}
+
+void StatusEffects::expire(int32_t index) {
+    Effect& effect = effects[index];
+    modifiers[static_cast<size_t>(effect.type)] -= effect.magnitude;
+    --activeCount;
+    effect.next = freeList;
+    freeList = index;
+}
@@ -0,0 +1,77 @@
+//
+// Created by Connor on 19/10/2026.
+//
+
+#ifndef TERMINAL_RPG_STATUSEFFECTS_HPP
+#define TERMINAL_RPG_STATUSEFFECTS_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+enum class StatusEffectType {
+    DAMAGE_BOOST,   // Added to every hit that lands
+    DEFENCE,        // Added to defence
+    RESISTANCE,     // Added to resistance
+    POISON,         // Damage taken at the end of each turn
+    STAMINA_REGEN   // Stamina recovered at the end of each turn
+};
+
+constexpr size_t STATUS_EFFECT_TYPE_COUNT = 5;
+
+// What the effects did over one turn
+struct StatusTick {
+    int poisonDamage;
+    int staminaRegen;
+};
+
+// Timed modifiers on a player or enemy, measured in combat turns. The summed magnitude of
+// each effect type is cached, so reading a stat never walks the effects; expiry is driven by
+// a two-level timing wheel, so a turn only touches the effects that actually run out on it.
+class StatusEffects {
+public:
+    static constexpr uint32_t WHEEL_SLOTS = 64;
+    // Anything longer is clamped (the outer wheel covers WHEEL_SLOTS - 1 of its slots so an
+    // effect is always cascaded down before its slot comes round again)
+    static constexpr uint32_t MAX_DURATION = WHEEL_SLOTS * (WHEEL_SLOTS - 1) - 1;
+
+    StatusEffects();
+
+    // Adds magnitude to the effect type for the next duration turns (durations of 0 are ignored)
+    void apply(StatusEffectType type, int magnitude, uint32_t duration);
+
+    // Ends the turn: reports this turn's poison and regen, then expires whatever has run out
+    StatusTick tick();
+
+    // Drops every effect (e.g. at the end of a fight)
+    void clear();
+
+    int getModifier(StatusEffectType type) const;
+    size_t getActiveCount() const;
+    uint64_t getTurn() const;
+
+private:
+    static constexpr int32_t NONE = -1;
+
+    struct Effect {
+        StatusEffectType type;
+        int magnitude;
+        uint64_t expiresAt;
+        int32_t next;  // Next effect in the same wheel slot, or the free list
+    };
+
+    uint64_t turn;
+    size_t activeCount;
+    std::array<int, STATUS_EFFECT_TYPE_COUNT> modifiers;
+
+    std::vector<Effect> effects;
+    int32_t freeList;
+    std::array<int32_t, WHEEL_SLOTS> innerWheel;  // Expiring within WHEEL_SLOTS turns
+    std::array<int32_t, WHEEL_SLOTS> outerWheel;  // Expiring later, grouped by WHEEL_SLOTS turns
+
+    void schedule(int32_t index);
+    void expire(int32_t index);
+};
+
+#endif  // TERMINAL_RPG_STATUSEFFECTS_HPP
@@ -0,0 +1,290 @@
+//
+// Created by Connor on 19/10/2026.
+//
+
+#include "encounter.hpp"
+
+#include <algorithm>
+#include <utility>
+
+#include "../combat/damagepipeline.hpp"
+#include "enemydatabase.hpp"
+
+namespace {
+// Percent of a stat, never less than 1
+int percentOf(int value, int percent) { return std::max(1, value * percent / 100); }
+}  // namespace
+
+size_t Encounter::addEnemy(const Enemy& enemy, EnemyAI enemyAI) {
+    return addEnemy(enemy, enemyAI, makeEnemyBehaviour(enemy.getType(), enemy.getRarity()));
+}
+
+size_t Encounter::addEnemy(const Enemy& enemy, EnemyAI enemyAI, const EnemyBehaviour& behaviour) {
+    return add(enemy.getInternedName(), enemy.getLevel(), enemy.getHealth(), enemy.getMinAttack(),
+               enemy.getMaxAttack(), enemy.getDefence(), enemy.getResistance(), enemy.getType(),
+               enemy.getRarity(), enemyAI, behaviour);
+}
+
+size_t Encounter::addEnemy(const EnemyTemplate& enemyTemplate, EnemyAI enemyAI) {
+    return add(enemyTemplate.name, enemyTemplate.level, enemyTemplate.health,
+               enemyTemplate.minAttack, enemyTemplate.maxAttack, enemyTemplate.defence,
+               enemyTemplate.resistance, enemyTemplate.type, enemyTemplate.rarity, enemyAI,
+               enemyTemplate.behaviour);
+}
+
+size_t Encounter::add(InternedString name, int enemyLevel, int enemyHealth, int enemyMinAttack,
+                      int enemyMaxAttack, int enemyDefence, int enemyResistance, EnemyType type,
+                      EnemyRarity rarity, EnemyAI enemyAI, const EnemyBehaviour& behaviour) {
+    size_t index = names.size();
+    names.push_back(name);
+    health.push_back(enemyHealth);
+    maxHealth.push_back(enemyHealth);
+    minAttack.push_back(enemyMinAttack);
+    maxAttack.push_back(enemyMaxAttack);
+    defence.push_back(enemyDefence);
+    resistance.push_back(enemyResistance);
+    level.push_back(enemyLevel);
+    types.push_back(type);
+    rarities.push_back(rarity);
+    ai.push_back(enemyAI);
+    behaviours.push_back(behaviour);
+    spentRules.push_back(0);
+    fled.push_back(0);
+    // A spare slot left by clear() or removeDefeated() keeps its wheel storage
+    if (index < effects.size()) {
+        effects[index].clear();
+    } else {
+        effects.emplace_back();
+    }
+    return index;
+}
+
+void Encounter::clear() {
+    turn = 0;
+    names.clear();
+    health.clear();
+    maxHealth.clear();
+    minAttack.clear();
+    maxAttack.clear();
+    defence.clear();
+    resistance.clear();
+    level.clear();
+    types.clear();
+    rarities.clear();
+    ai.clear();
+    behaviours.clear();
+    spentRules.clear();
+    fled.clear();
+}
+
+size_t Encounter::getCount() const { return names.size(); }
+
+bool Encounter::isEmpty() const { return names.empty(); }
+
+bool Encounter::isDefeated() const {
+    for (size_t i = 0; i < names.size(); ++i) {
+        if (isAlive(i)) return false;
+    }
+    return true;
+}
+
+std::string_view Encounter::getName(size_t enemy) const { return names[enemy].view(); }
+
+int Encounter::getHealth(size_t enemy) const { return health[enemy]; }
+
+int Encounter::getMaxHealth(size_t enemy) const { return maxHealth[enemy]; }
+
+int Encounter::getLevel(size_t enemy) const { return level[enemy]; }
+
+int Encounter::getDefence(size_t enemy) const {
+    return defence[enemy] + effects[enemy].getModifier(StatusEffectType::DEFENCE);
+}
+
+int Encounter::getResistance(size_t enemy) const {
+    return resistance[enemy] + effects[enemy].getModifier(StatusEffectType::RESISTANCE);
+}
+
+EnemyType Encounter::getType(size_t enemy) const { return types[enemy]; }
+
+EnemyRarity Encounter::getRarity(size_t enemy) const { return rarities[enemy]; }
+
+EnemyAI Encounter::getAI(size_t enemy) const { return ai[enemy]; }
+
+bool Encounter::isAlive(size_t enemy) const { return health[enemy] > 0 && !fled[enemy]; }
+
+bool Encounter::hasFled(size_t enemy) const { return fled[enemy] != 0; }
+
+StatusEffects& Encounter::getStatusEffects(size_t enemy) { return effects[enemy]; }
+
+const StatusEffects& Encounter::getStatusEffects(size_t enemy) const { return effects[enemy]; }
+
+int Encounter::damage(size_t enemy, int amount) {
+    int actualDamage = amount - getDefence(enemy);
+    if (actualDamage < 0) actualDamage = 0;
+    if (actualDamage > health[enemy]) actualDamage = health[enemy];
+    health[enemy] -= actualDamage;
+    return actualDamage;
+}
+
+int Encounter::takeSpellDamage(size_t enemy, int amount) {
+    int actualDamage = amount - getResistance(enemy);
+    if (actualDamage < 0) actualDamage = 0;
+    if (actualDamage > health[enemy]) actualDamage = health[enemy];
+    health[enemy] -= actualDamage;
+    return actualDamage;
+}
+
+void Encounter::healEnemy(size_t enemy, int amount) { health[enemy] += amount; }
+
+void Encounter::loseHealth(size_t enemy, int amount) {
+    health[enemy] = std::max(health[enemy] - std::max(amount, 0), 0);
+}
+
+int Encounter::damageAll(int amount) {
+    int total = 0;
+    for (size_t i = 0; i < names.size(); ++i) {
+        if (isAlive(i)) total += damage(i, amount);
+    }
+    return total;
+}
+
+void Encounter::applyEffectToAll(StatusEffectType type, int magnitude, uint32_t duration) {
+    for (size_t i = 0; i < names.size(); ++i) effects[i].apply(type, magnitude, duration);
+}
+
+EncounterAttack Encounter::attack(Player& player, std::mt19937& rng, bool blocking) {
+    EncounterAttack result{};
+    std::uniform_int_distribution<> percentRoll(0, 99);
+
+    // The player's stats and armour can't change until the turn is over
+    int playerDefence = static_cast<int>(player.getDefence());
+    Item* armor = player.getEquipped(EquipmentSlot::ARMOR);
+    int armorDurability = armor ? getItemDurability(*armor) : 0;
+    for (size_t i = 0; i < names.size(); ++i) {
+        if (!isAlive(i)) continue;
+        if (ai[i] == EnemyAI::SWARM && ((i + turn) & 1) != 0) continue;
+
+        // Tables fill from the front, so an empty first slot means attack-only: no roll needed
+        const EnemyBehaviour& behaviour = behaviours[i];
+        size_t rule = EnemyBehaviour::MAX_RULES;
+        EnemyAction action = EnemyAction::ATTACK;
+        if (behaviour.chance[0] != 0) {
+            action = chooseEnemyAction(behaviour, health[i], maxHealth[i], spentRules[i],
+                                       percentRoll(rng), rule);
+            if (rule < EnemyBehaviour::MAX_RULES) spentRules[i] |= 1u << rule;
+        }
+
+        switch (action) {
+            case EnemyAction::ATTACK: {
+                DamageContext hit = makeDamageContext(rng);
+                hit.minDamage = minAttack[i];
+                hit.maxDamage = maxAttack[i];
+                hit.damageBonus = effects[i].getModifier(StatusEffectType::DAMAGE_BOOST);
+                hit.targetDefence = playerDefence;
+                hit.targetDefending = blocking;
+                hit.armorDurability = armorDurability;
+                getEnemyAttackPipeline().run(hit);
+                player.loseHealth(hit.dealt);
+                armorDurability = hit.armorDurability;
+                result.armorWear += hit.armorWear;
+                ++result.attackers;
+                result.damage += hit.damage;
+                break;
+            }
+            case EnemyAction::CAST_SPELL: {
+                DamageContext spell = makeDamageContext(rng);
+                spell.baseDamage = percentOf(maxAttack[i], behaviour.power[rule]);
+                spell.targetDefending = blocking;
+                getSpellPipeline().run(spell);
+                player.takeSpellDamage(static_cast<unsigned int>(spell.damage));
+                ++result.casters;
+                result.spellDamage += spell.damage;
+                break;
+            }
+            case EnemyAction::HEAL: {
+                int amount = std::min(percentOf(maxHealth[i], behaviour.power[rule]),
+                                      maxHealth[i] - health[i]);
+                healEnemy(i, amount);
+                ++result.healers;
+                result.healed += amount;
+                break;
+            }
+            case EnemyAction::ENRAGE:
+                effects[i].apply(StatusEffectType::DAMAGE_BOOST,
+                                 percentOf(maxAttack[i], behaviour.power[rule]),
+                                 StatusEffects::MAX_DURATION);
+                ++result.enraged;
+                break;
+            case EnemyAction::FLEE:
+                fled[i] = 1;
+                ++result.fled;
+                break;
+        }
+    }
+    ++turn;
+
+    // Broken armour stays on until the end of the turn; the caller takes it off
+    if (result.armorWear > 0) {
+        result.armorBroke = player.wearEquipped(EquipmentSlot::ARMOR, result.armorWear);
+    }
+    return result;
+}
+
+int Encounter::tickEffects() {
+    int poisonDamage = 0;
+    for (size_t i = 0; i < names.size(); ++i) {
+        // Most enemies have nothing active, which tick() handles without touching the wheel
+        StatusTick tick = effects[i].tick();
+        if (tick.poisonDamage <= 0 || !isAlive(i)) continue;
+        int lost = std::min(tick.poisonDamage, health[i]);
+        health[i] -= lost;
+        poisonDamage += lost;
+    }
+    return poisonDamage;
+}
+
+size_t Encounter::removeDefeated(std::vector<DefeatedEnemy>& defeated) {
+    size_t kept = 0;
+    for (size_t i = 0; i < names.size(); ++i) {
+        if (fled[i]) continue;
+        if (health[i] <= 0) {
+            defeated.push_back({names[i], level[i], types[i], rarities[i]});
+            continue;
+        }
+        if (kept != i) {
+            names[kept] = names[i];
+            health[kept] = health[i];
+            maxHealth[kept] = maxHealth[i];
+            minAttack[kept] = minAttack[i];
+            maxAttack[kept] = maxAttack[i];
+            defence[kept] = defence[i];
+            resistance[kept] = resistance[i];
+            level[kept] = level[i];
+            types[kept] = types[i];
+            rarities[kept] = rarities[i];
+            ai[kept] = ai[i];
+            behaviours[kept] = behaviours[i];
+            spentRules[kept] = spentRules[i];
+            fled[kept] = fled[i];
+            std::swap(effects[kept], effects[i]);
+        }
+        ++kept;
+    }
+
+    size_t removed = names.size() - kept;
+    names.resize(kept);
+    health.resize(kept);
+    maxHealth.resize(kept);
+    minAttack.resize(kept);
+    maxAttack.resize(kept);
+    defence.resize(kept);
+    resistance.resize(kept);
+    level.resize(kept);
+    types.resize(kept);
+    rarities.resize(kept);
+    ai.resize(kept);
+    behaviours.resize(kept);
+    spentRules.resize(kept);
+    fled.resize(kept);
+    return removed;
+}
@@ -0,0 +1,137 @@
+//
+// Created by Connor on 19/10/2026.
+//
+
+#ifndef TERMINAL_RPG_ENCOUNTER_HPP
+#define TERMINAL_RPG_ENCOUNTER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "../effects/statuseffects.hpp"
+#include "../player/player.hpp"
+#include "enemy.hpp"
+#include "enemybehaviour.hpp"
+
+struct EnemyTemplate;
+
+// How an enemy decides whether to attack on a turn
+enum class EnemyAI : uint8_t {
+    ATTACK,  // Attacks every turn
+    SWARM    // Pack member: alternates with its neighbours, so half the pack strikes each turn
+};
+
+// What's left of an enemy once it's been removed from the encounter (for rewards and drops)
+struct DefeatedEnemy {
+    InternedString name;
+    int level;
+    EnemyType type;
+    EnemyRarity rarity;
+};
+
+// The enemies' side of one turn
+struct EncounterAttack {
+    int attackers;
+    int damage;  // Total of the hits, before the player's defence
+    int casters;
+    int spellDamage;  // Total of the spells, before the player's resistance
+    int healers;
+    int healed;
+    int enraged;
+    int fled;
+    int armorWear;  // Durability the player's armour lost
+    bool armorBroke;
+};
+
+// Every enemy in a fight, stored as parallel component arrays indexed by position. Turn
+// resolution (enemy actions, poison, clearing out the dead) walks the arrays front to back, so
+// a pack of twenty costs little more per turn than a single enemy. Positions are what the
+// player targets; they stay in spawn order and close up when enemies are removed.
+//
+// The encounter is also the enemy arena. Each GameSession owns one for its whole life, and a
+// spawn clears it and fills slots straight from an EnemyTemplate rather than allocating an Enemy
+// per fight. The slots go when the session does, so nothing has to be released by hand.
+class Encounter {
+public:
+    // Without a behaviour, the enemy gets the table for its type and rarity
+    size_t addEnemy(const Enemy& enemy, EnemyAI ai = EnemyAI::ATTACK);
+    size_t addEnemy(const Enemy& enemy, EnemyAI ai, const EnemyBehaviour& behaviour);
+    size_t addEnemy(const EnemyTemplate& enemyTemplate, EnemyAI ai = EnemyAI::ATTACK);
+
+    // Removes every enemy but keeps the arrays' storage, so refilling for the next fight
+    // allocates nothing unless it's bigger than any before it
+    void clear();
+
+    size_t getCount() const;
+    bool isEmpty() const;
+    bool isDefeated() const;  // No enemy left alive (the dead may not be removed yet)
+
+    std::string_view getName(size_t enemy) const;
+    int getHealth(size_t enemy) const;
+    int getMaxHealth(size_t enemy) const;
+    int getLevel(size_t enemy) const;
+    int getDefence(size_t enemy) const;     // Includes status effects
+    int getResistance(size_t enemy) const;  // Includes status effects
+    EnemyType getType(size_t enemy) const;
+    EnemyRarity getRarity(size_t enemy) const;
+    EnemyAI getAI(size_t enemy) const;
+    bool isAlive(size_t enemy) const;  // False once dead or fled
+    bool hasFled(size_t enemy) const;
+    StatusEffects& getStatusEffects(size_t enemy);
+    const StatusEffects& getStatusEffects(size_t enemy) const;
+
+    // Physical hit on one enemy, reduced by its defence; returns the health it lost
+    int damage(size_t enemy, int amount);
+    // Spell on one enemy, reduced by its resistance; returns the health it lost
+    int takeSpellDamage(size_t enemy, int amount);
+    // Adds amount to one enemy's health, as Enemy::healEnemy does (callers keep it to the max)
+    void healEnemy(size_t enemy, int amount);
+    // Health lost with defence already accounted for (by the damage pipeline, or poison)
+    void loseHealth(size_t enemy, int amount);
+    // Hits every enemy (area of effect); returns the total health lost
+    int damageAll(int amount);
+    void applyEffectToAll(StatusEffectType type, int magnitude, uint32_t duration);
+
+    // Every living enemy whose AI acts this turn takes the action its behaviour table picks.
+    // Blocking halves hits and spells alike. Hits that land wear the player's armour; if it
+    // breaks, it's left on for the caller to break through Player::breakEquipped().
+    EncounterAttack attack(Player& player, std::mt19937& rng, bool blocking);
+
+    // Ends the turn for every enemy's status effects; returns the poison damage dealt
+    int tickEffects();
+
+    // Removes dead and fled enemies, appending the dead to defeated in position order (the fled
+    // leave nothing behind); returns how many were removed
+    size_t removeDefeated(std::vector<DefeatedEnemy>& defeated);
+
+private:
+    uint64_t turn = 0;
+
+    std::vector<InternedString> names;
+    std::vector<int> health;
+    std::vector<int> maxHealth;
+    std::vector<int> minAttack;
+    std::vector<int> maxAttack;
+    std::vector<int> defence;
+    std::vector<int> resistance;
+    std::vector<int> level;
+    std::vector<EnemyType> types;
+    std::vector<EnemyRarity> rarities;
+    std::vector<EnemyAI> ai;
+    std::vector<EnemyBehaviour> behaviours;
+    std::vector<uint8_t> spentRules;  // Once-only rules already used, per enemy
+    std::vector<uint8_t> fled;
+    // Can run past getCount(): slots left behind by clear() and removeDefeated() are kept for
+    // the next enemy added, along with the storage their effects grew
+    std::vector<StatusEffects> effects;
+
+    size_t add(InternedString name, int level, int health, int minAttack, int maxAttack,
+               int defence, int resistance, EnemyType type, EnemyRarity rarity,
+               EnemyAI enemyAI, const EnemyBehaviour& behaviour);
+};
+
+#endif  // TERMINAL_RPG_ENCOUNTER_HPP
@@ -5,6 +5,12 @@
 Enemy::Enemy(const std::string &name, const std::string &description, int level, int health,
              int minAttack, int maxAttack, int defence, int resistance, EnemyType type,
              EnemyRarity rarity)
+    : Enemy(InternedString(name), InternedString(description), level, health, minAttack,
+            maxAttack, defence, resistance, type, rarity) {}
+
+Enemy::Enemy(InternedString name, InternedString description, int level, int health,
+             int minAttack, int maxAttack, int defence, int resistance, EnemyType type,
+             EnemyRarity rarity)
     : name(name),
       description(description),
       level(level),
@@ -19,42 +25,57 @@ Enemy::Enemy(const std::string &name, const std::string &description, int level,
 bool Enemy::isAlive() const { return health > 0; }
 
 void Enemy::takeDamage(int damage) {
-    int actualDamage = damage - defence;
+    int actualDamage = damage - getDefence();
     if (actualDamage < 0) actualDamage = 0;
     health -= actualDamage;
     if (health < 0) health = 0;
 }
 
 void Enemy::takeSpellDamage(int damage) {
-    health -= (damage - resistance);
+    health -= (damage - getResistance());
     if (health < 0) health = 0;
 }
 
 void Enemy::healEnemy(int amount) { health += amount; }
 
+void Enemy::loseHealth(int amount) {
+    health -= amount;
+    if (health < 0) health = 0;
+}
+
 int Enemy::attack() const {
-    static std::random_device rd;
-    static std::mt19937 gen(rd());
+    // Thread-local so sessions on different server shards never share an engine
+    static thread_local std::mt19937 gen(std::random_device{}());
     std::uniform_int_distribution<> dist(minAttack, maxAttack);
     return dist(gen);
 }
 
 int Enemy::getHealth() const { return health; }
 
-std::string Enemy::getName() const { return name; }
+std::string_view Enemy::getName() const { return name.view(); }
 
-std::string Enemy::getDescription() const { return description; }
+InternedString Enemy::getInternedName() const { return name; }
+
+std::string_view Enemy::getDescription() const { return description.view(); }
 
 int Enemy::getMinAttack() const { return minAttack; }
 
 int Enemy::getMaxAttack() const { return maxAttack; }
 
-int Enemy::getDefence() const { return defence; }
+int Enemy::getDefence() const {
+    return defence + statusEffects.getModifier(StatusEffectType::DEFENCE);
+}
 
-int Enemy::getResistance() const { return resistance; }
+int Enemy::getResistance() const {
+    return resistance + statusEffects.getModifier(StatusEffectType::RESISTANCE);
+}
 
 int Enemy::getLevel() const { return level; }
 
 EnemyType Enemy::getType() const { return type; }
 
 EnemyRarity Enemy::getRarity() const { return rarity; }
+
+StatusEffects& Enemy::getStatusEffects() { return statusEffects; }
+
+const StatusEffects& Enemy::getStatusEffects() const { return statusEffects; }
@@ -4,9 +4,14 @@
 
 #ifndef TERMINAL_RPG_ENEMY_H
 #define TERMINAL_RPG_ENEMY_H
+#include <cstddef>
 #include <string>
+#include <string_view>
 #include <random>
 
+#include "../effects/statuseffects.hpp"
+#include "../text/stringtable.hpp"
+
 enum class EnemyType {
     BEAST,
     UNDEAD,
@@ -26,19 +31,28 @@ enum class EnemyRarity {
     BOSS
 };
 
+constexpr size_t ENEMY_TYPE_COUNT = static_cast<size_t>(EnemyType::GOBLINOID) + 1;
+constexpr size_t ENEMY_RARITY_COUNT = static_cast<size_t>(EnemyRarity::BOSS) + 1;
+
 class Enemy {
 public:
     Enemy(const std::string &name, const std::string &description, int level, int health, int minAttack, int maxAttack, int defence, int resistance, EnemyType type, EnemyRarity rarity);
+    // From already-interned text (templates), without touching the string table
+    Enemy(InternedString name, InternedString description, int level, int health, int minAttack,
+          int maxAttack, int defence, int resistance, EnemyType type, EnemyRarity rarity);
 
     bool isAlive() const;
     void takeDamage(int damage);
     void takeSpellDamage(int damage);
     void healEnemy(int amount);
+    // Damage that ignores defence and resistance (e.g. poison)
+    void loseHealth(int amount);
     int attack() const;
 
     int getHealth() const;
-    std::string getName() const;
-    std::string getDescription() const;
+    std::string_view getName() const;
+    InternedString getInternedName() const;
+    std::string_view getDescription() const;
     int getMinAttack() const;
     int getMaxAttack() const;
     int getDefence() const;
@@ -47,9 +61,13 @@ public:
     EnemyType getType() const;
     EnemyRarity getRarity() const;
 
+    // Timed buffs and debuffs; defence and resistance above already include them
+    StatusEffects& getStatusEffects();
+    const StatusEffects& getStatusEffects() const;
+
 private:
-    std::string name;
-    std::string description;
+    InternedString name;
+    InternedString description;
     int level;
     int health;
     int minAttack;
@@ -58,5 +76,6 @@ private:
     int resistance;
     EnemyType type;
     EnemyRarity rarity;
+    StatusEffects statusEffects;
 };
 #endif //TERMINAL_RPG_ENEMY_H
\ No newline at end of file
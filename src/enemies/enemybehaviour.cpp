@@ -0,0 +1,102 @@
+//
+// Created by Connor on 19/10/2026.
+//
+
+#include "enemybehaviour.hpp"
+
+#include <algorithm>
+
+namespace {
+constexpr uint8_t ANY_HEALTH = 101;
+
+struct Rule {
+    uint8_t belowPercent;
+    uint8_t chance;
+    EnemyAction action;
+    uint8_t power;
+    bool once;
+};
+
+// Up to three rules per type, highest priority first, leaving a slot for the boss rule
+constexpr size_t TYPE_RULES = 3;
+constexpr Rule TYPE_TABLE[ENEMY_TYPE_COUNT][TYPE_RULES] = {
+    // BEAST: bolts when badly hurt
+    {{25, 35, EnemyAction::FLEE, 0, true}},
+    // UNDEAD: knits itself back together
+    {{40, 25, EnemyAction::HEAL, 20, false}},
+    // HUMANOID: drinks a potion, and runs if that doesn't save it
+    {{35, 40, EnemyAction::HEAL, 25, true}, {15, 25, EnemyAction::FLEE, 0, true}},
+    // DRAGON: breathes fire, and gets angry once wounded
+    {{50, 100, EnemyAction::ENRAGE, 30, true},
+     {ANY_HEALTH, 30, EnemyAction::CAST_SPELL, 150, false}},
+    // ELEMENTAL: mostly magic
+    {{ANY_HEALTH, 40, EnemyAction::CAST_SPELL, 120, false}},
+    // DEMON: curses, and feeds when hurt
+    {{30, 30, EnemyAction::HEAL, 20, false},
+     {ANY_HEALTH, 25, EnemyAction::CAST_SPELL, 130, false}},
+    // GOBLINOID: cowards
+    {{30, 40, EnemyAction::FLEE, 0, true}},
+};
+
+// Added to every rule's chance
+constexpr uint8_t RARITY_CHANCE_BONUS[ENEMY_RARITY_COUNT] = {0, 5, 10, 15, 20, 25};
+constexpr bool RARITY_NEVER_FLEES[ENEMY_RARITY_COUNT] = {false, false, false, false, true, true};
+
+constexpr Rule BOSS_ENRAGE = {30, 100, EnemyAction::ENRAGE, 50, true};
+
+// Index of the lowest set bit of a 4-bit rule mask, MAX_RULES when it's empty
+constexpr uint8_t FIRST_RULE[1 << EnemyBehaviour::MAX_RULES] = {4, 0, 1, 0, 2, 0, 1, 0,
+                                                                3, 0, 1, 0, 2, 0, 1, 0};
+
+void setRule(EnemyBehaviour& behaviour, size_t slot, const Rule& rule, uint8_t chanceBonus) {
+    behaviour.belowPercent[slot] = rule.belowPercent;
+    behaviour.chance[slot] =
+        static_cast<uint8_t>(std::min(100, rule.chance + static_cast<int>(chanceBonus)));
+    behaviour.action[slot] = rule.action;
+    behaviour.power[slot] = rule.power;
+    if (rule.once) behaviour.onceMask |= static_cast<uint8_t>(1u << slot);
+}
+}  // namespace
+
+EnemyBehaviour makeAttackOnlyBehaviour() {
+    EnemyBehaviour behaviour{};
+    for (size_t i = 0; i < EnemyBehaviour::MAX_RULES; ++i) {
+        behaviour.action[i] = EnemyAction::ATTACK;
+    }
+    return behaviour;
+}
+
+EnemyBehaviour makeEnemyBehaviour(EnemyType type, EnemyRarity rarity) {
+    EnemyBehaviour behaviour = makeAttackOnlyBehaviour();
+    size_t rarityIndex = static_cast<size_t>(rarity);
+    uint8_t chanceBonus = RARITY_CHANCE_BONUS[rarityIndex];
+
+    size_t slot = 0;
+    if (rarity == EnemyRarity::BOSS) setRule(behaviour, slot++, BOSS_ENRAGE, 0);
+    for (const Rule& rule : TYPE_TABLE[static_cast<size_t>(type)]) {
+        if (rule.chance == 0) continue;  // Unused slot
+        if (rule.action == EnemyAction::FLEE && RARITY_NEVER_FLEES[rarityIndex]) continue;
+        // Bosses already enrage from their own rule
+        if (rule.action == EnemyAction::ENRAGE && rarity == EnemyRarity::BOSS) continue;
+        if (slot == EnemyBehaviour::MAX_RULES) break;
+        setRule(behaviour, slot++, rule, chanceBonus);
+    }
+    return behaviour;
+}
+
+EnemyAction chooseEnemyAction(const EnemyBehaviour& behaviour, int health, int maxHealth,
+                              uint8_t spentMask, int roll, size_t& rule) {
+    int healthPercent = maxHealth > 0 ? health * 100 / maxHealth : 0;
+
+    // Every rule is checked; the mask of the ones that apply picks the first
+    unsigned int applies = 0;
+    for (size_t i = 0; i < EnemyBehaviour::MAX_RULES; ++i) {
+        unsigned int hit = static_cast<unsigned int>(healthPercent < behaviour.belowPercent[i]) &
+                           static_cast<unsigned int>(roll < behaviour.chance[i]);
+        applies |= hit << i;
+    }
+    applies &= ~static_cast<unsigned int>(spentMask & behaviour.onceMask);
+
+    rule = FIRST_RULE[applies & ((1u << EnemyBehaviour::MAX_RULES) - 1)];
+    return rule == EnemyBehaviour::MAX_RULES ? EnemyAction::ATTACK : behaviour.action[rule];
+}
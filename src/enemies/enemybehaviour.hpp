@@ -0,0 +1,49 @@
+//
+// Created by Connor on 19/10/2026.
+//
+
+#ifndef TERMINAL_RPG_ENEMYBEHAVIOUR_HPP
+#define TERMINAL_RPG_ENEMYBEHAVIOUR_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+#include "enemy.hpp"
+
+// What an enemy does with its turn
+enum class EnemyAction : uint8_t {
+    ATTACK,      // Physical hit, reduced by the player's defence
+    HEAL,        // power: percent of max health restored
+    CAST_SPELL,  // power: percent of max attack dealt as spell damage (reduced by resistance)
+    ENRAGE,      // power: percent of max attack added to every later hit
+    FLEE         // Leaves the fight without dropping anything
+};
+
+// An enemy's decision table, built once per template from its type and rarity. Rules are
+// checked in priority order and the first one that applies is taken; if none does the enemy
+// attacks. A rule applies when the enemy's health is below belowPercent of its maximum, the
+// turn's roll (0-99) is below chance, and (for once-only rules) it hasn't fired yet. Packed
+// as parallel byte arrays so a turn is a handful of compares and one table lookup.
+struct EnemyBehaviour {
+    static constexpr size_t MAX_RULES = 4;
+
+    uint8_t belowPercent[MAX_RULES];  // 101 = at any health
+    uint8_t chance[MAX_RULES];        // Out of 100; 0 = unused slot
+    EnemyAction action[MAX_RULES];
+    uint8_t power[MAX_RULES];
+    uint8_t onceMask;  // Bit i set: rule i only ever fires once per fight
+};
+
+// Every rule slot unused, so the enemy always attacks
+EnemyBehaviour makeAttackOnlyBehaviour();
+
+// The table for an enemy type, adjusted for rarity (rarer enemies use their tricks more often;
+// bosses enrage when hurt and never flee)
+EnemyBehaviour makeEnemyBehaviour(EnemyType type, EnemyRarity rarity);
+
+// Picks this turn's action. spentMask has bit i set for once-only rules that already fired;
+// rule is set to the index of the rule taken (MAX_RULES for a plain attack).
+EnemyAction chooseEnemyAction(const EnemyBehaviour& behaviour, int health, int maxHealth,
+                              uint8_t spentMask, int roll, size_t& rule);
+
+#endif  // TERMINAL_RPG_ENEMYBEHAVIOUR_HPP
@@ -7,12 +7,29 @@
 #include <algorithm>
 #include <random>
 
+namespace {
+
+// Every enemy the create* helpers below define. Adding an enemy here as well as there keeps its
+// lookup on the perfect hash; one that's missed still works, through the fallback table.
+constexpr std::array<std::string_view, EnemyDatabase::BUILTIN_ENEMY_COUNT> BUILTIN_ENEMY_NAMES = {
+    "Forest Wolf", "Giant Bear", "Dire Wolf", "Giant Spider", "Cave Bat", "Skeleton Warrior",
+    "Zombie", "Wraith", "Lich", "Bandit", "Orc Warrior", "Dark Elf Assassin", "Cultist", "Goblin",
+    "Hobgoblin", "Goblin Shaman", "Fire Elemental", "Ice Elemental", "Earth Elemental", "Imp",
+    "Lesser Demon", "Demon Lord", "Young Dragon", "Ancient Dragon", "Dragonling",
+    "The Shadow King", "Inferno Beast", "Goblin King", "Void Reaper"};
+
+constexpr PerfectNameHash<EnemyDatabase::BUILTIN_ENEMY_COUNT> BUILTIN_ENEMY_HASH(
+    BUILTIN_ENEMY_NAMES);
+static_assert(BUILTIN_ENEMY_HASH.isPerfect(), "built-in enemy names must be unique and non-empty");
+
+}  // namespace
+
 // EnemyTemplate constructor
 EnemyTemplate::EnemyTemplate(const std::string& name, const std::string& description, int level,
                              int health, int minAttack, int maxAttack, int defence, int resistance,
                              EnemyType type, EnemyRarity rarity)
-    : name(name),
-      description(description),
+    : name(InternedString(name)),
+      description(InternedString(description)),
       level(level),
       health(health),
       minAttack(minAttack),
@@ -20,7 +37,8 @@ EnemyTemplate::EnemyTemplate(const std::string& name, const std::string& descrip
       defence(defence),
       resistance(resistance),
       type(type),
-      rarity(rarity) {}
+      rarity(rarity),
+      behaviour(makeEnemyBehaviour(type, rarity)) {}
 
 // EnemyDatabase implementation
 EnemyDatabase& EnemyDatabase::getInstance() {
@@ -39,27 +57,31 @@ void EnemyDatabase::initialize() {
     createBosses();
 }
 
-const EnemyTemplate* EnemyDatabase::getEnemyTemplate(const std::string& enemyName) const {
-    auto it = enemyTemplates.find(enemyName);
-    return (it != enemyTemplates.end()) ? it->second.get() : nullptr;
+const EnemyTemplate* EnemyDatabase::getEnemyTemplate(std::string_view enemyName) const {
+    int builtin = BUILTIN_ENEMY_HASH.find(enemyName);
+    if (builtin >= 0 && builtinTemplates[builtin]) {
+        return builtinTemplates[builtin];
+    }
+    return otherTemplates.find(enemyName);
 }
 
-Enemy* EnemyDatabase::createEnemy(const std::string& enemyName) const {
+std::unique_ptr<Enemy> EnemyDatabase::createEnemy(const std::string& enemyName) const {
     const EnemyTemplate* template_ptr = getEnemyTemplate(enemyName);
     if (!template_ptr) {
         return nullptr;
     }
 
-    return new Enemy(template_ptr->name, template_ptr->description, template_ptr->level,
-                     template_ptr->health, template_ptr->minAttack, template_ptr->maxAttack,
-                     template_ptr->defence, template_ptr->resistance, template_ptr->type,
-                     template_ptr->rarity);
+    return std::make_unique<Enemy>(template_ptr->name, template_ptr->description,
+                                   template_ptr->level, template_ptr->health,
+                                   template_ptr->minAttack, template_ptr->maxAttack,
+                                   template_ptr->defence, template_ptr->resistance,
+                                   template_ptr->type, template_ptr->rarity);
 }
 
 std::vector<std::string> EnemyDatabase::getAllEnemyNames() const {
     std::vector<std::string> names;
     for (const auto& pair : enemyTemplates) {
-        names.push_back(pair.first);
+        names.emplace_back(pair.first);
     }
     return names;
 }
@@ -68,7 +90,7 @@ std::vector<std::string> EnemyDatabase::getEnemiesByType(EnemyType type) const {
     std::vector<std::string> names;
     for (const auto& pair : enemyTemplates) {
         if (pair.second->type == type) {
-            names.push_back(pair.first);
+            names.emplace_back(pair.first);
         }
     }
     return names;
@@ -78,7 +100,7 @@ std::vector<std::string> EnemyDatabase::getEnemiesByRarity(EnemyRarity rarity) c
     std::vector<std::string> names;
     for (const auto& pair : enemyTemplates) {
         if (pair.second->rarity == rarity) {
-            names.push_back(pair.first);
+            names.emplace_back(pair.first);
         }
     }
     return names;
@@ -88,28 +110,58 @@ std::vector<std::string> EnemyDatabase::getEnemiesByLevelRange(int minLevel, int
     std::vector<std::string> names;
     for (const auto& pair : enemyTemplates) {
         if (pair.second->level >= minLevel && pair.second->level <= maxLevel) {
-            names.push_back(pair.first);
+            names.emplace_back(pair.first);
         }
     }
     return names;
 }
 
 std::string EnemyDatabase::getRandomEnemyByLevel(int minLevel, int maxLevel) const {
-    std::vector<std::string> eligibleEnemies = getEnemiesByLevelRange(minLevel, maxLevel);
+    // Thread-local so sessions on different server shards never share an engine
+    static thread_local std::mt19937 gen(std::random_device{}());
+
+    const EnemyTemplate* enemyTemplate = getRandomTemplateByLevel(minLevel, maxLevel, gen);
+    return enemyTemplate ? std::string(enemyTemplate->name.view()) : "";
+}
 
-    if (eligibleEnemies.empty()) {
-        return "";
+const EnemyTemplate* EnemyDatabase::getRandomTemplateByLevel(int minLevel, int maxLevel,
+                                                             std::mt19937& rng) const {
+    // Counted first and then walked to the pick, so choosing builds no list of names
+    size_t eligible = 0;
+    for (const auto& pair : enemyTemplates) {
+        if (pair.second->level >= minLevel && pair.second->level <= maxLevel) ++eligible;
+    }
+    if (eligible == 0) {
+        return nullptr;
     }
 
-    static std::random_device rd;
-    static std::mt19937 gen(rd());
-    std::uniform_int_distribution<> dist(0, eligibleEnemies.size() - 1);
+    std::uniform_int_distribution<size_t> dist(0, eligible - 1);
+    size_t pick = dist(rng);
+    for (const auto& pair : enemyTemplates) {
+        if (pair.second->level < minLevel || pair.second->level > maxLevel) continue;
+        if (pick == 0) return pair.second.get();
+        --pick;
+    }
+    return nullptr;
+}
 
-    return eligibleEnemies[dist(gen)];
+int EnemyDatabase::getMaxLevel() const {
+    int maxLevel = 0;
+    for (const auto& pair : enemyTemplates) {
+        maxLevel = std::max(maxLevel, pair.second->level);
+    }
+    return maxLevel;
 }
 
 void EnemyDatabase::addEnemyTemplate(std::unique_ptr<EnemyTemplate> enemyTemplate) {
-    enemyTemplates[enemyTemplate->name] = std::move(enemyTemplate);
+    int builtin = BUILTIN_ENEMY_HASH.find(enemyTemplate->name.view());
+    if (builtin >= 0) {
+        builtinTemplates[builtin] = enemyTemplate.get();
+    } else {
+        otherTemplates.insert(enemyTemplate->name.view(), enemyTemplate.get());
+    }
+    std::string_view name = enemyTemplate->name.view();
+    enemyTemplates[name] = std::move(enemyTemplate);
 }
 
 void EnemyDatabase::createBeasts() {
@@ -5,15 +5,20 @@
 #ifndef TERMINAL_RPG_ENEMYDATABASE_HPP
 #define TERMINAL_RPG_ENEMYDATABASE_HPP
 
+#include <array>
 #include <vector>
 #include <memory>
 #include <map>
+#include <random>
 #include <string>
+#include <string_view>
 #include "enemy.hpp"
+#include "enemybehaviour.hpp"
+#include "../text/namelookup.hpp"
 
 struct EnemyTemplate {
-    std::string name;
-    std::string description;
+    InternedString name;
+    InternedString description;
     int level;
     int health;
     int minAttack;
@@ -22,6 +27,7 @@ struct EnemyTemplate {
     int resistance;
     EnemyType type;
     EnemyRarity rarity;
+    EnemyBehaviour behaviour;  // Decision table, from the type and rarity
 
     EnemyTemplate(const std::string& name, const std::string& description,
                  int level, int health, int minAttack, int maxAttack,
@@ -30,16 +36,20 @@ struct EnemyTemplate {
 
 class EnemyDatabase {
 public:
+    // Number of enemies on the compile-time name list
+    static constexpr size_t BUILTIN_ENEMY_COUNT = 29;
+
     static EnemyDatabase& getInstance();
 
     // Initialize the database with all predefined enemies
     void initialize();
 
-    // Get enemy template by name (returns nullptr if not found)
-    const EnemyTemplate* getEnemyTemplate(const std::string& enemyName) const;
+    // Get enemy template by name (returns nullptr if not found). Built-in names go through a
+    // perfect hash made at compile time; anything else through a hash table.
+    const EnemyTemplate* getEnemyTemplate(std::string_view enemyName) const;
 
-    // Create a new Enemy instance from template
-    Enemy* createEnemy(const std::string& enemyName) const;
+    // Create a new Enemy instance from template (nullptr if the name isn't known)
+    std::unique_ptr<Enemy> createEnemy(const std::string& enemyName) const;
 
     // Get all enemy names
     std::vector<std::string> getAllEnemyNames() const;
@@ -56,13 +66,27 @@ public:
     // Get random enemy by level range
     std::string getRandomEnemyByLevel(int minLevel, int maxLevel) const;
 
+    // Same pick as a template, without copying a name (nullptr if none is in range). Draws from
+    // rng, so a seeded session spawns the same enemies every run.
+    const EnemyTemplate* getRandomTemplateByLevel(int minLevel, int maxLevel,
+                                                  std::mt19937& rng) const;
+
+    // Highest level of any enemy (0 before initialize)
+    int getMaxLevel() const;
+
 private:
     EnemyDatabase() = default;
     ~EnemyDatabase() = default;
     EnemyDatabase(const EnemyDatabase&) = delete;
     EnemyDatabase& operator=(const EnemyDatabase&) = delete;
 
-    std::map<std::string, std::unique_ptr<EnemyTemplate>> enemyTemplates;
+    // Keyed by views of the templates' interned names, so no name is held twice; ordered by name
+    std::map<std::string_view, std::unique_ptr<EnemyTemplate>> enemyTemplates;
+
+    // Name lookup. Built-in enemies sit at their position in the compile-time name list
+    // (enemydatabase.cpp); enemies not on that list go in otherTemplates.
+    std::array<EnemyTemplate*, BUILTIN_ENEMY_COUNT> builtinTemplates{};
+    NameTable<EnemyTemplate> otherTemplates;
 
     // Helper methods to create specific enemy types
     void createBeasts();
@@ -0,0 +1,1608 @@
+//
+// Created by Connor on 19/10/2026.
+//
+
+#include "gamesession.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <sstream>
+
+#include "../chest/chest.hpp"
+#include "../combat/damagepipeline.hpp"
+#include "../combat/effectiveness.hpp"
+#include "../enemies/enemydatabase.hpp"
+#include "../items/itemdatabase.hpp"
+#include "../levels/leveldatabase.hpp"
+#include "../loot/loottable.hpp"
+#include "../merchants/pricingengine.hpp"
+
+bool parseIntInput(const std::string& line, int& value) {
+    std::istringstream stream(line);
+    stream >> value;
+    return !stream.fail();
+}
+
+char firstCharInput(const std::string& line) {
+    for (char c : line) {
+        if (!std::isspace(static_cast<unsigned char>(c))) return c;
+    }
+    return '\0';
+}
+
+namespace {
+// Potion buffs and poison are timed in combat turns
+constexpr uint32_t POTION_BUFF_TURNS = 5;
+constexpr uint32_t POISON_TURNS = 3;
+// Alarm traps call in a pack of up to this many
+constexpr int MAX_AMBUSH_SIZE = 20;
+
+bool isBlank(const std::string& line) { return firstCharInput(line) == '\0'; }
+}  // namespace
+
+GameSession::GameSession(unsigned int seed)
+    : rng(seed),
+      state(SessionState::AWAITING_NAME),
+      hasCompletedCommand(false),
+      completedCommand(PlayerCommand::COMBAT_ATTACK),
+      combatTarget(0),
+      pendingAttack(0),
+      combatReturn(CombatReturn::CONTINUE_PROMPT),
+      pendingChestItem(nullptr),
+      merchant(nullptr),
+      eventCount(0),
+      realTimeEnabled(false) {}
+
+GameSession::~GameSession() {
+    delete pendingChestItem;
+    if (player) {
+        for (Item* item : player->getInventory()) {
+            delete item;
+        }
+    }
+}
+
+void GameSession::start() {
+    out << "-------- Terminal RPG --------" << '\n';
+    out << "Version: 1.0.0" << '\n';
+    out << "Creating player..." << '\n';
+    out << "Enter your character's name: ";
+    state = SessionState::AWAITING_NAME;
+}
+
+void GameSession::handleInput(const std::string& line) {
+    switch (state) {
+        case SessionState::AWAITING_NAME:
+            handleName(line);
+            break;
+        case SessionState::AWAITING_CONTINUE:
+            handleContinue(line);
+            break;
+        case SessionState::COMBAT_ACTION:
+            handleCombatAction(line);
+            break;
+        case SessionState::COMBAT_TARGET_CHOICE:
+            handleCombatTarget(line);
+            break;
+        case SessionState::COMBAT_ITEM_CHOICE:
+            handleCombatItemChoice(line);
+            break;
+        case SessionState::COMBAT_EQUIP_CHOICE:
+            handleCombatEquipChoice(line);
+            break;
+        case SessionState::COMBAT_PAUSE:
+            handleCombatPause(line);
+            break;
+        case SessionState::COMBAT_REALTIME:
+            handleRealTimeAction(line);
+            break;
+        case SessionState::CHEST_PROMPT:
+            handleChestChoice(line);
+            break;
+        case SessionState::MERCHANT_MENU:
+            handleMerchantMenu(line);
+            break;
+        case SessionState::MERCHANT_BUY:
+            handleMerchantBuy(line);
+            break;
+        case SessionState::MERCHANT_SELL:
+            handleMerchantSell(line);
+            break;
+        case SessionState::FINISHED:
+            break;
+    }
+}
+
+void GameSession::update(std::chrono::nanoseconds elapsed) {
+    if (state != SessionState::COMBAT_REALTIME) return;
+    realTimeCombat->advance(elapsed);
+    renderRealTimeCombat();
+}
+
+bool GameSession::needsUpdates() const { return state == SessionState::COMBAT_REALTIME; }
+
+void GameSession::setRealTimeCombat(bool enabled) { realTimeEnabled = enabled; }
+
+SessionState GameSession::getState() const { return state; }
+
+bool GameSession::isFinished() const { return state == SessionState::FINISHED; }
+
+std::string GameSession::takeOutput() {
+    std::string frame;
+    takeOutput(frame);
+    return frame;
+}
+
+void GameSession::takeOutput(std::string& frame) {
+    frame.assign(out.view());
+    out.clear();
+}
+
+bool GameSession::takeCompletedCommand(PlayerCommand& command) {
+    if (!hasCompletedCommand) return false;
+    command = completedCommand;
+    hasCompletedCommand = false;
+    return true;
+}
+
+void GameSession::setDebugReportHandler(std::function<void(std::ostream&)> handler) {
+    debugReportHandler = std::move(handler);
+}
+
+const Player* GameSession::getPlayer() const { return player.get(); }
+
+void GameSession::markCommand(PlayerCommand command) {
+    completedCommand = command;
+    hasCompletedCommand = true;
+}
+
+int GameSession::randomInt(int min, int max) {
+    std::uniform_int_distribution<> distr(min, max);
+    return distr(rng);
+}
+
+void GameSession::handleName(const std::string& line) {
+    player = std::make_unique<Player>(line, 100, 100, 50, 50, 0, 0, 1, 0, 100, 100, 0);
+    out << "Welcome, " << line << "!" << '\n' << '\n';
+    printCharacterInformation();
+
+    triggerRandomEvent();
+}
+
+void GameSession::promptContinue() {
+    out << "\nContinue adventuring? (y/n): ";
+    state = SessionState::AWAITING_CONTINUE;
+}
+
+void GameSession::handleContinue(const std::string& line) {
+    char continueChoice = firstCharInput(line);
+    if (continueChoice == '\0') return;
+
+    // Hidden debug command: print command latency percentiles
+    if (continueChoice == 'l' || continueChoice == 'L') {
+        if (debugReportHandler) debugReportHandler(out.stream());
+        promptContinue();
+        return;
+    }
+
+    if (continueChoice == 'n' || continueChoice == 'N') {
+        out << "Thanks for playing!" << '\n';
+        state = SessionState::FINISHED;
+        return;
+    }
+
+    triggerRandomEvent();
+}
+
+void GameSession::triggerRandomEvent() {
+    ++eventCount;
+    int enemyPercentage = 60;
+    int chestPercentage = 30;
+    int merchantPercentage = 10;
+    int roll = randomInt(1, 100);
+
+    if (roll <= enemyPercentage) {
+        if (spawnEncounter(1, EnemyAI::ATTACK)) {
+            startCombat(CombatReturn::CONTINUE_PROMPT);
+            return;
+        }
+    } else if (roll <= enemyPercentage + chestPercentage) {
+        spawnChest();
+        return;
+    } else if (roll <= enemyPercentage + chestPercentage + merchantPercentage) {
+        spawnMerchant();
+        return;
+    }
+    promptContinue();
+}
+
+const EnemyTemplate* GameSession::spawnEnemy() {
+    out << "An enemy appears!" << '\n';
+
+    // Calculate level range for enemy spawning (player level ± 2, minimum level 1)
+    int playerLevel = static_cast<int>(player->getLevel());
+    int minEnemyLevel = std::max(1, playerLevel - 2);
+    int maxEnemyLevel = playerLevel + 2;
+
+    // Get a random enemy within the level range
+    const EnemyDatabase& enemyDatabase = EnemyDatabase::getInstance();
+    const EnemyTemplate* enemyTemplate =
+        enemyDatabase.getRandomTemplateByLevel(minEnemyLevel, maxEnemyLevel, rng);
+
+    if (!enemyTemplate) {
+        out << "A goblin appears!" << '\n';
+        enemyTemplate = enemyDatabase.getEnemyTemplate("Goblin");  // Fallback enemy
+        if (!enemyTemplate) {
+            out << "Failed to spawn enemy!" << '\n';
+            return nullptr;
+        }
+    }
+
+    out << "A " << enemyTemplate->name.view() << " (Level " << enemyTemplate->level
+        << ") blocks your path!" << '\n';
+    out << enemyTemplate->description.view() << '\n';
+    out << "Enemy Stats:" << '\n';
+    out << "  Health: " << enemyTemplate->health << '\n';
+    out << "  Attack: " << enemyTemplate->minAttack << "-" << enemyTemplate->maxAttack << '\n';
+    out << "  Defence: " << enemyTemplate->defence << '\n';
+    out << "  Resistance: " << enemyTemplate->resistance << '\n';
+    out << "  Type: ";
+
+    // Display enemy type
+    switch (enemyTemplate->type) {
+        case EnemyType::BEAST:
+            out << "Beast";
+            break;
+        case EnemyType::UNDEAD:
+            out << "Undead";
+            break;
+        case EnemyType::HUMANOID:
+            out << "Humanoid";
+            break;
+        case EnemyType::DRAGON:
+            out << "Dragon";
+            break;
+        case EnemyType::ELEMENTAL:
+            out << "Elemental";
+            break;
+        case EnemyType::DEMON:
+            out << "Demon";
+            break;
+        case EnemyType::GOBLINOID:
+            out << "Goblinoid";
+            break;
+    }
+
+    out << " | Rarity: ";
+
+    // Display enemy rarity
+    switch (enemyTemplate->rarity) {
+        case EnemyRarity::COMMON:
+            out << "Common";
+            break;
+        case EnemyRarity::UNCOMMON:
+            out << "Uncommon";
+            break;
+        case EnemyRarity::RARE:
+            out << "Rare";
+            break;
+        case EnemyRarity::EPIC:
+            out << "Epic";
+            break;
+        case EnemyRarity::LEGENDARY:
+            out << "Legendary";
+            break;
+        case EnemyRarity::BOSS:
+            out << "Boss";
+            break;
+    }
+    out << '\n' << '\n';
+
+    return enemyTemplate;
+}
+
+bool GameSession::spawnEncounter(int count, EnemyAI ai) {
+    const EnemyTemplate* enemyTemplate = spawnEnemy();
+    if (!enemyTemplate) return false;
+
+    // Behaviour comes from the template's decision table
+    encounter.clear();
+    for (int i = 0; i < count; ++i) encounter.addEnemy(*enemyTemplate, ai);
+    if (count > 1) {
+        out << "It isn't alone! " << count << " of them surround you!" << '\n' << '\n';
+    }
+    return true;
+}
+
+void GameSession::startCombat(CombatReturn returnTo) {
+    combatTarget = 0;
+    combatReturn = returnTo;
+
+    out << '\n' << "Combat begins!" << '\n';
+    out << "--------------------------------" << '\n';
+
+    if (realTimeEnabled) {
+        startRealTimeCombat();
+        return;
+    }
+    promptCombatAction();
+}
+
+void GameSession::startRealTimeCombat() {
+    realTimeCombat = std::make_unique<RealTimeCombat>(*player, encounter, rng);
+    if (encounter.getCount() == 1) {
+        out << "Real-time combat! The " << encounter.getName(0) << " attacks every "
+            << RealTimeCombat::ENEMY_ATTACK_INTERVAL.count() << " ms." << '\n';
+    } else {
+        out << "Real-time combat! The enemies attack every "
+            << RealTimeCombat::ENEMY_ATTACK_INTERVAL.count()
+            << " ms. Your attacks hit the first one still standing." << '\n';
+    }
+    Item* weapon = player->getEquippedWeapon();
+    if (weapon) {
+        out << "Your " << weapon->getName() << " can strike every "
+            << weapon->getWeaponData().getCooldown() << " ms." << '\n';
+    }
+    out << "Actions: a = attack, p = power attack, d = defend, f = flee" << '\n';
+    printRealTimeStatus();
+    state = SessionState::COMBAT_REALTIME;
+}
+
+void GameSession::handleRealTimeAction(const std::string& line) {
+    if (isBlank(line)) return;
+
+    RealTimeAction action = RealTimeAction::NONE;
+    PlayerCommand command = PlayerCommand::COMBAT_ATTACK;
+    switch (std::tolower(static_cast<unsigned char>(firstCharInput(line)))) {
+        case 'a':
+        case '1':
+            action = RealTimeAction::ATTACK;
+            break;
+        case 'd':
+        case '2':
+            action = RealTimeAction::DEFEND;
+            command = PlayerCommand::COMBAT_DEFEND;
+            break;
+        case 'p':
+        case '3':
+            action = RealTimeAction::POWER_ATTACK;
+            command = PlayerCommand::COMBAT_POWER_ATTACK;
+            break;
+        case 'f':
+        case '6':
+            action = RealTimeAction::FLEE;
+            command = PlayerCommand::COMBAT_FLEE;
+            break;
+        default:
+            out << "Unknown action! Use a, p, d or f." << '\n';
+            return;
+    }
+    markCommand(command);
+    // Runs on the first tick the weapon is ready; the next update() shows the result
+    realTimeCombat->queueAction(action);
+}
+
+void GameSession::renderRealTimeCombat() {
+    realTimeCombat->takeEvents(realTimeEvents);
+    for (const RealTimeEvent& event : realTimeEvents) {
+        out << "[" << event.timeMs / 1000 << "." << (event.timeMs % 1000) / 100 << "s] ";
+        switch (event.type) {
+            case RealTimeEventType::PLAYER_HIT:
+                out << "You hit the " << encounter.getName(event.enemy) << " for " << event.amount
+                    << " damage!";
+                break;
+            case RealTimeEventType::PLAYER_CRIT:
+                out << "Critical hit! You deal " << event.amount << " damage!";
+                break;
+            case RealTimeEventType::PLAYER_MISSED:
+                out << "You miss!";
+                break;
+            case RealTimeEventType::PLAYER_TOO_TIRED:
+                out << "You're too tired! (Need " << event.amount << " stamina)";
+                break;
+            case RealTimeEventType::PLAYER_DEFENDING:
+                out << "You raise your guard and catch your breath!";
+                break;
+            case RealTimeEventType::FLEE_FAILED:
+                if (encounter.getCount() == 1) {
+                    out << "You failed to escape! The " << encounter.getName(0)
+                        << " blocks your path!";
+                } else {
+                    out << "You failed to escape! The enemies block your path!";
+                }
+                break;
+            case RealTimeEventType::WEAPON_BROKE:
+                out << "Your weapon breaks!";
+                break;
+            case RealTimeEventType::ARMOR_BROKE:
+                out << "Your armor breaks!";
+                break;
+            case RealTimeEventType::ENEMY_HIT:
+                if (encounter.getCount() == 1) {
+                    out << "The " << encounter.getName(0) << " deals " << event.amount
+                        << " damage to you!";
+                } else {
+                    out << "The enemies deal " << event.amount << " damage to you!";
+                }
+                break;
+            case RealTimeEventType::ENEMY_BLOCKED:
+                out << "You block the attack! You take " << event.amount << " damage.";
+                break;
+            case RealTimeEventType::ENEMY_SPELL:
+                out << "A spell hits you for " << event.amount << " damage!";
+                break;
+            case RealTimeEventType::ENEMY_HEALED:
+                if (encounter.getCount() == 1) {
+                    out << "The " << encounter.getName(0) << " heals " << event.amount
+                        << " health!";
+                } else {
+                    out << "The enemies heal " << event.amount << " health!";
+                }
+                break;
+            case RealTimeEventType::ENEMY_ENRAGED:
+                describeEnemies(event.amount, "flies into a rage!", "fly into a rage!");
+                break;
+            case RealTimeEventType::ENEMY_FLED:
+                describeEnemies(event.amount, "flees!", "flee!");
+                break;
+            case RealTimeEventType::ENEMY_POISONED:
+                if (encounter.getCount() == 1) {
+                    out << "The poison deals " << event.amount << " damage to the "
+                        << encounter.getName(0) << "!";
+                } else {
+                    out << "The poison deals " << event.amount << " damage to the enemies!";
+                }
+                break;
+            case RealTimeEventType::PLAYER_POISONED:
+                out << "The poison deals " << event.amount << " damage to you!";
+                break;
+        }
+        out << '\n';
+    }
+    RealTimeOutcome outcome = realTimeCombat->getOutcome();
+    // Kills are rewarded as they happen, so fleeing a pack keeps what's been earned
+    if (outcome != RealTimeOutcome::DEFEAT) rewardDefeatedEnemies();
+    if (!realTimeEvents.empty() && outcome == RealTimeOutcome::ONGOING) printRealTimeStatus();
+
+    if (outcome == RealTimeOutcome::ONGOING) return;
+    realTimeCombat.reset();
+    switch (outcome) {
+        case RealTimeOutcome::VICTORY:
+            winCombat();
+            break;
+        case RealTimeOutcome::DEFEAT:
+            loseCombat();
+            break;
+        case RealTimeOutcome::FLED:
+            if (encounter.getCount() == 1) {
+                out << "You successfully escape from the " << encounter.getName(0) << "!"
+                    << '\n';
+            } else {
+                out << "You successfully escape from the enemies!" << '\n';
+            }
+            endCombat();
+            break;
+        case RealTimeOutcome::ONGOING:
+            break;
+    }
+}
+
+void GameSession::printRealTimeStatus() {
+    out << "HP " << player->getHealth() << "/" << player->getMaxHealth() << " | Stamina "
+        << player->getStamina() << "/" << player->getMaxStamina();
+    size_t living = 0;
+    for (size_t i = 0; i < encounter.getCount(); ++i) {
+        if (!encounter.isAlive(i)) continue;
+        if (living++ == 0) {
+            out << " | " << encounter.getName(i) << " HP " << encounter.getHealth(i);
+        }
+    }
+    if (living > 1) out << " (+" << living - 1 << " more)";
+    uint64_t readyIn = realTimeCombat->getPlayerReadyInMs();
+    if (readyIn > 0) out << " | Ready in " << readyIn << " ms";
+    out << '\n';
+}
+
+void GameSession::promptCombatAction() {
+    if (encounter.isDefeated() || player->getHealth() <= 0) {
+        endCombat();
+        return;
+    }
+
+    out << '\n' << "=== COMBAT STATUS ===" << '\n';
+    out << "Your Health: " << player->getHealth() << "/" << player->getMaxHealth() << '\n';
+    out << "Your Stamina: " << player->getStamina() << "/" << player->getMaxStamina() << '\n';
+    if (player->getStatusEffects().getActiveCount() > 0) {
+        out << "Your Effects: ";
+        printStatusEffects(player->getStatusEffects());
+    }
+    for (size_t i = 0; i < encounter.getCount(); ++i) {
+        // Numbered when there's more than one, matching the target prompt
+        if (encounter.getCount() > 1) out << i + 1 << ". ";
+        out << encounter.getName(i) << " Health: " << encounter.getHealth(i) << '\n';
+        if (encounter.getStatusEffects(i).getActiveCount() > 0) {
+            out << encounter.getName(i) << " Effects: ";
+            printStatusEffects(encounter.getStatusEffects(i));
+        }
+    }
+    out << "--------------------------------" << '\n';
+
+    out << "Choose your action:" << '\n';
+    out << "1. Attack (costs stamina)" << '\n';
+    out << "2. Defend (recover stamina, reduce incoming damage)" << '\n';
+    out << "3. Power Attack (double damage, costs more stamina)" << '\n';
+    out << "4. Use Item" << '\n';
+    out << "5. Equip Gear (takes a turn)" << '\n';
+    out << "6. Try to flee" << '\n';
+    out << "Enter your choice (1-6): ";
+    state = SessionState::COMBAT_ACTION;
+}
+
+void GameSession::handleCombatAction(const std::string& line) {
+    if (isBlank(line)) return;
+
+    int combatChoice = 0;
+    if (!parseIntInput(line, combatChoice) || combatChoice < 1 || combatChoice > 6) {
+        out << "Invalid choice! You fumble and lose your turn!" << '\n';
+        combatChoice = 0;  // Skip player turn
+    } else {
+        // Combat actions 1-6 map onto the first six PlayerCommand values
+        markCommand(static_cast<PlayerCommand>(combatChoice - 1));
+    }
+
+    bool playerDefending = false;
+    bool playerActed = true;
+
+    switch (combatChoice) {
+        case 1:  // Normal Attack
+            if (player->getStamina() < 5) {
+                out << "You're too tired to attack effectively! (Need 5 stamina)" << '\n';
+                playerActed = false;
+                break;
+            }
+            if (encounter.getCount() > 1) {
+                pendingAttack = combatChoice;
+                promptCombatTarget();
+                return;
+            }
+            runAttack(combatChoice);
+            break;
+
+        case 2: {  // Defend
+            out << "You take a defensive stance!" << '\n';
+            playerDefending = true;
+            // Recover 30% of max stamina while defending
+            player->recoverStamina(
+                getStaminaRecovery(player->getMaxStamina(), DEFEND_STAMINA_RECOVERY));
+            out << "You recover stamina and prepare to block incoming attacks!" << '\n';
+            break;
+        }
+
+        case 3: {  // Power Attack (double damage, triple stamina, lower accuracy, double
+                   // durability loss)
+            unsigned int requiredStamina = powerAttackStamina();
+            if (player->getStamina() < requiredStamina) {
+                out << "You don't have enough stamina for a power attack! (Need "
+                    << requiredStamina << " stamina)" << '\n';
+                playerActed = false;
+                break;
+            }
+            if (encounter.getCount() > 1) {
+                pendingAttack = combatChoice;
+                promptCombatTarget();
+                return;
+            }
+            runAttack(combatChoice);
+            break;
+        }
+
+        case 4: {  // Use Item
+            usableItems.clear();
+
+            // Find usable items (potions)
+            for (Item* item : player->getInventory()) {
+                if (item->getType() == POTION) {
+                    usableItems.push_back(item);
+                }
+            }
+
+            if (usableItems.empty()) {
+                out << "You have no usable items in combat!" << '\n';
+                playerActed = false;
+                break;
+            }
+
+            out << "Choose an item to use:" << '\n';
+            for (size_t i = 0; i < usableItems.size(); ++i) {
+                const PotionData& potionData = usableItems[i]->getPotionData();
+                out << i + 1 << ". " << usableItems[i]->getName();
+                if (usableItems[i]->getQuantity() > 1) {
+                    out << " x" << usableItems[i]->getQuantity();
+                }
+
+                // Display potion effect based on type
+                switch (potionData.getPotionType()) {
+                    case HEALING:
+                        out << " (Restores " << potionData.getMinPotency() << "-"
+                            << potionData.getMaxPotency() << " HP)";
+                        break;
+                    case STAMINA:
+                        out << " (Restores " << potionData.getMinPotency() << "-"
+                            << potionData.getMaxPotency() << " Stamina)";
+                        break;
+                    case DAMAGE:
+                        out << " (Increases damage by " << potionData.getMinPotency() << "-"
+                            << potionData.getMaxPotency() << " for " << POTION_BUFF_TURNS
+                            << " turns)";
+                        break;
+                    case DEFENSE:
+                        out << " (Increases defense by " << potionData.getMinPotency() << "-"
+                            << potionData.getMaxPotency() << " for " << POTION_BUFF_TURNS
+                            << " turns)";
+                        break;
+                    case RESISTENCE:
+                        out << " (Increases resistance by " << potionData.getMinPotency() << "-"
+                            << potionData.getMaxPotency() << " for " << POTION_BUFF_TURNS
+                            << " turns)";
+                        break;
+                    case POISON:
+                        out << " (Deals " << potionData.getMinPotency() << "-"
+                            << potionData.getMaxPotency() << " poison damage to enemies over "
+                            << POISON_TURNS << " turns)";
+                        break;
+                }
+                out << '\n';
+            }
+            out << "0. Cancel" << '\n';
+            state = SessionState::COMBAT_ITEM_CHOICE;
+            return;
+        }
+
+        case 5:  // Equip Gear
+            if (promptEquipGear()) {
+                state = SessionState::COMBAT_EQUIP_CHOICE;
+                return;
+            }
+            out << "Equip cancelled." << '\n';
+            playerActed = false;
+            break;
+
+        case 6: {  // Try to flee
+            int fleeChance = randomInt(1, 100);
+            if (fleeChance <= 20) {  // 20% chance to flee successfully mid-fight
+                if (encounter.getCount() == 1) {
+                    out << "You successfully escape from the " << encounter.getName(0) << "!"
+                        << '\n';
+                } else {
+                    out << "You successfully escape from the enemies!" << '\n';
+                }
+                endCombat();
+                return;
+            }
+            if (encounter.getCount() == 1) {
+                out << "You failed to escape! The " << encounter.getName(0)
+                    << " blocks your path!" << '\n';
+            } else {
+                out << "You failed to escape! The enemies block your path!" << '\n';
+            }
+            break;
+        }
+
+        case 0:  // Skip turn (invalid input)
+            out << "You stand there confused, losing your chance to act!" << '\n';
+            playerActed = false;
+            break;
+    }
+
+    resolveCombatTurn(playerActed, playerDefending);
+}
+
+void GameSession::promptCombatTarget() {
+    out << "Choose a target:" << '\n';
+    for (size_t i = 0; i < encounter.getCount(); ++i) {
+        out << i + 1 << ". " << encounter.getName(i) << " (Health: " << encounter.getHealth(i)
+            << "/" << encounter.getMaxHealth(i) << ")" << '\n';
+    }
+    out << "Enter a target (1-" << encounter.getCount() << "): ";
+    state = SessionState::COMBAT_TARGET_CHOICE;
+}
+
+void GameSession::handleCombatTarget(const std::string& line) {
+    if (isBlank(line)) return;
+
+    int target = 0;
+    if (!parseIntInput(line, target) || target < 1 ||
+        target > static_cast<int>(encounter.getCount())) {
+        out << "Invalid target! You hesitate and lose your turn!" << '\n';
+        resolveCombatTurn(false, false);
+        return;
+    }
+    combatTarget = static_cast<size_t>(target - 1);
+    runAttack(pendingAttack);
+    resolveCombatTurn(true, false);
+}
+
+unsigned int GameSession::powerAttackStamina() const {
+    Item* equippedWeapon = player->getEquippedWeapon();
+    if (equippedWeapon && equippedWeapon->getType() == WEAPON) {
+        // Power attack costs 3x weapon stamina
+        return equippedWeapon->getWeaponData().getStaminaCost() * 3;
+    }
+    return 15;  // Default for unarmed
+}
+
+void GameSession::runAttack(int combatChoice) {
+    if (combatChoice == 3) {
+        out << "You charge up a powerful attack!" << '\n';
+        player->useStamina(powerAttackStamina());
+        playerPowerAttack();
+    } else {
+        playerAttack();
+    }
+}
+
+void GameSession::playerAttack() {
+    out << "You attack the " << encounter.getName(combatTarget) << "!" << '\n';
+    player->useStamina(5);
+    playerStrike(false);
+}
+
+void GameSession::playerPowerAttack() { playerStrike(true); }
+
+void GameSession::playerStrike(bool power) {
+    Item* equippedWeapon = player->getEquippedWeapon();
+    bool armed = equippedWeapon && equippedWeapon->getType() == WEAPON;
+
+    DamageContext strike = makeDamageContext(rng);
+    strike.power = power;
+    WeaponType weaponType = SWORD;  // Ignored when unarmed
+    if (armed) {
+        const WeaponData& weaponData = equippedWeapon->getWeaponData();
+        strike.armed = true;
+        strike.minDamage = weaponData.getMinDamage();
+        strike.maxDamage = weaponData.getMaxDamage();
+        strike.accuracy = weaponData.getAccuracy();
+        strike.durability = weaponData.getDurability();
+        weaponType = weaponData.getWeaponType();
+    }
+    strike.damageBonus = player->getStatusEffects().getModifier(StatusEffectType::DAMAGE_BOOST);
+    EnemyType targetType = encounter.getType(combatTarget);
+    aimStrike(strike, weaponType, targetType, encounter.getDefence(combatTarget),
+              encounter.getResistance(combatTarget));
+    getPlayerStrikePipeline().run(strike);
+
+    if (!armed) {
+        // Unarmed combat always hits, but for lower damage
+        out << (power ? "You put all your strength into a crushing blow!"
+                      : "You attack with your bare hands!")
+            << '\n';
+    } else if (strike.missed) {
+        out << (power ? "You swing wildly and miss with your " : "You miss with your ")
+            << equippedWeapon->getName() << "!" << '\n';
+    } else {
+        out << (power ? "You unleash a devastating blow with your " : "You strike with your ")
+            << equippedWeapon->getName() << "!" << '\n';
+        int percent = EffectivenessMatrix::getInstance().getPercent(weaponType, targetType);
+        if (percent > EffectivenessMatrix::NEUTRAL_PERCENT) {
+            out << "It's very effective against " << encounter.getName(combatTarget) << "!"
+                << '\n';
+        } else if (percent < EffectivenessMatrix::NEUTRAL_PERCENT) {
+            out << "It's not very effective against " << encounter.getName(combatTarget) << "..."
+                << '\n';
+        }
+
+        // Power attacks wear the weapon twice as fast
+        if (player->wearEquipped(EquipmentSlot::WEAPON, strike.wear)) {
+            out << "Your " << equippedWeapon->getName()
+                << (power ? " breaks from the intense power attack!" : " breaks from overuse!")
+                << '\n';
+            player->breakEquipped(EquipmentSlot::WEAPON);
+        } else if (strike.wear > 0 && strike.durability <= 5) {
+            out << "Your " << equippedWeapon->getName()
+                << (power ? " is severely damaged from the power attack! (Durability: "
+                          : " is getting worn out! (Durability: ")
+                << strike.durability << ")" << '\n';
+        }
+    }
+
+    if (strike.damage > 0) {
+        if (strike.critical) out << "Critical hit! ";
+        if (armed && getDamageChannel(weaponType) == DamageChannel::SPELL) {
+            encounter.takeSpellDamage(combatTarget, strike.damage);
+        } else {
+            encounter.loseHealth(combatTarget, strike.dealt);
+        }
+        out << "You deal " << strike.damage << " damage!" << '\n';
+    } else if (equippedWeapon) {
+        out << "No damage dealt!" << '\n';
+    }
+}
+
+void GameSession::handleCombatItemChoice(const std::string& line) {
+    if (isBlank(line)) return;
+
+    int itemChoice = 0;
+    parseIntInput(line, itemChoice);
+    markCommand(PlayerCommand::COMBAT_USE_ITEM);
+
+    if (itemChoice <= 0 || itemChoice > static_cast<int>(usableItems.size())) {
+        out << "Cancelled item use." << '\n';
+        resolveCombatTurn(false, false);
+        return;
+    }
+
+    Item* chosenItem = usableItems[itemChoice - 1];
+    const PotionData& potionData = chosenItem->getPotionData();
+    int potionEffect = randomInt(potionData.getMinPotency(), potionData.getMaxPotency());
+
+    switch (potionData.getPotionType()) {
+        case HEALING:
+            player->heal(potionEffect);
+            out << "You use " << chosenItem->getName() << " and recover " << potionEffect
+                << " health!" << '\n';
+            break;
+        case STAMINA:
+            player->recoverStamina(potionEffect);
+            out << "You use " << chosenItem->getName() << " and recover " << potionEffect
+                << " stamina!" << '\n';
+            break;
+        case DAMAGE:
+            player->getStatusEffects().apply(StatusEffectType::DAMAGE_BOOST, potionEffect,
+                                             POTION_BUFF_TURNS);
+            out << "You use " << chosenItem->getName() << " and feel your strength surge! (+"
+                << potionEffect << " damage for " << POTION_BUFF_TURNS << " turns)" << '\n';
+            break;
+        case DEFENSE:
+            player->getStatusEffects().apply(StatusEffectType::DEFENCE, potionEffect,
+                                             POTION_BUFF_TURNS);
+            out << "You use " << chosenItem->getName() << " and feel more protected! (+"
+                << potionEffect << " defense for " << POTION_BUFF_TURNS << " turns)" << '\n';
+            break;
+        case RESISTENCE:
+            player->getStatusEffects().apply(StatusEffectType::RESISTANCE, potionEffect,
+                                             POTION_BUFF_TURNS);
+            out << "You use " << chosenItem->getName()
+                << " and feel more resistant to magic! (+" << potionEffect << " resistance for "
+                << POTION_BUFF_TURNS << " turns)" << '\n';
+            break;
+        case POISON: {
+            // The potency is spread over the poison's turns, rounding up
+            int perTurn = std::max(1, (potionEffect + static_cast<int>(POISON_TURNS) - 1) /
+                                          static_cast<int>(POISON_TURNS));
+            // Thrown potions burst into a cloud that catches every enemy
+            encounter.applyEffectToAll(StatusEffectType::POISON, perTurn, POISON_TURNS);
+            if (encounter.getCount() == 1) {
+                out << "You use " << chosenItem->getName() << " and throw it at the "
+                    << encounter.getName(0) << "!" << '\n';
+                out << "The " << encounter.getName(0) << " is poisoned! (" << perTurn
+                    << " damage a turn for " << POISON_TURNS << " turns)" << '\n';
+            } else {
+                out << "You use " << chosenItem->getName() << " and throw it into the pack!"
+                    << '\n';
+                out << "All " << encounter.getCount() << " enemies are poisoned! (" << perTurn
+                    << " damage a turn for " << POISON_TURNS << " turns)" << '\n';
+            }
+            break;
+        }
+    }
+
+    // Use up one from the stack
+    player->removeItemFromInventory(chosenItem);
+    usableItems.clear();
+    resolveCombatTurn(true, false);
+}
+
+void GameSession::handleCombatEquipChoice(const std::string& line) {
+    if (isBlank(line)) return;
+
+    int choice = 0;
+    parseIntInput(line, choice);
+    markCommand(PlayerCommand::EQUIP);
+
+    if (equipChosenGear(choice)) {
+        resolveCombatTurn(true, false);
+    } else {
+        out << "Equip cancelled." << '\n';
+        resolveCombatTurn(false, false);
+    }
+}
+
+void GameSession::resolveCombatTurn(bool playerActed, bool playerDefending) {
+    // Check if the enemies are defeated
+    rewardDefeatedEnemies();
+    if (encounter.isEmpty()) {
+        winCombat();
+        return;
+    }
+
+    // Enemies' turn; defending halves every hit
+    if (playerActed) {
+        out << '\n' << "--- Enemy Turn ---" << '\n';
+        EncounterAttack attack = encounter.attack(*player, rng, playerDefending);
+        printEnemyTurn(attack, playerDefending);
+
+        // Nobody left to fight if the last of them ran
+        if (encounter.isDefeated() && player->getHealth() > 0) {
+            rewardDefeatedEnemies();
+            winCombat();
+            return;
+        }
+    }
+
+    // Natural stamina recovery (percentage-based each turn)
+    if (!playerDefending) {
+        // Recover 6% of max stamina each turn (scales with level)
+        player->recoverStamina(getStaminaRecovery(player->getMaxStamina(), TURN_STAMINA_RECOVERY));
+    }
+
+    // Poison, regen and buffs only count down on turns that were actually taken
+    if (playerActed) {
+        tickStatusEffects();
+        if (player->getHealth() > 0) {
+            rewardDefeatedEnemies();
+            if (encounter.isEmpty()) {
+                winCombat();
+                return;
+            }
+        }
+    }
+
+    out << "--------------------------------" << '\n';
+
+    if (player->getHealth() <= 0) {
+        loseCombat();
+        return;
+    }
+
+    // Add small pause for readability
+    out << "Press Enter to continue...";
+    state = SessionState::COMBAT_PAUSE;
+}
+
+void GameSession::describeEnemies(int count, const char* singular, const char* plural) {
+    if (encounter.getCount() == 1) {
+        out << "The " << encounter.getName(0) << " " << singular;
+    } else if (count == 1) {
+        out << "One of the enemies " << singular;
+    } else {
+        out << count << " of the enemies " << plural;
+    }
+}
+
+void GameSession::printEnemyTurn(const EncounterAttack& attack, bool playerDefending) {
+    if (attack.attackers > 0) {
+        describeEnemies(attack.attackers, "attacks you!", "attack you!");
+        out << '\n';
+        if (playerDefending) out << "You block some of the damage!" << '\n';
+        if (encounter.getCount() == 1) {
+            out << "The " << encounter.getName(0) << " deals " << attack.damage
+                << " damage to you!" << '\n';
+        } else {
+            out << "They deal " << attack.damage << " damage to you!" << '\n';
+        }
+    }
+    if (attack.casters > 0) {
+        describeEnemies(attack.casters, "casts a spell at you!", "cast spells at you!");
+        out << '\n';
+        if (playerDefending) out << "You block some of the magic!" << '\n';
+        out << "The magic deals " << attack.spellDamage << " damage to you!" << '\n';
+    }
+    if (attack.healers > 0) {
+        describeEnemies(attack.healers, "heals", "heal");
+        out << " " << attack.healed << " health!" << '\n';
+    }
+    if (attack.enraged > 0) {
+        describeEnemies(attack.enraged, "flies into a rage!", "fly into a rage!");
+        out << '\n';
+    }
+    if (attack.fled > 0) {
+        describeEnemies(attack.fled, "flees!", "flee!");
+        out << '\n';
+    }
+    if (attack.armorWear > 0) {
+        Item* armor = player->getEquippedArmor();
+        int durability = armor->getArmorData().getDurability();
+        if (attack.armorBroke) {
+            out << "Your " << armor->getName() << " breaks under the blows!" << '\n';
+            player->breakEquipped(EquipmentSlot::ARMOR);
+        } else if (durability <= 5) {
+            out << "Your " << armor->getName() << " is getting worn out! (Durability: "
+                << durability << ")" << '\n';
+        }
+    }
+    if (attack.attackers + attack.casters + attack.healers + attack.enraged + attack.fled == 0) {
+        describeEnemies(static_cast<int>(encounter.getCount()), "waits for an opening.",
+                        "circle you, waiting for an opening.");
+        out << '\n';
+    }
+}
+
+void GameSession::rewardDefeatedEnemies() {
+    defeatedEnemies.clear();
+    encounter.removeDefeated(defeatedEnemies);
+    for (const DefeatedEnemy& defeated : defeatedEnemies) {
+        out << '\n' << "The " << defeated.name << " has been defeated!" << '\n';
+
+        // Gold is rolled; experience comes from the level database's reward table
+        bool boss = defeated.rarity == EnemyRarity::BOSS;
+        int baseGoldReward = defeated.level * randomInt(5, 15);
+        int expReward = LevelDatabase::getInstance().calculateExperienceReward(
+            static_cast<int>(player->getLevel()), defeated.level, boss);
+
+        // 5x rewards for boss enemies (the reward table has its own boss multiplier)
+        if (boss) {
+            baseGoldReward *= 5;
+            out << "Boss defeated! Bonus rewards granted!" << '\n';
+        }
+
+        out << "You gained " << baseGoldReward << " gold!" << '\n';
+        player->addGold(baseGoldReward);
+        player->gainExperience(static_cast<unsigned int>(expReward), out.stream());
+        awardEnemyDrops(defeated);
+    }
+    // Targets close up behind the dead
+    if (combatTarget >= encounter.getCount()) combatTarget = 0;
+}
+
+void GameSession::winCombat() {
+    out << "Victory!" << '\n';
+    endCombat();
+}
+
+void GameSession::loseCombat() {
+    out << '\n' << "You have been defeated!" << '\n';
+    out << "Final Stats: " << '\n';
+    printCharacterInformation();
+    out << "Final Inventory: " << '\n';
+    printInventory(player->getInventory());
+    out << '\n' << '\n';
+    out << "Game Over!" << '\n';
+    encounter.clear();
+    state = SessionState::FINISHED;
+}
+
+void GameSession::tickStatusEffects() {
+    int poisonDamage = encounter.tickEffects();
+    if (poisonDamage > 0) {
+        out << "The poison deals " << poisonDamage << " damage to the "
+            << (encounter.getCount() == 1 ? encounter.getName(0) : "enemies") << "!" << '\n';
+    }
+
+    StatusTick playerTick = player->getStatusEffects().tick();
+    if (playerTick.poisonDamage > 0) {
+        player->loseHealth(playerTick.poisonDamage);
+        out << "The poison deals " << playerTick.poisonDamage << " damage to you!" << '\n';
+    }
+    if (playerTick.staminaRegen > 0) player->recoverStamina(playerTick.staminaRegen);
+}
+
+void GameSession::printStatusEffects(const StatusEffects& effects) {
+    static const char* const labels[STATUS_EFFECT_TYPE_COUNT] = {
+        " damage", " defence", " resistance", " poison a turn", " stamina a turn"};
+    bool first = true;
+    for (size_t i = 0; i < STATUS_EFFECT_TYPE_COUNT; ++i) {
+        int modifier = effects.getModifier(static_cast<StatusEffectType>(i));
+        if (modifier == 0) continue;
+        if (!first) out << ", ";
+        out << (modifier > 0 ? "+" : "") << modifier << labels[i];
+        first = false;
+    }
+    out << '\n';
+}
+
+void GameSession::handleCombatPause(const std::string&) { promptCombatAction(); }
+
+void GameSession::endCombat() {
+    // Clean up the encounter
+    realTimeCombat.reset();
+    encounter.clear();
+    // Potion buffs only last for the fight
+    player->getStatusEffects().clear();
+
+    if (combatReturn == CombatReturn::CHEST_LOOT) {
+        Item* item = pendingChestItem;
+        pendingChestItem = nullptr;
+        awardChestItem(item);
+    }
+    promptContinue();
+}
+
+bool GameSession::promptEquipGear() {
+    availableGear.clear();
+
+    // Find everything in the inventory that can be worn or wielded
+    for (Item* item : player->getInventory()) {
+        EquipmentSlot slot;
+        if (getEquipmentSlot(item->getType(), slot)) availableGear.push_back(item);
+    }
+
+    if (availableGear.empty()) {
+        out << "You have no weapons or armor in your inventory to equip!" << '\n';
+        return false;
+    }
+
+    // Show what's currently equipped
+    Item* currentWeapon = player->getEquippedWeapon();
+    if (currentWeapon) {
+        out << "Currently equipped: " << currentWeapon->getName() << '\n';
+        const WeaponData& wd = currentWeapon->getWeaponData();
+        out << "  Damage: " << wd.getMinDamage() << "-" << wd.getMaxDamage()
+            << " | Stamina Cost: " << wd.getStaminaCost() << '\n';
+    } else {
+        out << "Currently equipped: None (fighting unarmed)" << '\n';
+    }
+    Item* currentArmor = player->getEquippedArmor();
+    if (currentArmor) {
+        const ArmorData& ad = currentArmor->getArmorData();
+        out << "Currently worn: " << currentArmor->getName() << '\n';
+        out << "  Armor: " << ad.getArmorValue() << " | Durability: " << ad.getDurability()
+            << '\n';
+    } else {
+        out << "Currently worn: None" << '\n';
+    }
+
+    out << '\n' << "Available gear to equip:" << '\n';
+    for (size_t i = 0; i < availableGear.size(); ++i) {
+        Item* gear = availableGear[i];
+        out << i + 1 << ". " << gear->getName();
+        if (gear->isEquipped()) out << " (equipped)";
+        out << '\n';
+        if (gear->getType() == WEAPON) {
+            const WeaponData& wd = gear->getWeaponData();
+            out << "   Damage: " << wd.getMinDamage() << "-" << wd.getMaxDamage()
+                << " | Stamina Cost: " << wd.getStaminaCost() << '\n';
+        } else {
+            const ArmorData& ad = gear->getArmorData();
+            out << "   Armor: " << ad.getArmorValue() << " | Durability: " << ad.getDurability()
+                << '\n';
+        }
+        out << "   " << gear->getDescription() << '\n';
+    }
+    out << "0. Cancel" << '\n';
+
+    out << "Choose gear to equip: ";
+    return true;
+}
+
+bool GameSession::equipChosenGear(int choice) {
+    if (choice <= 0 || choice > static_cast<int>(availableGear.size())) {
+        return false;  // Cancelled
+    }
+
+    Item* chosenGear = availableGear[choice - 1];
+    availableGear.clear();
+
+    EquipmentSlot slot;
+    if (!getEquipmentSlot(chosenGear->getType(), slot)) return false;
+
+    // Whatever was in the slot comes off first
+    Item* previous = player->equip(slot, chosenGear);
+    if (previous && previous != chosenGear) {
+        out << "Unequipped " << previous->getName() << '\n';
+    }
+    out << "Equipped " << chosenGear->getName() << "!" << '\n';
+
+    return true;
+}
+
+void GameSession::spawnChest() {
+    out << "You found a chest!" << '\n';
+    out << "Do you want to open it? (y/n): ";
+    state = SessionState::CHEST_PROMPT;
+}
+
+void GameSession::handleChestChoice(const std::string& line) {
+    char choice = firstCharInput(line);
+    if (choice == '\0') return;
+
+    if (choice != 'y' && choice != 'Y') {
+        out << "You decided to leave the chest alone." << '\n';
+        promptContinue();
+        return;
+    }
+    markCommand(PlayerCommand::CHEST_OPEN);
+
+    // Generate random chest properties
+    bool isLocked = randomInt(1, 100) > 90;  // 10% chance locked
+
+    // Determine trap type
+    trap trapType = NONE;
+    int trapRoll = randomInt(1, 100);
+    if (trapRoll <= 20) {  // 20% chance trapped
+        int trapTypeRoll = randomInt(1, 3);
+        switch (trapTypeRoll) {
+            case 1:
+                trapType = POISON_DART;
+                break;
+            case 2:
+                trapType = EXPLOSION;
+                break;
+            case 3:
+                trapType = ALARM;
+                break;
+            default:
+                trapType = POISON_DART;
+        }
+    }
+
+    // Roll the chest's item from the loot table for the player's level
+    Item* chestItem = nullptr;
+    const LootTable* lootTable = LootTableDatabase::getInstance().getChestTable(
+        LootTableDatabase::getChestTierForLevel(static_cast<int>(player->getLevel())));
+    const ItemTemplate* loot = lootTable ? lootTable->draw(rng) : nullptr;
+    if (loot) {
+        chestItem = ItemDatabase::getInstance().createItem(*loot, 1);
+    }
+
+    // Create the chest with generated properties
+    Chest chest(isLocked, trapType, chestItem);
+
+    // Attempt to open the chest
+    OpenChestResult result = chest.open();
+
+    // Handle the result
+    switch (result.result) {
+        case SUCCESS:
+            out << "You successfully opened the chest!" << '\n';
+            if (result.item) {
+                out << "You found: " << result.item->getName() << "!" << '\n';
+                out << result.item->getDescription() << '\n';
+
+                // Handle the item based on its type
+                if (result.item->getType() == CURRENCY) {
+                    player->pickupItem(result.item, out.stream());
+                } else {
+                    player->addItemToInventory(result.item);
+                }
+            }
+            break;
+
+        case LOCKED:
+            out << "The chest is locked!" << '\n';
+            // Clean up the item since player couldn't get it
+            delete chestItem;
+            break;
+
+        case TRAPPED:
+            out << "The chest was trapped!" << '\n';
+
+            // Handle trap effects
+            switch (result.trapInfo.type) {
+                case POISON_DART:
+                    out << "A poison dart shoots out and hits you!" << '\n';
+                    out << "You take " << result.trapInfo.damage << " poison damage!" << '\n';
+                    player->takeDamage(result.trapInfo.damage);
+                    break;
+
+                case EXPLOSION:
+                    out << "The chest explodes!" << '\n';
+                    out << "You take " << result.trapInfo.damage << " explosive damage!" << '\n';
+                    player->takeDamage(result.trapInfo.damage);
+                    if (result.trapInfo.summonsEnemies) {
+                        out << "The explosion attracts nearby enemies!" << '\n';
+                        if (spawnEncounter(randomInt(1, 2), EnemyAI::ATTACK)) {
+                            // The item is handed over once the fight is over
+                            pendingChestItem = result.item;
+                            startCombat(CombatReturn::CHEST_LOOT);
+                            return;
+                        }
+                    }
+                    break;
+
+                case ALARM:
+                    out << "An alarm goes off, alerting nearby creatures!" << '\n';
+                    if (result.trapInfo.summonsEnemies) {
+                        out << "Enemies are approaching!" << '\n';
+                        // A whole pack answers the alarm, bigger the further you've come
+                        int packSize = std::min(
+                            MAX_AMBUSH_SIZE,
+                            randomInt(2, 2 + static_cast<int>(player->getLevel()) / 3));
+                        if (spawnEncounter(packSize, EnemyAI::SWARM)) {
+                            pendingChestItem = result.item;
+                            startCombat(CombatReturn::CHEST_LOOT);
+                            return;
+                        }
+                    }
+                    break;
+
+                case NONE:
+                    break;
+            }
+
+            awardChestItem(result.item);
+            break;
+
+        case EMPTY:
+            out << "You opened the chest, but it's empty." << '\n';
+            break;
+    }
+    promptContinue();
+}
+
+void GameSession::awardEnemyDrops(const DefeatedEnemy& defeated) {
+    const ItemTemplate* drops[LootTableDatabase::MAX_DROP_ROLLS];
+    int dropCount = LootTableDatabase::getInstance().rollEnemyDrops(defeated.type,
+                                                                    defeated.rarity, rng, drops);
+    for (int i = 0; i < dropCount; ++i) {
+        Item* item = ItemDatabase::getInstance().createItem(*drops[i], 1);
+        out << "The " << defeated.name << " dropped: " << item->getName() << "!" << '\n';
+        if (item->getType() == CURRENCY) {
+            player->pickupItem(item, out.stream());
+        } else {
+            player->addItemToInventory(item);
+        }
+    }
+}
+
+void GameSession::awardChestItem(Item* item) {
+    // Player still gets the item if they survive the trap
+    if (!item) return;
+
+    out << "Despite the trap, you manage to retrieve the item!" << '\n';
+    out << "You found: " << item->getName() << "!" << '\n';
+    out << item->getDescription() << '\n';
+
+    // Handle the item based on its type
+    if (item->getType() == CURRENCY) {
+        player->pickupItem(item, out.stream());
+    } else {
+        player->addItemToInventory(item);
+    }
+}
+
+void GameSession::spawnMerchant() {
+    out << "A wandering merchant appears!" << '\n';
+    int rand = randomInt(1, 6);
+    switch (rand) {
+        case 1:
+            out << "Merchant: Well hello there young traveler! Would you be intresting in "
+                   "selling me your wares?"
+                << '\n';
+            break;
+        case 2:
+            out << "Merchant: How are ye doing on this fine day? Care to trade?" << '\n';
+            break;
+        case 3:
+            out << "Merchant: I have the finest goods in all the land! Care to take a look?"
+                << '\n';
+            break;
+        case 4:
+            out << "Merchant: I've heard tales of your adventures. Care to trade?" << '\n';
+            break;
+        case 5:
+            out << "Merchant: I remember when I was your age, full of dreams and ambitions. "
+                   "Care to trade?"
+                << '\n';
+            break;
+        case 6:
+            out << "Merchant: The road is dangerous, but my goods can make it safer. Care to trade?"
+                << '\n';
+            break;
+        default:
+            out << "Merchant: Greetings! Care to trade?" << '\n';
+            break;
+    }
+    out << "------ Merchant Inventory ------" << '\n';
+    // Random number generator for the items types (as of now only 5 types)
+    static const ItemType specialties[] = {WEAPON, ARMOR, POTION, CURRENCY, MISC};
+    rand = randomInt(1, 5);
+    if (!merchants) merchants = std::make_unique<MerchantRoster>(eventCount);
+    merchant = &merchants->getMerchant(specialties[rand - 1]);
+    merchant->restock(eventCount);
+    PricingEngine& pricing = PricingEngine::getInstance();
+    pricing.recomputeIfDue();
+    merchant->updatePrices(pricing);
+
+    // Print merchant inventory
+    const std::vector<MerchantStockEntry>& stock = merchant->getStock();
+    for (size_t i = 0; i < stock.size(); ++i) {
+        const ItemTemplate& item = *stock[i].item;
+        out << i + 1 << ". " << item.name << " (" << stock[i].price << " gold, ";
+        if (stock[i].quantity > 0) {
+            out << stock[i].quantity << " in stock)" << '\n';
+        } else {
+            out << "sold out)" << '\n';
+        }
+        out << "    " << item.description << '\n';
+        out << "    Type: " << static_cast<int>(item.type)
+            << ", Rarity: " << static_cast<int>(item.rarity) << '\n';
+        // Type-specific data
+        if (item.type == WEAPON) {
+            const WeaponData& wd = item.weaponData;
+            out << "    Weapon Data:" << '\n';
+            out << "      Min Damage: " << wd.getMinDamage() << '\n';
+            out << "      Max Damage: " << wd.getMaxDamage() << '\n';
+            out << "      Accuracy: " << wd.getAccuracy() << " %" << '\n';
+            out << "      Cooldown: " << wd.getCooldown() << " ms" << '\n';
+            out << "      Weapon Type: " << static_cast<int>(wd.getWeaponType()) << '\n';
+            out << "      Durability: " << wd.getDurability() << '\n';
+            out << "      Stamina Cost: " << wd.getStaminaCost() << '\n';
+        } else if (item.type == ARMOR) {
+            const ArmorData& ad = item.armorData;
+            out << "    Armor Data:" << '\n';
+            out << "      Armor Value: " << ad.getArmorValue() << '\n';
+            out << "      Durability: " << ad.getDurability() << '\n';
+        } else if (item.type == POTION) {
+            const PotionData& pd = item.potionData;
+            out << "    Potion Data:" << '\n';
+            out << "      Potion Type: " << static_cast<int>(pd.getPotionType()) << '\n';
+            out << "      Min Potency: " << pd.getMinPotency() << '\n';
+            out << "      Max Potency: " << pd.getMaxPotency() << '\n';
+        } else if (item.type == CURRENCY) {
+            out << "    Currency Data:" << '\n';
+            out << "      Gold Value: " << item.value << '\n';
+        }
+        out << "--------------------------" << '\n';
+    }
+    out << "Merchant: If you see anything you like, just let me know!" << '\n';
+    promptMerchantMenu();
+}
+
+void GameSession::promptMerchantMenu() {
+    out << "1. Buy Item" << '\n';
+    out << "2. Sell Item" << '\n';
+    out << "3. Leave" << '\n';
+    out << "Enter your choice: ";
+    state = SessionState::MERCHANT_MENU;
+}
+
+void GameSession::handleMerchantMenu(const std::string& line) {
+    if (isBlank(line)) return;
+
+    int choice = 0;
+    if (!parseIntInput(line, choice) || choice < 1 || choice > 3) {
+        out << "Invalid choice. Please enter a number between 1 and 3." << '\n';
+        promptMerchantMenu();
+        return;
+    }
+    switch (choice) {
+        case 1:
+            // Buy Item
+            out << "Which item would you like to buy? Enter the number: ";
+            state = SessionState::MERCHANT_BUY;
+            return;
+        case 2:
+            // Sell Item
+            if (player->getInventory().empty()) {
+                out << "You have no items to sell." << '\n';
+                break;
+            }
+            out << "Your inventory:" << '\n';
+            printInventory(player->getInventory());
+            out << "Enter the number of the item to sell: ";
+            state = SessionState::MERCHANT_SELL;
+            return;
+        case 3:
+            out << "Merchant: Safe travels, adventurer!" << '\n';
+            leaveMerchant();
+            return;
+    }
+    promptMerchantMenu();
+}
+
+void GameSession::handleMerchantBuy(const std::string& line) {
+    if (isBlank(line)) return;
+
+    int buyChoice = 0;
+    bool valid = parseIntInput(line, buyChoice);
+    markCommand(PlayerCommand::MERCHANT_BUY);
+
+    const std::vector<MerchantStockEntry>& stock = merchant->getStock();
+    if (!valid || buyChoice < 1 || buyChoice > static_cast<int>(stock.size())) {
+        out << "Invalid item number." << '\n';
+    } else {
+        const MerchantStockEntry& entry = stock[buyChoice - 1];
+        if (entry.quantity <= 0) {
+            out << "Merchant: Sorry, I'm all out of " << entry.item->name << "." << '\n';
+        } else if (player->getGold() < static_cast<unsigned int>(entry.price)) {
+            out << "You don't have enough gold!" << '\n';
+        } else {
+            int price = entry.price;
+            Item* itemToBuy = merchant->takeItem(buyChoice - 1, buyChoice);
+            player->removeGold(price);
+            player->addItemToInventory(itemToBuy);
+            PricingEngine::getInstance().recordPurchase(*entry.item);
+            out << "You bought " << entry.item->name << " for " << price << " gold." << '\n';
+        }
+    }
+    promptMerchantMenu();
+}
+
+void GameSession::handleMerchantSell(const std::string& line) {
+    if (isBlank(line)) return;
+
+    int sellChoice = 0;
+    bool valid = parseIntInput(line, sellChoice);
+    markCommand(PlayerCommand::MERCHANT_SELL);
+
+    const std::vector<Item*>& inv = player->getInventory();
+    if (!valid || sellChoice < 1 || sellChoice > static_cast<int>(inv.size())) {
+        out << "Invalid item number." << '\n';
+    } else {
+        Item* itemToSell = inv[sellChoice - 1];
+        const ItemTemplate* itemTemplate =
+            ItemDatabase::getInstance().getItemTemplate(itemToSell->getName());
+        PricingEngine& pricing = PricingEngine::getInstance();
+        int price = itemTemplate ? pricing.getPrice(*itemTemplate) : itemToSell->getValue();
+        player->addGold(price);
+        out << "You sold " << itemToSell->getName() << " for " << price << " gold." << '\n';
+
+        // The merchant puts things they trade in back on the shelf
+        if (itemTemplate) {
+            merchant->acceptItem(*itemTemplate);
+            pricing.recordSale(*itemTemplate);
+        }
+
+        // Selling equipped gear takes it off first
+        player->removeItemFromInventory(itemToSell);
+    }
+    promptMerchantMenu();
+}
+
+void GameSession::leaveMerchant() {
+    merchant = nullptr;
+    promptContinue();
+}
+
+void GameSession::printCharacterInformation() {
+    out << "Character Information:" << '\n';
+    out << "Name: " << player->getName() << '\n';
+    out << "Health: " << player->getHealth() << "/" << player->getMaxHealth() << '\n';
+    out << "Stamina: " << player->getStamina() << "/" << player->getMaxStamina() << '\n';
+    out << "Defence: " << player->getDefence() << '\n';
+    out << "Resistance: " << player->getResistance() << '\n';
+    out << "Gold: " << player->getGold() << '\n';
+    out << "Level: " << player->getLevel() << " ("
+        << LevelDatabase::getInstance().getLevelTitle(player->getLevel()) << ")" << '\n';
+    out << "Experience: " << player->getExperience() << '\n';
+    out << "Next Level Exp: " << player->getNextLevelExp() << '\n';
+}
+
+void GameSession::printInventory(const std::vector<Item*>& inventory) {
+    if (inventory.empty()) {
+        out << "Inventory is empty." << '\n';
+        return;
+    }
+    out << "Inventory:" << '\n';
+    for (size_t i = 0; i < inventory.size(); ++i) {
+        const Item* item = inventory[i];
+        out << i + 1 << ".\n";
+        out << "  ID: " << item->getId() << '\n';
+        out << "  Name: " << item->getName() << '\n';
+        if (item->isStackable()) out << "  Quantity: " << item->getQuantity() << '\n';
+        out << "  Description: " << item->getDescription() << '\n';
+        out << "  Value: " << item->getValue() << '\n';
+        out << "  Weight: " << item->getStackWeight() << '\n';
+        out << "  Type: " << static_cast<int>(item->getType()) << '\n';
+        out << "  Rarity: " << static_cast<int>(item->getRarity()) << '\n';
+        out << "  Equipped: " << (item->isEquipped() ? "Yes" : "No") << '\n';
+        // Print type-specific data
+        if (item->getType() == WEAPON) {
+            const WeaponData& wd = item->getWeaponData();
+            out << "  Weapon Data:" << '\n';
+            out << "    Min Damage: " << wd.getMinDamage() << '\n';
+            out << "    Max Damage: " << wd.getMaxDamage() << '\n';
+            out << "    Accuracy: " << wd.getAccuracy() << " %" << '\n';
+            out << "    Cooldown: " << wd.getCooldown() << " ms" << '\n';
+            out << "    Weapon Type: " << static_cast<int>(wd.getWeaponType()) << '\n';
+            out << "    Durability: " << wd.getDurability() << '\n';
+            out << "    Stamina Cost: " << wd.getStaminaCost() << '\n';
+        } else if (item->getType() == ARMOR) {
+            const ArmorData& ad = item->getArmorData();
+            out << "  Armor Data:" << '\n';
+            out << "    Armor Value: " << ad.getArmorValue() << '\n';
+            out << "    Durability: " << ad.getDurability() << '\n';
+        } else if (item->getType() == POTION) {
+            const PotionData& pd = item->getPotionData();
+            out << "  Potion Data:" << '\n';
+            out << "    Potion Type: " << static_cast<int>(pd.getPotionType()) << '\n';
+            out << "    Min Potency: " << pd.getMinPotency() << '\n';
+            out << "    Max Potency: " << pd.getMaxPotency() << '\n';
+        } else if (item->getType() == CURRENCY) {
+            out << "  Currency Data:" << '\n';
+            out << "    Gold Value: " << item->getValue() << '\n';
+        }
+        out << "--------------------------" << '\n';
+    }
+}
@@ -0,0 +1,188 @@
+//
+// Created by Connor on 19/10/2026.
+//
+
+#ifndef TERMINAL_RPG_GAMESESSION_HPP
+#define TERMINAL_RPG_GAMESESSION_HPP
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "../enemies/encounter.hpp"
+#include "../enemies/enemy.hpp"
+#include "../items/item.hpp"
+#include "../merchants/merchant.hpp"
+#include "../metrics/latencyhistogram.hpp"
+#include "../player/player.hpp"
+#include "../text/textbuffer.hpp"
+#include "realtimecombat.hpp"
+
+// Every point where the game waits on the player. A session is always parked in exactly one
+// of these between calls to handleInput().
+enum class SessionState {
+    AWAITING_NAME,
+    AWAITING_CONTINUE,
+    COMBAT_ACTION,
+    COMBAT_TARGET_CHOICE,
+    COMBAT_ITEM_CHOICE,
+    COMBAT_EQUIP_CHOICE,
+    COMBAT_PAUSE,
+    COMBAT_REALTIME,
+    CHEST_PROMPT,
+    MERCHANT_MENU,
+    MERCHANT_BUY,
+    MERCHANT_SELL,
+    FINISHED
+};
+
+// One player's game, written as a stackless state machine: instead of blocking on std::cin,
+// each prompt parks the session in a SessionState and returns. The next line of input resumes
+// it from there. Output is buffered per session so the owner decides where frames go.
+class GameSession {
+public:
+    explicit GameSession(unsigned int seed);
+    ~GameSession();
+
+    GameSession(const GameSession&) = delete;
+    GameSession& operator=(const GameSession&) = delete;
+
+    // Writes the banner and the first prompt
+    void start();
+
+    // Consumes one line of input and runs until the next prompt or the end of the game
+    void handleInput(const std::string& line);
+
+    // Fights run in real time instead of turns when enabled (before combat starts)
+    void setRealTimeCombat(bool enabled);
+    // While a real-time fight is on, the owner must call update() with the real time that
+    // has passed, at whatever rate it renders; input can arrive between updates at any time
+    bool needsUpdates() const;
+    void update(std::chrono::nanoseconds elapsed);
+
+    SessionState getState() const;
+    bool isFinished() const;
+
+    // Returns and clears the output produced since the last call
+    std::string takeOutput();
+    // Same, into frame; a frame string that's reused stops allocating once it's big enough
+    void takeOutput(std::string& frame);
+
+    // If the last input was a timed player command, returns true once and sets command
+    bool takeCompletedCommand(PlayerCommand& command);
+
+    // Called when the player enters 'l' at the continue prompt
+    void setDebugReportHandler(std::function<void(std::ostream&)> handler);
+
+    // nullptr until the player has entered their name
+    const Player* getPlayer() const;
+
+private:
+    // Combat can be entered from a random event or from a chest trap; the chest case still has
+    // to hand over its item once the fight is over
+    enum class CombatReturn { CONTINUE_PROMPT, CHEST_LOOT };
+
+    TextBuffer out;  // Reused for every frame
+    std::mt19937 rng;
+    SessionState state;
+    std::unique_ptr<Player> player;
+    std::function<void(std::ostream&)> debugReportHandler;
+
+    bool hasCompletedCommand;
+    PlayerCommand completedCommand;
+
+    // Combat state
+    Encounter encounter;  // Cleared and refilled for each fight, so a spawn reuses its storage
+    size_t combatTarget;  // Position in the encounter the next attack hits
+    int pendingAttack;    // Combat choice waiting on a target
+    std::vector<DefeatedEnemy> defeatedEnemies;
+    CombatReturn combatReturn;
+    std::vector<Item*> usableItems;
+    std::vector<Item*> availableGear;
+
+    // Chest state carried across a trap fight
+    Item* pendingChestItem;
+
+    // Merchants keep their stock between visits; created on the first visit
+    std::unique_ptr<MerchantRoster> merchants;
+    Merchant* merchant;
+    uint64_t eventCount;  // Random events so far, the clock merchants restock by
+
+    // Real-time combat, only set while a real-time fight is on
+    bool realTimeEnabled;
+    std::unique_ptr<RealTimeCombat> realTimeCombat;
+    std::vector<RealTimeEvent> realTimeEvents;
+
+    void markCommand(PlayerCommand command);
+    int randomInt(int min, int max);
+
+    void handleName(const std::string& line);
+    void handleContinue(const std::string& line);
+    void promptContinue();
+
+    void triggerRandomEvent();
+    // Announces a random enemy near the player's level; nullptr if none could be found
+    const EnemyTemplate* spawnEnemy();
+    // Fills the encounter with count copies of a freshly spawned enemy; false if nothing spawned
+    bool spawnEncounter(int count, EnemyAI ai);
+
+    // Starts a fight against the enemies spawnEncounter put in the encounter
+    void startCombat(CombatReturn returnTo);
+    void promptCombatAction();
+    void handleCombatAction(const std::string& line);
+    void promptCombatTarget();
+    void handleCombatTarget(const std::string& line);
+    unsigned int powerAttackStamina() const;
+    void runAttack(int combatChoice);
+    void handleCombatItemChoice(const std::string& line);
+    void handleCombatEquipChoice(const std::string& line);
+    void handleCombatPause(const std::string& line);
+    void playerAttack();
+    void playerPowerAttack();
+    void playerStrike(bool power);  // Both attacks, through the damage pipeline
+    void resolveCombatTurn(bool playerActed, bool playerDefending);
+    void printEnemyTurn(const EncounterAttack& attack, bool playerDefending);
+    // "The Goblin flees!" alone, "One of the enemies flees!" / "3 of the enemies flee!" in packs
+    void describeEnemies(int count, const char* singular, const char* plural);
+    void winCombat();
+    void loseCombat();
+    void tickStatusEffects();
+    void printStatusEffects(const StatusEffects& effects);
+    void endCombat();
+    void rewardDefeatedEnemies();
+    void awardEnemyDrops(const DefeatedEnemy& defeated);
+
+    void startRealTimeCombat();
+    void handleRealTimeAction(const std::string& line);
+    void renderRealTimeCombat();
+    void printRealTimeStatus();
+
+    bool promptEquipGear();  // Returns false if there is nothing to equip
+    bool equipChosenGear(int choice);
+
+    void spawnChest();
+    void handleChestChoice(const std::string& line);
+    void awardChestItem(Item* item);
+
+    void spawnMerchant();
+    void promptMerchantMenu();
+    void handleMerchantMenu(const std::string& line);
+    void handleMerchantBuy(const std::string& line);
+    void handleMerchantSell(const std::string& line);
+    void leaveMerchant();
+
+    void printCharacterInformation();
+    void printInventory(const std::vector<Item*>& inventory);
+};
+
+// Parses a whole-number answer the way `std::cin >> int` would, ignoring trailing text
+bool parseIntInput(const std::string& line, int& value);
+
+// Returns the first non-whitespace character of the line, or '\0' if there is none
+char firstCharInput(const std::string& line);
+
+#endif  // TERMINAL_RPG_GAMESESSION_HPP
@@ -0,0 +1,247 @@
+//
+// Created by Connor on 19/10/2026.
+//
+
+#include "realtimecombat.hpp"
+
+#include "../combat/damagepipeline.hpp"
+#include "../combat/effectiveness.hpp"
+
+namespace {
+constexpr uint64_t TICK_MS = RealTimeCombat::TICK.count();
+
+uint64_t toMs(std::chrono::milliseconds duration) {
+    return static_cast<uint64_t>(duration.count());
+}
+
+// The same stamina costs as turn-based combat
+constexpr unsigned int ATTACK_STAMINA = 5;
+constexpr unsigned int UNARMED_POWER_STAMINA = 15;
+
+void setOnCooldown(Item& weapon, bool onCooldown) {
+    WeaponData weaponData = weapon.getWeaponData();
+    weaponData.setOnCooldown(onCooldown);
+    weapon.setWeaponData(weaponData);
+}
+}  // namespace
+
+RealTimeCombat::RealTimeCombat(Player& player, Encounter& encounter, std::mt19937& rng)
+    : player(player),
+      encounter(encounter),
+      rng(rng),
+      accumulator(0),
+      nowMs(0),
+      playerReadyAt(0),
+      enemyNextAttack(toMs(ENEMY_ATTACK_INTERVAL)),
+      nextTurn(toMs(TURN)),
+      blockingUntil(0),
+      queuedAction(RealTimeAction::NONE),
+      outcome(RealTimeOutcome::ONGOING) {}
+
+void RealTimeCombat::queueAction(RealTimeAction action) { queuedAction = action; }
+
+RealTimeAction RealTimeCombat::getQueuedAction() const { return queuedAction; }
+
+int RealTimeCombat::advance(std::chrono::nanoseconds elapsed) {
+    accumulator += elapsed;
+    int ticks = static_cast<int>(accumulator / TICK);
+    if (ticks > MAX_CATCH_UP_TICKS) {
+        ticks = MAX_CATCH_UP_TICKS;
+        accumulator = std::chrono::nanoseconds(0);
+    } else {
+        accumulator -= ticks * TICK;
+    }
+    runTicks(ticks);
+    return ticks;
+}
+
+void RealTimeCombat::runTicks(int ticks) {
+    for (int i = 0; i < ticks && outcome == RealTimeOutcome::ONGOING; ++i) step();
+}
+
+void RealTimeCombat::takeEvents(std::vector<RealTimeEvent>& taken) {
+    taken.clear();
+    taken.swap(events);
+}
+
+RealTimeOutcome RealTimeCombat::getOutcome() const { return outcome; }
+
+uint64_t RealTimeCombat::getTimeMs() const { return nowMs; }
+
+uint64_t RealTimeCombat::getPlayerReadyInMs() const {
+    return playerReadyAt > nowMs ? playerReadyAt - nowMs : 0;
+}
+
+void RealTimeCombat::step() {
+    nowMs += TICK_MS;
+
+    Item* weapon = player.getEquippedWeapon();
+    if (nowMs >= playerReadyAt && weapon && weapon->getWeaponData().isOnCooldown()) {
+        setOnCooldown(*weapon, false);
+    }
+
+    if (queuedAction != RealTimeAction::NONE && nowMs >= playerReadyAt) {
+        playerAct();
+        checkOutcome();
+        if (outcome != RealTimeOutcome::ONGOING) return;
+    }
+    if (nowMs >= enemyNextAttack) {
+        enemyAct();
+        enemyNextAttack += toMs(ENEMY_ATTACK_INTERVAL);
+        checkOutcome();
+        if (outcome != RealTimeOutcome::ONGOING) return;
+    }
+    if (nowMs >= nextTurn) {
+        endTurn();
+        nextTurn += toMs(TURN);
+        checkOutcome();
+    }
+}
+
+void RealTimeCombat::playerAct() {
+    RealTimeAction action = queuedAction;
+    queuedAction = RealTimeAction::NONE;
+
+    switch (action) {
+        case RealTimeAction::ATTACK:
+        case RealTimeAction::POWER_ATTACK: {
+            bool power = action == RealTimeAction::POWER_ATTACK;
+            Item* weapon = player.getEquippedWeapon();
+            bool armed = weapon && weapon->getType() == WEAPON;
+
+            unsigned int staminaNeeded = ATTACK_STAMINA;
+            if (power) {
+                staminaNeeded =
+                    armed ? weapon->getWeaponData().getStaminaCost() * 3 : UNARMED_POWER_STAMINA;
+            }
+            if (player.getStamina() < staminaNeeded) {
+                emit(RealTimeEventType::PLAYER_TOO_TIRED, static_cast<int>(staminaNeeded));
+                return;
+            }
+            player.useStamina(staminaNeeded);
+
+            // The cooldown starts from the swing, whatever happens to the weapon
+            uint64_t cooldown = armed ? static_cast<uint64_t>(weapon->getWeaponData().getCooldown())
+                                      : toMs(UNARMED_COOLDOWN);
+            if (power) cooldown *= 2;
+            playerReadyAt = nowMs + cooldown;
+            if (armed) setOnCooldown(*weapon, true);
+
+            playerStrike(power);
+            break;
+        }
+        case RealTimeAction::DEFEND:
+            // Blocks the enemy's next attack and gets some breath back
+            blockingUntil = nowMs + toMs(ENEMY_ATTACK_INTERVAL);
+            player.recoverStamina(
+                getStaminaRecovery(player.getMaxStamina(), DEFEND_STAMINA_RECOVERY));
+            playerReadyAt = nowMs + toMs(RECOVERY_TIME);
+            emit(RealTimeEventType::PLAYER_DEFENDING);
+            break;
+        case RealTimeAction::FLEE:
+            if (randomInt(1, 100) <= 20) {
+                outcome = RealTimeOutcome::FLED;
+                return;
+            }
+            playerReadyAt = nowMs + toMs(RECOVERY_TIME);
+            emit(RealTimeEventType::FLEE_FAILED);
+            break;
+        case RealTimeAction::NONE:
+            break;
+    }
+}
+
+void RealTimeCombat::playerStrike(bool power) {
+    Item* weapon = player.getEquippedWeapon();
+    bool armed = weapon && weapon->getType() == WEAPON;
+    size_t target = 0;
+    while (!encounter.isAlive(target)) ++target;
+
+    DamageContext strike = makeDamageContext(rng);
+    strike.power = power;
+    WeaponType weaponType = SWORD;  // Ignored when unarmed
+    if (armed) {
+        const WeaponData& weaponData = weapon->getWeaponData();
+        strike.armed = true;
+        strike.minDamage = weaponData.getMinDamage();
+        strike.maxDamage = weaponData.getMaxDamage();
+        strike.accuracy = weaponData.getAccuracy();
+        strike.durability = weaponData.getDurability();
+        weaponType = weaponData.getWeaponType();
+    }
+    strike.damageBonus = player.getStatusEffects().getModifier(StatusEffectType::DAMAGE_BOOST);
+    aimStrike(strike, weaponType, encounter.getType(target), encounter.getDefence(target),
+              encounter.getResistance(target));
+    getPlayerStrikePipeline().run(strike);
+
+    if (strike.missed) {
+        emit(RealTimeEventType::PLAYER_MISSED);
+        return;
+    }
+    if (armed && player.wearEquipped(EquipmentSlot::WEAPON, strike.wear)) {
+        emit(RealTimeEventType::WEAPON_BROKE);
+        player.breakEquipped(EquipmentSlot::WEAPON);
+    }
+
+    if (armed && getDamageChannel(weaponType) == DamageChannel::SPELL) {
+        encounter.takeSpellDamage(target, strike.damage);
+    } else {
+        encounter.loseHealth(target, strike.dealt);
+    }
+    emit(strike.critical ? RealTimeEventType::PLAYER_CRIT : RealTimeEventType::PLAYER_HIT,
+         strike.damage, target);
+}
+
+void RealTimeCombat::enemyAct() {
+    // The whole encounter acts together, each enemy as its AI and behaviour table decide
+    bool blocking = nowMs <= blockingUntil;
+    EncounterAttack attack = encounter.attack(player, rng, blocking);
+    if (attack.attackers > 0) {
+        emit(blocking ? RealTimeEventType::ENEMY_BLOCKED : RealTimeEventType::ENEMY_HIT,
+             attack.damage);
+    }
+    if (attack.casters > 0) emit(RealTimeEventType::ENEMY_SPELL, attack.spellDamage);
+    if (attack.healers > 0) emit(RealTimeEventType::ENEMY_HEALED, attack.healed);
+    if (attack.enraged > 0) emit(RealTimeEventType::ENEMY_ENRAGED, attack.enraged);
+    if (attack.fled > 0) emit(RealTimeEventType::ENEMY_FLED, attack.fled);
+    if (attack.armorBroke) {
+        emit(RealTimeEventType::ARMOR_BROKE);
+        player.breakEquipped(EquipmentSlot::ARMOR);
+    }
+    // A block only lasts for one attack
+    if (blocking && attack.attackers + attack.casters > 0) blockingUntil = 0;
+}
+
+void RealTimeCombat::endTurn() {
+    // Natural recovery, as in turn-based combat, except while blocking
+    if (nowMs > blockingUntil) {
+        player.recoverStamina(getStaminaRecovery(player.getMaxStamina(), TURN_STAMINA_RECOVERY));
+    }
+
+    int poisonDamage = encounter.tickEffects();
+    if (poisonDamage > 0) emit(RealTimeEventType::ENEMY_POISONED, poisonDamage);
+    StatusTick playerTick = player.getStatusEffects().tick();
+    if (playerTick.poisonDamage > 0) {
+        player.loseHealth(playerTick.poisonDamage);
+        emit(RealTimeEventType::PLAYER_POISONED, playerTick.poisonDamage);
+    }
+    if (playerTick.staminaRegen > 0) player.recoverStamina(playerTick.staminaRegen);
+}
+
+void RealTimeCombat::checkOutcome() {
+    if (outcome != RealTimeOutcome::ONGOING) return;
+    if (player.getHealth() <= 0) {
+        outcome = RealTimeOutcome::DEFEAT;
+    } else if (encounter.isDefeated()) {
+        outcome = RealTimeOutcome::VICTORY;
+    }
+}
+
+void RealTimeCombat::emit(RealTimeEventType type, int amount, size_t enemy) {
+    events.push_back({type, amount, nowMs, enemy});
+}
+
+int RealTimeCombat::randomInt(int min, int max) {
+    std::uniform_int_distribution<> distribution(min, max);
+    return distribution(rng);
+}
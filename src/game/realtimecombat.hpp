@@ -0,0 +1,108 @@
+//
+// Created by Connor on 19/10/2026.
+//
+
+#ifndef TERMINAL_RPG_REALTIMECOMBAT_HPP
+#define TERMINAL_RPG_REALTIMECOMBAT_HPP
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "../enemies/encounter.hpp"
+#include "../player/player.hpp"
+
+enum class RealTimeAction { NONE, ATTACK, POWER_ATTACK, DEFEND, FLEE };
+
+enum class RealTimeEventType {
+    PLAYER_HIT,        // amount: damage dealt, enemy: who was hit
+    PLAYER_CRIT,       // amount: damage dealt, enemy: who was hit
+    PLAYER_MISSED,
+    PLAYER_TOO_TIRED,  // amount: stamina needed
+    PLAYER_DEFENDING,
+    FLEE_FAILED,
+    WEAPON_BROKE,
+    ARMOR_BROKE,
+    ENEMY_HIT,         // amount: damage taken from every enemy that attacked
+    ENEMY_BLOCKED,     // amount: damage taken after blocking
+    ENEMY_SPELL,       // amount: spell damage taken
+    ENEMY_HEALED,      // amount: health the enemies got back
+    ENEMY_ENRAGED,     // amount: enemies that flew into a rage
+    ENEMY_FLED,        // amount: enemies that ran
+    ENEMY_POISONED,    // amount: poison damage dealt to the enemies
+    PLAYER_POISONED    // amount: poison damage taken
+};
+
+struct RealTimeEvent {
+    RealTimeEventType type;
+    int amount;
+    uint64_t timeMs;  // Simulation time it happened at
+    size_t enemy;     // Position in the encounter, for events aimed at one enemy
+};
+
+enum class RealTimeOutcome { ONGOING, VICTORY, DEFEAT, FLED };
+
+// A fight where both sides act on a shared simulation clock instead of taking turns. The clock
+// advances in fixed TICK steps no matter how often (or how late) the caller advances it, so
+// weapon cooldowns play out the same at any frame rate; the player's commands are queued and
+// run on the first tick the equipped weapon is ready, against the first enemy still standing.
+// Nothing here reads input or writes output, so tests can run a fight as fast as they like.
+// Dead enemies stay in the encounter until the owner removes them.
+class RealTimeCombat {
+public:
+    static constexpr std::chrono::milliseconds TICK{50};
+    // Real time beyond this many ticks in one advance() is dropped instead of simulated, so a
+    // stalled caller can't make the simulation spiral trying to catch up
+    static constexpr int MAX_CATCH_UP_TICKS = 10;
+    static constexpr std::chrono::milliseconds UNARMED_COOLDOWN{1000};
+    static constexpr std::chrono::milliseconds RECOVERY_TIME{1000};  // After defending/fleeing
+    static constexpr std::chrono::milliseconds ENEMY_ATTACK_INTERVAL{1500};
+    // Status effects, natural stamina regen and blocking work in turns of this length
+    static constexpr std::chrono::milliseconds TURN{1000};
+
+    RealTimeCombat(Player& player, Encounter& encounter, std::mt19937& rng);
+
+    // Replaces whatever action was waiting for the player's weapon
+    void queueAction(RealTimeAction action);
+    RealTimeAction getQueuedAction() const;
+
+    // Adds real time to the clock and runs every whole tick it covers; returns the ticks run
+    int advance(std::chrono::nanoseconds elapsed);
+    // Runs ticks directly (headless, as fast as the CPU allows)
+    void runTicks(int ticks);
+
+    // Hands over the events since the last call
+    void takeEvents(std::vector<RealTimeEvent>& taken);
+
+    RealTimeOutcome getOutcome() const;
+    uint64_t getTimeMs() const;
+    uint64_t getPlayerReadyInMs() const;  // 0 once the weapon is off cooldown
+
+private:
+    Player& player;
+    Encounter& encounter;
+    std::mt19937& rng;
+
+    std::chrono::nanoseconds accumulator;
+    uint64_t nowMs;
+    uint64_t playerReadyAt;
+    uint64_t enemyNextAttack;
+    uint64_t nextTurn;
+    uint64_t blockingUntil;
+    RealTimeAction queuedAction;
+    RealTimeOutcome outcome;
+    std::vector<RealTimeEvent> events;
+
+    void step();
+    void playerAct();
+    void playerStrike(bool power);
+    void enemyAct();
+    void endTurn();
+    void checkOutcome();
+    void emit(RealTimeEventType type, int amount = 0, size_t enemy = 0);
+    int randomInt(int min, int max);
+};
+
+#endif  // TERMINAL_RPG_REALTIMECOMBAT_HPP
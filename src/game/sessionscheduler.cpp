@@ -0,0 +1,77 @@
+//
+// Created by Connor on 19/10/2026.
+//
+
+#include "sessionscheduler.hpp"
+
+#include <chrono>
+
+SessionScheduler::SessionScheduler(FrameHandler frameHandler)
+    : frameHandler(std::move(frameHandler)), nextSessionId(1) {}
+
+SessionId SessionScheduler::openSession(unsigned int seed) {
+    SessionId id = nextSessionId++;
+    auto session = std::make_unique<GameSession>(seed);
+    session->setDebugReportHandler(
+        [this](std::ostream& out) { out << latencyTracker.formatReport(); });
+    session->start();
+
+    GameSession& started = *session;
+    sessions.emplace(id, std::move(session));
+    emitFrame(id, started);
+    return id;
+}
+
+void SessionScheduler::submitInput(SessionId id, std::string line) {
+    if (sessions.find(id) == sessions.end()) return;
+    pendingInput.emplace_back(id, std::move(line));
+}
+
+size_t SessionScheduler::runPending(size_t maxInputs) {
+    size_t handled = 0;
+    while (handled < maxInputs && !pendingInput.empty()) {
+        std::pair<SessionId, std::string> input = std::move(pendingInput.front());
+        pendingInput.pop_front();
+
+        auto it = sessions.find(input.first);
+        if (it == sessions.end()) continue;  // Closed while the input was queued
+        GameSession& session = *it->second;
+
+        auto start = std::chrono::steady_clock::now();
+        session.handleInput(input.second);
+        emitFrame(input.first, session);
+
+        PlayerCommand command;
+        if (session.takeCompletedCommand(command)) {
+            auto elapsed = std::chrono::steady_clock::now() - start;
+            latencyTracker.record(
+                command, std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+        }
+        ++handled;
+
+        if (session.isFinished()) {
+            sessions.erase(it);
+        }
+    }
+    return handled;
+}
+
+void SessionScheduler::closeSession(SessionId id) { sessions.erase(id); }
+
+bool SessionScheduler::hasPendingInput() const { return !pendingInput.empty(); }
+
+size_t SessionScheduler::getSessionCount() const { return sessions.size(); }
+
+GameSession* SessionScheduler::getSession(SessionId id) {
+    auto it = sessions.find(id);
+    return it != sessions.end() ? it->second.get() : nullptr;
+}
+
+const CommandLatencyTracker& SessionScheduler::getLatencyTracker() const {
+    return latencyTracker;
+}
+
+void SessionScheduler::emitFrame(SessionId id, GameSession& session) {
+    session.takeOutput(frame);
+    if (frameHandler) frameHandler(id, frame, session.isFinished());
+}
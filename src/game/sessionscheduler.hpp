@@ -0,0 +1,61 @@
+//
+// Created by Connor on 19/10/2026.
+//
+
+#ifndef TERMINAL_RPG_SESSIONSCHEDULER_HPP
+#define TERMINAL_RPG_SESSIONSCHEDULER_HPP
+
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+#include "../metrics/latencyhistogram.hpp"
+#include "gamesession.hpp"
+
+using SessionId = uint64_t;
+
+// Runs any number of GameSessions on the calling thread. Input lines are queued per session and
+// drained in FIFO order; because a session never blocks, one thread can keep thousands of
+// players moving. Not thread-safe: each scheduler belongs to a single thread.
+class SessionScheduler {
+public:
+    // Receives every frame a session produces; finished is true for the session's last frame
+    using FrameHandler =
+        std::function<void(SessionId id, const std::string& frame, bool finished)>;
+
+    explicit SessionScheduler(FrameHandler frameHandler);
+
+    // Creates and starts a session, emitting its opening frame
+    SessionId openSession(unsigned int seed);
+
+    // Queues a line of input; ignored if the session does not exist
+    void submitInput(SessionId id, std::string line);
+
+    // Handles up to maxInputs queued lines, returns how many were handled
+    size_t runPending(size_t maxInputs = SIZE_MAX);
+
+    // Drops a session (e.g. the client disconnected) along with any queued input
+    void closeSession(SessionId id);
+
+    bool hasPendingInput() const;
+    size_t getSessionCount() const;
+    GameSession* getSession(SessionId id);
+
+    // Latency of each timed command, input dequeued to frame handed off
+    const CommandLatencyTracker& getLatencyTracker() const;
+
+private:
+    FrameHandler frameHandler;
+    SessionId nextSessionId;
+    std::unordered_map<SessionId, std::unique_ptr<GameSession>> sessions;
+    std::deque<std::pair<SessionId, std::string>> pendingInput;
+    CommandLatencyTracker latencyTracker;
+    std::string frame;  // Every frame passes through here, so its capacity is reused
+
+    void emitFrame(SessionId id, GameSession& session);
+};
+
+#endif  // TERMINAL_RPG_SESSIONSCHEDULER_HPP
@@ -1,5 +1,7 @@
 #include "item.hpp"
 
+#include "itempool.hpp"
+
 // WeaponData implementations
 WeaponData::WeaponData()
     : minDamage(0),
@@ -69,18 +71,23 @@ void PotionData::setMaxPotency(int maxPotency) { this->maxPotency = maxPotency;
 // Item implementations
 Item::Item()
     : id(0),
-      name(""),
-      description(""),
+      name(),
+      description(),
       value(0),
       weight(0),
       type(MISC),
       rarity(COMMON),
-      equipped(false) {
+      equipped(false),
+      quantity(1) {
     // Data members are automatically initialized with their default constructors
 }
 
 Item::Item(int id, const std::string& name, const std::string& description, int value, int weight,
            ItemType type, Rarity rarity)
+    : Item(id, InternedString(name), InternedString(description), value, weight, type, rarity) {}
+
+Item::Item(int id, InternedString name, InternedString description, int value, int weight,
+           ItemType type, Rarity rarity)
     : id(id),
       name(name),
       description(description),
@@ -88,32 +95,48 @@ Item::Item(int id, const std::string& name, const std::string& description, int
       weight(weight),
       type(type),
       rarity(rarity),
-      equipped(false) {
+      equipped(false),
+      quantity(1) {
     // Data members are automatically initialized with their default constructors
 }
 
 int Item::getId() const { return id; }
-const std::string& Item::getName() const { return name; }
-const std::string& Item::getDescription() const { return description; }
+std::string_view Item::getName() const { return name.view(); }
+std::string_view Item::getDescription() const { return description.view(); }
 int Item::getValue() const { return value; }
 int Item::getWeight() const { return weight; }
 ItemType Item::getType() const { return type; }
 Rarity Item::getRarity() const { return rarity; }
 bool Item::isEquipped() const { return equipped; }
+int Item::getQuantity() const { return quantity; }
+
+bool Item::isStackable() const { return type == POTION || type == CURRENCY || type == MISC; }
+
+bool Item::stacksWith(const Item& other) const {
+    return isStackable() && type == other.type && name == other.name;
+}
+
+int Item::getStackWeight() const { return weight * quantity; }
 
 const WeaponData& Item::getWeaponData() const { return weaponData; }
 const ArmorData& Item::getArmorData() const { return armorData; }
 const PotionData& Item::getPotionData() const { return potionData; }
 
 void Item::setId(int id) { this->id = id; }
-void Item::setName(const std::string& name) { this->name = name; }
-void Item::setDescription(const std::string& description) { this->description = description; }
+void Item::setName(std::string_view name) { this->name = InternedString(name); }
+void Item::setDescription(std::string_view description) {
+    this->description = InternedString(description);
+}
 void Item::setValue(int value) { this->value = value; }
 void Item::setWeight(int weight) { this->weight = weight; }
 void Item::setType(ItemType type) { this->type = type; }
 void Item::setRarity(Rarity rarity) { this->rarity = rarity; }
 void Item::setEquipped(bool equipped) { this->equipped = equipped; }
+void Item::setQuantity(int quantity) { this->quantity = quantity; }
 
 void Item::setWeaponData(const WeaponData& weaponData) { this->weaponData = weaponData; }
 void Item::setArmorData(const ArmorData& armorData) { this->armorData = armorData; }
 void Item::setPotionData(const PotionData& potionData) { this->potionData = potionData; }
+
+void* Item::operator new(size_t size) { return ItemPool::allocate(size); }
+void Item::operator delete(void* block, size_t size) noexcept { ItemPool::release(block, size); }
@@ -4,7 +4,11 @@
 
 #ifndef TERMINAL_RPG_ITEM_H
 #define TERMINAL_RPG_ITEM_H
+#include <cstddef>
 #include <string>
+#include <string_view>
+
+#include "../text/stringtable.hpp"
 
 class Item;
 
@@ -119,16 +123,26 @@ class Item {
 public:
     Item();
     Item(int id, const std::string& name, const std::string& description, int value, int weight, ItemType type, Rarity rarity);
+    // From already-interned text (templates), without touching the string table
+    Item(int id, InternedString name, InternedString description, int value, int weight,
+         ItemType type, Rarity rarity);
 
     // Getters
     int getId() const;
-    const std::string& getName() const;
-    const std::string& getDescription() const;
+    std::string_view getName() const;
+    std::string_view getDescription() const;
     int getValue() const;
     int getWeight() const;
     ItemType getType() const;
     Rarity getRarity() const;
     bool isEquipped() const;
+    int getQuantity() const;
+
+    // Potions and misc items carry a count instead of one Item per unit; weapons and armor wear
+    // down individually so they never stack
+    bool isStackable() const;
+    bool stacksWith(const Item& other) const;
+    int getStackWeight() const;  // quantity * unit weight
 
     // Data getters (for specific item types)
     const WeaponData& getWeaponData() const;
@@ -137,28 +151,34 @@ public:
 
     // Setters
     void setId(int id);
-    void setName(const std::string& name);
-    void setDescription(const std::string& description);
+    void setName(std::string_view name);
+    void setDescription(std::string_view description);
     void setValue(int value);
     void setWeight(int weight);
     void setType(ItemType type);
     void setRarity(Rarity rarity);
     void setEquipped(bool equipped);
+    void setQuantity(int quantity);
 
     // Data setters (for specific item types)
     void setWeaponData(const WeaponData& weaponData);
     void setArmorData(const ArmorData& armorData);
     void setPotionData(const PotionData& potionData);
 
+    // Items are allocated from ItemPool
+    static void* operator new(size_t size);
+    static void operator delete(void* block, size_t size) noexcept;
+
 private:
     int id;
-    std::string name;
-    std::string description;
+    InternedString name;
+    InternedString description;
     int value;
     int weight;
     ItemType type;
     Rarity rarity;
     bool equipped;
+    int quantity;
 
     // Replace union with individual data members
     WeaponData weaponData;
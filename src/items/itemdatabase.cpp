@@ -4,15 +4,33 @@
 
 #include "itemdatabase.hpp"
 
+namespace {
+
+// Every item the create* helpers below define. Adding an item here as well as there keeps its
+// lookup on the perfect hash; one that's missed still works, through the fallback table.
+constexpr std::array<std::string_view, ItemDatabase::BUILTIN_ITEM_COUNT> BUILTIN_ITEM_NAMES = {
+    "Iron Sword", "Steel Sword", "Mystic Blade", "Wooden Bow", "Longbow", "Rusty Dagger",
+    "Poison Dagger", "Battle Axe", "Wizard Staff", "Leather Armor", "Chain Mail", "Steel Armor",
+    "Dragon Scale Armor", "Mage Robes", "Minor Healing Potion", "Healing Potion",
+    "Major Healing Potion", "Stamina Potion", "Strength Potion", "Defense Potion", "Poison Vial",
+    "Gold Coin", "Silver Coin", "Gold Pouch", "Treasure Chest", "Precious Gem", "Bread", "Torch",
+    "Ancient Key", "Dragon Egg"};
+
+constexpr PerfectNameHash<ItemDatabase::BUILTIN_ITEM_COUNT> BUILTIN_ITEM_HASH(BUILTIN_ITEM_NAMES);
+static_assert(BUILTIN_ITEM_HASH.isPerfect(), "built-in item names must be unique and non-empty");
+
+}  // namespace
+
 // ItemTemplate constructor
 ItemTemplate::ItemTemplate(const std::string& name, const std::string& description, int value,
                            int weight, ItemType type, Rarity rarity)
-    : name(name),
-      description(description),
+    : name(InternedString(name)),
+      description(InternedString(description)),
       value(value),
       weight(weight),
       type(type),
-      rarity(rarity) {}
+      rarity(rarity),
+      index(0) {}
 
 // ItemDatabase implementation
 ItemDatabase& ItemDatabase::getInstance() {
@@ -27,9 +45,12 @@ void ItemDatabase::initialize() {
     createMiscItems();
 }
 
-const ItemTemplate* ItemDatabase::getItemTemplate(const std::string& itemName) const {
-    auto it = itemTemplates.find(itemName);
-    return (it != itemTemplates.end()) ? it->second.get() : nullptr;
+const ItemTemplate* ItemDatabase::getItemTemplate(std::string_view itemName) const {
+    int builtin = BUILTIN_ITEM_HASH.find(itemName);
+    if (builtin >= 0 && builtinTemplates[builtin]) {
+        return builtinTemplates[builtin];
+    }
+    return otherTemplates.find(itemName);
 }
 
 Item* ItemDatabase::createItem(const std::string& itemName, int inventorySlotId) const {
@@ -37,6 +58,11 @@ Item* ItemDatabase::createItem(const std::string& itemName, int inventorySlotId)
     if (!template_ptr) {
         return nullptr;
     }
+    return createItem(*template_ptr, inventorySlotId);
+}
+
+Item* ItemDatabase::createItem(const ItemTemplate& itemTemplate, int inventorySlotId) const {
+    const ItemTemplate* template_ptr = &itemTemplate;
 
     // Create new item with the inventory slot ID
     Item* item = new Item(inventorySlotId, template_ptr->name, template_ptr->description,
@@ -68,7 +94,7 @@ Item* ItemDatabase::createItem(const std::string& itemName, int inventorySlotId)
 std::vector<std::string> ItemDatabase::getAllItemNames() const {
     std::vector<std::string> names;
     for (const auto& pair : itemTemplates) {
-        names.push_back(pair.first);
+        names.emplace_back(pair.first);
     }
     return names;
 }
@@ -77,7 +103,7 @@ std::vector<std::string> ItemDatabase::getItemsByType(ItemType type) const {
     std::vector<std::string> names;
     for (const auto& pair : itemTemplates) {
         if (pair.second->type == type) {
-            names.push_back(pair.first);
+            names.emplace_back(pair.first);
         }
     }
     return names;
@@ -87,14 +113,36 @@ std::vector<std::string> ItemDatabase::getItemsByRarity(Rarity rarity) const {
     std::vector<std::string> names;
     for (const auto& pair : itemTemplates) {
         if (pair.second->rarity == rarity) {
-            names.push_back(pair.first);
+            names.emplace_back(pair.first);
         }
     }
     return names;
 }
 
+size_t ItemDatabase::getTemplateCount() const { return templatesByIndex.size(); }
+
+const ItemTemplate* ItemDatabase::getTemplateByIndex(size_t index) const {
+    return index < templatesByIndex.size() ? templatesByIndex[index] : nullptr;
+}
+
 void ItemDatabase::addItemTemplate(std::unique_ptr<ItemTemplate> itemTemplate) {
-    itemTemplates[itemTemplate->name] = std::move(itemTemplate);
+    // Update in place when re-initializing, so template pointers held elsewhere stay valid
+    auto it = itemTemplates.find(itemTemplate->name.view());
+    if (it != itemTemplates.end()) {
+        itemTemplate->index = it->second->index;
+        *it->second = std::move(*itemTemplate);
+        return;
+    }
+    itemTemplate->index = templatesByIndex.size();
+    templatesByIndex.push_back(itemTemplate.get());
+    int builtin = BUILTIN_ITEM_HASH.find(itemTemplate->name.view());
+    if (builtin >= 0) {
+        builtinTemplates[builtin] = itemTemplate.get();
+    } else {
+        otherTemplates.insert(itemTemplate->name.view(), itemTemplate.get());
+    }
+    std::string_view name = itemTemplate->name.view();
+    itemTemplates[name] = std::move(itemTemplate);
 }
 
 void ItemDatabase::createWeapons() {
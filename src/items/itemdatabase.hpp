@@ -5,19 +5,23 @@
 #ifndef TERMINAL_RPG_ITEMDATABASE_HPP
 #define TERMINAL_RPG_ITEMDATABASE_HPP
 
+#include <array>
 #include <vector>
 #include <memory>
 #include <map>
 #include <string>
+#include <string_view>
 #include "item.hpp"
+#include "../text/namelookup.hpp"
 
 struct ItemTemplate {
-    std::string name;
-    std::string description;
+    InternedString name;
+    InternedString description;
     int value;
     int weight;
     ItemType type;
     Rarity rarity;
+    size_t index;  // Dense, in the order templates were added (for per-template arrays)
 
     // Type data
     WeaponData weaponData;
@@ -30,30 +34,47 @@ struct ItemTemplate {
 
 class ItemDatabase {
 public:
+    // Number of items on the compile-time name list
+    static constexpr size_t BUILTIN_ITEM_COUNT = 30;
+
     static ItemDatabase& getInstance();
 
     // Initialize the database with all predefined items
     void initialize();
 
-    // Get item template by name (returns nullptr if not found)
-    const ItemTemplate* getItemTemplate(const std::string& itemName) const;
+    // Get item template by name (returns nullptr if not found). Built-in names go through a
+    // perfect hash made at compile time; anything else through a hash table.
+    const ItemTemplate* getItemTemplate(std::string_view itemName) const;
 
     // Create a new Item instance from template (with unique inventory ID)
     Item* createItem(const std::string& itemName, int inventorySlotId) const;
 
+    // Same, for callers that already hold the template (skips the name lookup)
+    Item* createItem(const ItemTemplate& itemTemplate, int inventorySlotId) const;
+
     std::vector<std::string> getAllItemNames() const;
 
     std::vector<std::string> getItemsByType(ItemType type) const;
 
     std::vector<std::string> getItemsByRarity(Rarity rarity) const;
 
+    size_t getTemplateCount() const;
+    const ItemTemplate* getTemplateByIndex(size_t index) const;
+
 private:
     ItemDatabase() = default;
     ~ItemDatabase() = default;
     ItemDatabase(const ItemDatabase&) = delete;
     ItemDatabase& operator=(const ItemDatabase&) = delete;
 
-    std::map<std::string, std::unique_ptr<ItemTemplate>> itemTemplates;
+    // Keyed by views of the templates' interned names, so no name is held twice; ordered by name
+    std::map<std::string_view, std::unique_ptr<ItemTemplate>> itemTemplates;
+    std::vector<ItemTemplate*> templatesByIndex;
+
+    // Name lookup. Built-in items sit at their position in the compile-time name list
+    // (itemdatabase.cpp); items not on that list go in otherTemplates.
+    std::array<ItemTemplate*, BUILTIN_ITEM_COUNT> builtinTemplates{};
+    NameTable<ItemTemplate> otherTemplates;
 
     // Helper methods to create specific item types
     void createWeapons();
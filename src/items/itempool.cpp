@@ -0,0 +1,111 @@
+//
+// Created by Connor on 19/10/2026.
+//
+
+#include "itempool.hpp"
+
+#include <mutex>
+#include <new>
+#include <vector>
+
+#include "item.hpp"
+
+namespace {
+struct FreeBlock {
+    FreeBlock* next;
+};
+
+constexpr size_t BLOCK_ALIGNMENT = alignof(std::max_align_t);
+constexpr size_t BLOCK_SIZE =
+    (sizeof(Item) + BLOCK_ALIGNMENT - 1) / BLOCK_ALIGNMENT * BLOCK_ALIGNMENT;
+
+struct SharedPool {
+    std::mutex mutex;
+    std::vector<void*> chunks;
+    FreeBlock* orphans = nullptr;  // Blocks left behind by threads that have exited
+    size_t reserved = 0;
+};
+
+// Never destroyed, so items deleted during static destruction still have somewhere to go
+SharedPool& sharedPool() {
+    static SharedPool* pool = new SharedPool();
+    return *pool;
+}
+
+thread_local FreeBlock* freeList = nullptr;
+thread_local bool threadExited = false;
+
+void giveToOrphans(FreeBlock* first, FreeBlock* last) {
+    SharedPool& pool = sharedPool();
+    std::lock_guard<std::mutex> lock(pool.mutex);
+    last->next = pool.orphans;
+    pool.orphans = first;
+}
+
+// Hands the thread's free blocks back when it exits
+struct ThreadFlush {
+    ~ThreadFlush() {
+        threadExited = true;
+        if (!freeList) return;
+        FreeBlock* last = freeList;
+        while (last->next) last = last->next;
+        giveToOrphans(freeList, last);
+        freeList = nullptr;
+    }
+};
+thread_local ThreadFlush threadFlush;
+
+void refill() {
+    SharedPool& pool = sharedPool();
+    std::lock_guard<std::mutex> lock(pool.mutex);
+    if (pool.orphans) {
+        freeList = pool.orphans;
+        pool.orphans = nullptr;
+        return;
+    }
+
+    auto* chunk =
+        static_cast<unsigned char*>(::operator new(BLOCK_SIZE * ItemPool::BLOCKS_PER_CHUNK));
+    pool.chunks.push_back(chunk);
+    pool.reserved += ItemPool::BLOCKS_PER_CHUNK;
+    for (size_t i = ItemPool::BLOCKS_PER_CHUNK; i-- > 0;) {
+        auto* block = reinterpret_cast<FreeBlock*>(chunk + i * BLOCK_SIZE);
+        block->next = freeList;
+        freeList = block;
+    }
+}
+}  // namespace
+
+void* ItemPool::allocate(size_t size) {
+    if (size > BLOCK_SIZE) return ::operator new(size);
+    (void)&threadFlush;  // Make sure this thread's flush is registered
+    if (!freeList) refill();
+    FreeBlock* block = freeList;
+    freeList = block->next;
+    return block;
+}
+
+void ItemPool::release(void* block, size_t size) noexcept {
+    if (!block) return;
+    if (size > BLOCK_SIZE) {
+        ::operator delete(block);
+        return;
+    }
+    auto* freed = static_cast<FreeBlock*>(block);
+    if (threadExited) {
+        freed->next = nullptr;
+        giveToOrphans(freed, freed);
+        return;
+    }
+    (void)&threadFlush;
+    freed->next = freeList;
+    freeList = freed;
+}
+
+size_t ItemPool::getBlockSize() { return BLOCK_SIZE; }
+
+size_t ItemPool::getReservedCount() {
+    SharedPool& pool = sharedPool();
+    std::lock_guard<std::mutex> lock(pool.mutex);
+    return pool.reserved;
+}
@@ -0,0 +1,27 @@
+//
+// Created by Connor on 19/10/2026.
+//
+
+#ifndef TERMINAL_RPG_ITEMPOOL_HPP
+#define TERMINAL_RPG_ITEMPOOL_HPP
+
+#include <cstddef>
+
+// Fixed-size block allocator behind Item's operator new/delete, so creating and deleting
+// items (drops, chest loot, merchant stock) doesn't go to the general heap every time.
+// Each thread keeps its own free list; blocks come from chunks that live as long as the
+// program, and a block freed on another thread just joins that thread's list.
+class ItemPool {
+public:
+    static constexpr size_t BLOCKS_PER_CHUNK = 256;
+
+    static void* allocate(size_t size);
+    // `size` must match the allocation (anything bigger than a block goes to the heap)
+    static void release(void* block, size_t size) noexcept;
+
+    static size_t getBlockSize();
+    // Blocks reserved across all threads, whether in use or free
+    static size_t getReservedCount();
+};
+
+#endif  // TERMINAL_RPG_ITEMPOOL_HPP
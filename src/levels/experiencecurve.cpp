@@ -0,0 +1,200 @@
+//
+// Created by Connor on 19/10/2026.
+//
+
+#include "experiencecurve.hpp"
+
+#include <array>
+
+namespace {
+// Just enough of a 256-bit unsigned integer to compare fifth powers exactly. Limbs are 32 bits,
+// least significant first, so every partial product fits in a uint64_t.
+struct Wide {
+    static constexpr int LIMBS = 8;
+    uint32_t limbs[LIMBS];
+    int size;  // Limbs in use; the ones above are zero
+};
+
+Wide widen(uint64_t value) {
+    Wide wide{};
+    wide.limbs[0] = static_cast<uint32_t>(value);
+    wide.limbs[1] = static_cast<uint32_t>(value >> 32);
+    wide.size = wide.limbs[1] ? 2 : 1;
+    return wide;
+}
+
+// Only the limbs in use are multiplied, which roughly halves the work for the small powers
+Wide multiply(const Wide& a, uint64_t factor) {
+    Wide product{};
+    const uint32_t halves[2] = {static_cast<uint32_t>(factor),
+                                static_cast<uint32_t>(factor >> 32)};
+    int terms = halves[1] ? 2 : 1;
+    for (int j = 0; j < terms; ++j) {
+        uint64_t carry = 0;
+        int i = 0;
+        for (; i < a.size && i + j < Wide::LIMBS; ++i) {
+            uint64_t sum = static_cast<uint64_t>(a.limbs[i]) * halves[j] + product.limbs[i + j] +
+                           carry;
+            product.limbs[i + j] = static_cast<uint32_t>(sum);
+            carry = sum >> 32;
+        }
+        if (i + j < Wide::LIMBS) product.limbs[i + j] = static_cast<uint32_t>(carry);
+    }
+    int size = a.size + terms < Wide::LIMBS ? a.size + terms : Wide::LIMBS;
+    while (size > 1 && product.limbs[size - 1] == 0) --size;
+    product.size = size;
+    return product;
+}
+
+bool atMost(const Wide& a, const Wide& b) {
+    if (a.size != b.size) return a.size < b.size;
+    for (int i = a.size - 1; i >= 0; --i) {
+        if (a.limbs[i] != b.limbs[i]) return a.limbs[i] < b.limbs[i];
+    }
+    return true;
+}
+
+bool fifthPowerAtMost(uint64_t root, const Wide& target) {
+    Wide power = widen(root);
+    for (int i = 0; i < 4; ++i) power = multiply(power, root);
+    return atMost(power, target);
+}
+
+// Running totals of curvePower at every CURVE_CHECKPOINT_SPACING levels, worked out once with
+// the exact roots below. A test walks every level and checks each one.
+constexpr std::array<uint64_t, 246> CHECKPOINTS = {
+    0ull, 465155592806ull, 3238978214248ull, 10079495945000ull,
+    22555627189700ull, 42130394183351ull, 70193688429264ull, 108080050873963ull,
+    157079800613717ull, 218446626670975ull, 293403078853284ull, 383144711884493ull,
+    488843316458194ull, 611649503901990ull, 752694817248450ull, 913093485449889ull,
+    1093943902350533ull, 1296329889133805ull, 1521321783530039ull, 1769977388368664ull,
+    2043342804454158ull, 2342453167224414ull, 2668333302564405ull, 3021998314076471ull,
+    3404454111761347ull, 3816697890247489ull, 4259718563285034ull, 4734497160092259ull,
+    5242007188241542ull, 5783214967043678ull, 6359079934795833ull, 6970554932772486ull,
+    7618586468435433ull, 8304114960003933ull, 9028074964246413ull, 9791395389117102ull,
+    10594999692662089ull, 11439806069447612ull, 12326727625618142ull, 13256672543565560ull,
+    14230544237083264ull, 15249241497784375ull, 16313658633481822ull, 17424685599156690ull,
+    18583208121078622ull, 19790107814586929ull, 21046262295993090ull, 22352545289021816ull,
+    23709826726169774ull, 25118972845327920ull, 26580846281982620ull, 28096306157283527ull,
+    29666208162242784ull, 31291404638307936ull, 32972744654530899ull, 34711074081538797ull,
+    36507235662495556ull, 38362069081229396ull, 40276411027687622ull, 42251095260868707ull,
+    44286952669370857ull, 46384811329685777ull, 48545496562358161ull, 50769830986122289ull,
+    53058634570120396ull, 55412724684299945ull, 57832916148080805ull, 60320021277377098ull,
+    62874849930054000ull, 65498209549893680ull, 68190905209140494ull, 70953739649691571ull,
+    73787513322994059ull, 76693024428708036ull, 79671068952189108ull, 82722440700842933ull,
+    85847931339399976ull, 89048330424157058ull, 92324425436228582ull, 95677001813848883ull,
+    99106842983764291ull, 102614730391752438ull, 106201443532302623ull, 109867759977491258ull,
+    113614455405083515ull, 117442303625890545ull, 121352076610411186ull, 125344544514784829ull,
+    129420475706080998ull, 133580636786950146ull, 137825792619658590ull, 142156706349530272ull,
+    146574139427815685ull, 151078851634008736ull, 155671601097630379ull, 160353144319497245ull,
+    165124236192493369ull, 169985630021860961ull, 174938077545026873ull, 179982328950979468ull,
+    185119132899211326ull, 190349236538241184ull, 195673385523728622ull, 201092324036194788ull,
+    206606794798360964ull, 212217539092117419ull, 217925296775133386ull, 223730806297119349ull,
+    229634804715752340ull, 235638027712273637ull, 241741209606769422ull, 247945083373143098ull,
+    254250380653788278ull, 260657831773971528ull, 267168165755932361ull, 273782110332709429ull,
+    280500391961699833ull, 287323735837959247ull, 294252865907250006ull, 301288504878844218ull,
+    308431374238087973ull, 315682194258733980ull, 323041684015047673ull, 330510561393693923ull,
+    338089543105409275ull, 345779344696465507ull, 353580680559930179ull, 361494263946729027ull,
+    369520806976515297ull, 377661020648350942ull, 385915614851204469ull, 394285298374269868ull,
+    402770778917110879ull, 411372763099635102ull, 420091956471902147ull, 428929063523769352ull,
+    437884787694379537ull, 446959831381494048ull, 456154895950675086ull, 465470681744320518ull,
+    474907888090554866ull, 484467213311979694ull, 494149354734286350ull, 503955008694734830ull,
+    513884870550500872ull, 523939634686895195ull, 534119994525456866ull, 544426642531924198ull,
+    554860270224085449ull, 565421568179512131ull, 576111226043177683ull, 586929932534963299ull,
+    597878375457054031ull, 608957241701227100ull, 620167217256034986ull, 631508987213884895ull,
+    642983235778017558ull, 654590646269386621ull, 666331901133441595ull, 678207681946815312ull,
+    690218669423918712ull, 702365543423444095ull, 714648982954779349ull, 727069666184334165ull,
+    739628270441780910ull, 752325472226210804ull, 765161947212207931ull, 778138370255842122ull,
+    791255415400582521ull, 804513755883133281ull, 817914064139192837ull, 831457011809138332ull,
+    845143269743636545ull, 858973508009182518ull, 872948395893567425ull, 887068601911277088ull,
+    901334793808822181ull, 915747638570001389ull, 930307802421098851ull, 945015950836017181ull,
+    959872748541346872ull, 974878859521373563ull, 990034947023023981ull, 1005341673560752073ull,
+    1020799700921365848ull, 1036409690168796387ull, 1052172301648809706ull, 1068088194993662706ull,
+    1084158029126704152ull, 1100382462266921387ull, 1116762151933434027ull, 1133297754949935202ull,
+    1149989927449081627ull, 1166839324876832872ull, 1183846601996741144ull, 1201012412894192102ull,
+    1218337410980597585ull, 1235822248997541099ull, 1253467579020876729ull, 1271274052464782617ull,
+    1289242320085768796ull, 1307373031986641361ull, 1325666837620422695ull, 1344124385794228915ull,
+    1362746324673105148ull, 1381533301783819159ull, 1400485964018614231ull, 1419604957638921559ull,
+    1438890928279033343ull, 1458344520949736517ull, 1477966380041908296ull, 1497757149330073917ull,
+    1517717471975926745ull, 1537847990531812231ull, 1558149346944175404ull, 1578622182556972878ull,
+    1599267138115049633ull, 1620084853767481539ull, 1641075969070883573ull, 1662241122992684796ull,
+    1683580953914369920ull, 1705096099634688791ull, 1726787197372833364ull, 1748654883771583247ull,
+    1770699794900420174ull, 1792922566258611707ull, 1815323832778264409ull, 1837904228827347668ull,
+    1860664388212687626ull, 1883604944182932442ull, 1906726529431488795ull, 1930029776099430109ull,
+    1953515315778377244ull, 1977183779513351444ull, 2001035797805600439ull, 2025072000615397931ull,
+    2049293017364816510ull, 2073699476940474856ull, 2098292007696259305ull, 2123071237456020028ull,
+    2148037793516242539ull, 2173192302648694271ull, 2198535391103047214ull, 2224067684609476611ull,
+    2249789808381235736ull, 2275702387117207768ull,
+};
+static_assert((CHECKPOINTS.size() - 1) * CURVE_CHECKPOINT_SPACING == CURVE_MAX_LEVEL,
+              "the last checkpoint is the highest level");
+
+// curvePower summed over levels from + 1 to to
+uint64_t sumCurvePower(int from, int to) {
+    uint64_t sum = 0;
+    uint64_t power = 0;
+    for (int level = from + 1; level <= to; ++level) {
+        power = curvePower(level, level > from + 1 ? nextCurvePowerGuess(level - 1, power) : 0);
+        sum += power;
+    }
+    return sum;
+}
+}  // namespace
+
+// The largest r with r^5 <= 10^10 * level^9, which fits the 256 bits for any level up to
+// CURVE_MAX_LEVEL
+uint64_t curvePower(int level, uint64_t guess) {
+    Wide target = widen(10000000000ull);
+    for (int i = 0; i < 9; ++i) target = multiply(target, static_cast<uint64_t>(level));
+
+    uint64_t low;   // low^5 <= target
+    uint64_t high;  // high^5 > target
+    if (fifthPowerAtMost(guess, target)) {
+        low = guess;
+        uint64_t step = 1;
+        while (fifthPowerAtMost(low + step, target)) {
+            low += step;
+            step *= 2;
+        }
+        high = low + step;
+    } else {
+        high = guess;
+        uint64_t step = 1;
+        while (step < high && !fifthPowerAtMost(high - step, target)) {
+            high -= step;
+            step *= 2;
+        }
+        low = step < high ? high - step : 0;
+    }
+    while (high - low > 1) {
+        uint64_t middle = low + (high - low) / 2;
+        if (fifthPowerAtMost(middle, target)) {
+            low = middle;
+        } else {
+            high = middle;
+        }
+    }
+    return low;
+}
+
+uint64_t nextCurvePowerGuess(int level, uint64_t power) {
+    if (level < 2) return 0;
+    // (1 + 1/m)^1.8 to two terms, plus one for the floors, lands on or just above the root
+    uint64_t m = static_cast<uint64_t>(level);
+    return power + power * 18 / (10 * m) + power * 72 / (100 * m * m) + 1;
+}
+
+uint64_t getCurveCheckpoint(size_t index) { return CHECKPOINTS[index]; }
+
+size_t getCurveCheckpointCount() { return CHECKPOINTS.size(); }
+
+uint64_t curvePowerSum(int level) {
+    if (level <= 0) return 0;
+    size_t below = static_cast<size_t>(level / CURVE_CHECKPOINT_SPACING);
+    int belowLevel = static_cast<int>(below) * CURVE_CHECKPOINT_SPACING;
+    if (level - belowLevel <= CURVE_CHECKPOINT_SPACING / 2 || below + 1 >= CHECKPOINTS.size()) {
+        return CHECKPOINTS[below] + sumCurvePower(belowLevel, level);
+    }
+    return CHECKPOINTS[below + 1] -
+           sumCurvePower(level, belowLevel + CURVE_CHECKPOINT_SPACING);
+}
@@ -0,0 +1,34 @@
+//
+// Created by Connor on 19/10/2026.
+//
+
+#ifndef TERMINAL_RPG_EXPERIENCECURVE_HPP
+#define TERMINAL_RPG_EXPERIENCECURVE_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+// The level curve, floor(100 * level^1.8), and its running total, worked out exactly in integers
+// so every machine agrees on every level's experience.
+
+// Levels between the checkpoints of the running total below
+constexpr int CURVE_CHECKPOINT_SPACING = 4096;
+// Highest level curvePowerSum() can answer for (the last checkpoint)
+constexpr int CURVE_MAX_LEVEL = 245 * CURVE_CHECKPOINT_SPACING;
+
+// floor(100 * level^1.8), for levels 1 to CURVE_MAX_LEVEL. guess is where the search starts;
+// nextCurvePowerGuess() gives one close enough that the root takes two or three comparisons.
+uint64_t curvePower(int level, uint64_t guess = 0);
+
+// A guess for curvePower(level + 1), given power = curvePower(level)
+uint64_t nextCurvePowerGuess(int level, uint64_t power);
+
+// curvePower summed over levels 1 to index * CURVE_CHECKPOINT_SPACING. Index 0 is 0.
+uint64_t getCurveCheckpoint(size_t index);
+size_t getCurveCheckpointCount();
+
+// curvePower summed over levels 1 to level (0 to CURVE_MAX_LEVEL). Goes from the nearest
+// checkpoint, so it works out at most CURVE_CHECKPOINT_SPACING / 2 roots.
+uint64_t curvePowerSum(int level);
+
+#endif  // TERMINAL_RPG_EXPERIENCECURVE_HPP
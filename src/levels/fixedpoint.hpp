@@ -0,0 +1,24 @@
+//
+// Created by Connor on 19/10/2026.
+//
+
+#ifndef TERMINAL_RPG_FIXEDPOINT_HPP
+#define TERMINAL_RPG_FIXEDPOINT_HPP
+
+#include <cstdint>
+
+// Stat multipliers are stored as whole thousandths (1.1 is 1100) and applied with integer maths,
+// so the same inputs give the same results on every compiler, optimisation level and machine.
+// Replays and the batch simulators rely on that.
+using Permille = int32_t;
+
+constexpr Permille PERMILLE_ONE = 1000;
+
+// value * factor / 1000 in 64 bits, rounded toward zero. That's the same rounding the old
+// static_cast of a double product used, minus the cases where the double landed just below a
+// whole number.
+constexpr int64_t applyPermille(int64_t value, Permille factor) {
+    return value * factor / PERMILLE_ONE;
+}
+
+#endif  // TERMINAL_RPG_FIXEDPOINT_HPP
@@ -5,15 +5,47 @@
 #include "leveldatabase.hpp"
 
 #include <algorithm>
-#include <cmath>
-#include <sstream>
+#include <climits>
+
+#include "../enemies/enemydatabase.hpp"
+#include "experiencecurve.hpp"
+
+namespace {
+// Where the endgame curves start. Levels past the table carry on along them.
+constexpr int ENDGAME_BASE_LEVEL = 50;
+
+// Sums of (level - 50) and of (level - 50) / 2 over levels 51 to level, so the endgame bonuses
+// can be totalled without walking the levels
+uint64_t endgameSteps(int level) {
+    uint64_t steps = static_cast<uint64_t>(level - ENDGAME_BASE_LEVEL);
+    return steps * (steps + 1) / 2;
+}
+
+uint64_t endgameHalfSteps(int level) {
+    uint64_t steps = static_cast<uint64_t>(level - ENDGAME_BASE_LEVEL);
+    return (steps / 2) * ((steps + 1) / 2);
+}
+
+static_assert(LevelDatabase::MAX_LEVEL_CAP <= CURVE_MAX_LEVEL,
+              "the experience curve's checkpoints must reach the highest cap");
+
+// n * (n + 1) / 2: the level * 50 part of the experience curve, summed
+uint64_t triangle(int level) {
+    uint64_t n = static_cast<uint64_t>(level);
+    return n * (n + 1) / 2;
+}
+
+unsigned int saturate(uint64_t value) {
+    return static_cast<unsigned int>(std::min<uint64_t>(value, UINT_MAX));
+}
+}  // namespace
 
 LevelTemplate::LevelTemplate(int level, unsigned int experienceRequired,
                              unsigned int totalExperienceRequired, unsigned int healthBonus,
                              unsigned int staminaBonus, unsigned int defenceBonus,
                              unsigned int resistanceBonus, const std::string& levelTitle,
-                             double healthMultiplier, double staminaMultiplier,
-                             double defenceMultiplier, double resistanceMultiplier)
+                             Permille healthMultiplier, Permille staminaMultiplier,
+                             Permille defenceMultiplier, Permille resistanceMultiplier)
     : level(level),
       experienceRequired(experienceRequired),
       totalExperienceRequired(totalExperienceRequired),
@@ -21,14 +53,14 @@ LevelTemplate::LevelTemplate(int level, unsigned int experienceRequired,
       staminaBonus(staminaBonus),
       defenceBonus(defenceBonus),
       resistanceBonus(resistanceBonus),
-      levelTitle(levelTitle),
+      levelTitle(InternedString(levelTitle)),
       healthMultiplier(healthMultiplier),
       staminaMultiplier(staminaMultiplier),
       defenceMultiplier(defenceMultiplier),
       resistanceMultiplier(resistanceMultiplier) {}
 
-ExperienceReward::ExperienceReward(int baseExp, double levelMult, double rarityMult, int minExp,
-                                   int maxExp)
+ExperienceReward::ExperienceReward(int baseExp, Permille levelMult, Permille rarityMult,
+                                   int minExp, int maxExp)
     : baseExperience(baseExp),
       levelDifferenceMultiplier(levelMult),
       rarityMultiplier(rarityMult),
@@ -45,6 +77,15 @@ void LevelDatabase::initialize() {
     createMidLevels();
     createHighLevels();
     createEndgameLevels();
+    buildTableTotals();
+    levelCap = tableLevels;
+    buildRewardTable();
+}
+
+bool LevelDatabase::setLevelCap(int cap) {
+    if (tableLevels == 0 || cap < tableLevels || cap > MAX_LEVEL_CAP) return false;
+    levelCap = cap;
+    return true;
 }
 
 const LevelTemplate* LevelDatabase::getLevelTemplate(int level) const {
@@ -52,75 +93,127 @@ const LevelTemplate* LevelDatabase::getLevelTemplate(int level) const {
     return (it != levelTemplates.end()) ? it->second.get() : nullptr;
 }
 
-unsigned int LevelDatabase::getExperienceForLevel(int targetLevel) const {
-    const LevelTemplate* template_ptr = getLevelTemplate(targetLevel);
-    return template_ptr ? template_ptr->totalExperienceRequired : 0;
+uint64_t LevelDatabase::getExperienceForLevel(int targetLevel) const {
+    if (targetLevel < 1 || targetLevel > levelCap) return 0;
+    return getTotals(targetLevel).experience;
 }
 
-int LevelDatabase::getLevelFromExperience(unsigned int totalExperience) const {
-    int resultLevel = 1;
-    for (const auto& pair : levelTemplates) {
-        if (totalExperience >= pair.second->totalExperienceRequired) {
-            resultLevel = std::max(resultLevel, pair.first);
+int LevelDatabase::getLevelFromExperience(uint64_t totalExperience) const {
+    // Highest level within reach; the totals only ever go up
+    int low = 1;
+    int high = std::max(std::min(levelCap, tableLevels), 1);
+    while (low < high) {
+        int mid = low + (high - low + 1) / 2;
+        if (getTotals(mid).experience <= totalExperience) {
+            low = mid;
+        } else {
+            high = mid - 1;
+        }
+    }
+    if (low < tableLevels || levelCap <= tableLevels) return low;
+
+    // Past the table: the last checkpoint within reach, then a walk through the block after it
+    int reached = tableLevels;
+    uint64_t curveSum = tableCurveSum;
+    size_t first = static_cast<size_t>(tableLevels / CURVE_CHECKPOINT_SPACING) + 1;
+    size_t last = static_cast<size_t>(levelCap / CURVE_CHECKPOINT_SPACING);
+    while (first <= last) {
+        size_t mid = first + (last - first) / 2;
+        int level = static_cast<int>(mid) * CURVE_CHECKPOINT_SPACING;
+        if (experienceFromCurve(level, getCurveCheckpoint(mid)) <= totalExperience) {
+            reached = level;
+            curveSum = getCurveCheckpoint(mid);
+            first = mid + 1;
+        } else {
+            last = mid - 1;
         }
     }
-    return resultLevel;
+
+    uint64_t power = 0;
+    for (int level = reached + 1; level <= levelCap; ++level) {
+        uint64_t guess = level > reached + 1 ? nextCurvePowerGuess(level - 1, power) : 0;
+        power = curvePower(level, guess);
+        curveSum += power;
+        if (experienceFromCurve(level, curveSum) > totalExperience) break;
+        reached = level;
+    }
+    return reached;
 }
 
-unsigned int LevelDatabase::getExperienceForNextLevel(int currentLevel) const {
+uint64_t LevelDatabase::getExperienceForNextLevel(int currentLevel) const {
     if (currentLevel >= getMaxLevel()) {
         return 0;  // Already at max level
     }
 
-    const LevelTemplate* nextLevel = getLevelTemplate(currentLevel + 1);
-    return nextLevel ? nextLevel->totalExperienceRequired : 0;
+    return getExperienceForLevel(currentLevel + 1);
 }
 
 int LevelDatabase::calculateExperienceReward(int playerLevel, int enemyLevel, bool isBoss) const {
+    if (playerLevel >= 1 && playerLevel <= rewardPlayerLevels && enemyLevel >= 1 &&
+        enemyLevel <= rewardEnemyLevels) {
+        size_t cell = static_cast<size_t>(playerLevel - 1) * rewardEnemyLevels + (enemyLevel - 1);
+        return rewardTable[cell * 2 + (isBoss ? 1 : 0)];
+    }
+    return computeExperienceReward(playerLevel, enemyLevel, isBoss);
+}
+
+int LevelDatabase::computeExperienceReward(int playerLevel, int enemyLevel, bool isBoss) const {
     // Base experience calculation
-    int baseExp = experienceRewards.baseExperience;
+    int64_t baseExp = experienceRewards.baseExperience;
 
-    double levelDiff = static_cast<double>(enemyLevel - playerLevel);
-    double levelModifier = 1.0 + (levelDiff * 0.15);  // 15% per level difference
-    levelModifier = std::max(0.25, levelModifier);    // Minimum 25% exp
-    levelModifier = std::min(3.0, levelModifier);     // Maximum 300% exp
+    int64_t levelDiff = static_cast<int64_t>(enemyLevel) - playerLevel;
+    int64_t levelModifier = PERMILLE_ONE + levelDiff * 150;  // 15% per level difference
+    levelModifier = std::max<int64_t>(250, levelModifier);   // Minimum 25% exp
+    levelModifier = std::min<int64_t>(3000, levelModifier);  // Maximum 300% exp
 
-    double enemyLevelModifier = 1.0 + (enemyLevel * 0.1);
+    int64_t enemyLevelModifier = PERMILLE_ONE + static_cast<int64_t>(enemyLevel) * 100;
 
-    double bossModifier = isBoss ? 5.0 : 1.0;
+    int64_t bossModifier = isBoss ? 5 : 1;
 
-    int finalExp = static_cast<int>(baseExp * levelModifier * enemyLevelModifier * bossModifier);
+    // Two permille factors (the boss factor is a plain multiple), so one division by 1000^2 at
+    // the end, rounding down
+    constexpr int64_t scale = static_cast<int64_t>(PERMILLE_ONE) * PERMILLE_ONE;
+    int64_t finalExp = baseExp * levelModifier * enemyLevelModifier * bossModifier / scale;
 
-    finalExp = std::max(experienceRewards.minExperience, finalExp);
-    finalExp = std::min(experienceRewards.maxExperience, finalExp);
+    finalExp = std::max<int64_t>(experienceRewards.minExperience, finalExp);
+    finalExp = std::min<int64_t>(experienceRewards.maxExperience, finalExp);
 
-    return finalExp;
+    return static_cast<int>(finalExp);
 }
 
-std::string LevelDatabase::getLevelProgressionInfo(int currentLevel,
-                                                   unsigned int currentExp) const {
-    std::ostringstream info;
-    const LevelTemplate* currentTemplate = getLevelTemplate(currentLevel);
+std::string LevelDatabase::getLevelProgressionInfo(int currentLevel, uint64_t currentExp) const {
+    TextBuffer info;
+    writeLevelProgressionInfo(currentLevel, currentExp, info);
+    return std::string(info.view());
+}
 
-    if (!currentTemplate) {
-        return "Invalid level data";
+void LevelDatabase::writeLevelProgressionInfo(int currentLevel, uint64_t currentExp,
+                                              TextBuffer& out) const {
+    if (currentLevel < 1 || currentLevel > levelCap) {
+        out << "Invalid level data";
+        return;
     }
 
-    info << "Level " << currentLevel << ": " << currentTemplate->levelTitle << "\n";
+    out << "Level " << currentLevel << ": ";
+    const LevelTemplate* currentTemplate = getLevelTemplate(currentLevel);
+    if (currentTemplate) {
+        out << currentTemplate->levelTitle;
+    } else {
+        out << getLevelTitle(currentLevel);
+    }
+    out << '\n';
 
-    unsigned int nextLevelExp = getExperienceForNextLevel(currentLevel);
+    uint64_t nextLevelExp = getExperienceForNextLevel(currentLevel);
     if (nextLevelExp > 0) {
-        unsigned int expNeeded = nextLevelExp - currentExp;
-        info << "Experience: " << currentExp << " / " << nextLevelExp << "\n";
-        info << "Experience needed for next level: " << expNeeded;
+        uint64_t expNeeded = nextLevelExp - currentExp;
+        out.format("Experience: {} / {}\n", currentExp, nextLevelExp);
+        out << "Experience needed for next level: " << expNeeded;
     } else {
-        info << "Experience: " << currentExp << " (MAX LEVEL)";
+        out.format("Experience: {} (MAX LEVEL)", currentExp);
     }
-
-    return info.str();
 }
 
-int LevelDatabase::checkLevelUp(unsigned int currentExperience, int currentLevel) const {
+int LevelDatabase::checkLevelUp(uint64_t currentExperience, int currentLevel) const {
     int newLevel = getLevelFromExperience(currentExperience);
     return std::max(newLevel, currentLevel);  // Never level down
 }
@@ -132,86 +225,134 @@ void LevelDatabase::getStatBonuses(int level, unsigned int& healthBonus, unsigne
     staminaBonus = 0;
     defenceBonus = 0;
     resistanceBonus = 0;
+    if (level < 1) return;
 
     // Collect bonuses from level 1 to current level
-    for (int i = 1; i <= level; ++i) {
-        const LevelTemplate* template_ptr = getLevelTemplate(i);
-        if (template_ptr) {
-            healthBonus += template_ptr->healthBonus;
-            staminaBonus += template_ptr->staminaBonus;
-            defenceBonus += template_ptr->defenceBonus;
-            resistanceBonus += template_ptr->resistanceBonus;
-        }
-    }
+    LevelTotals totals = getTotals(std::min(level, levelCap));
+    healthBonus = saturate(totals.health);
+    staminaBonus = saturate(totals.stamina);
+    defenceBonus = saturate(totals.defence);
+    resistanceBonus = saturate(totals.resistance);
 }
 
 std::string LevelDatabase::getLevelTitle(int level) const {
+    if (level > tableLevels && level <= levelCap) {
+        return "Prestige " + std::to_string(level - tableLevels);
+    }
     const LevelTemplate* template_ptr = getLevelTemplate(level);
-    return template_ptr ? template_ptr->levelTitle : "Unknown";
+    return template_ptr ? std::string(template_ptr->levelTitle.view()) : "Unknown";
 }
 
-int LevelDatabase::getMaxLevel() const {
-    int maxLevel = 1;
-    for (const auto& pair : levelTemplates) {
-        maxLevel = std::max(maxLevel, pair.first);
-    }
-    return maxLevel;
-}
+int LevelDatabase::getMaxLevel() const { return std::max(levelCap, 1); }
 
 void LevelDatabase::addLevelTemplate(std::unique_ptr<LevelTemplate> levelTemplate) {
     levelTemplates[levelTemplate->level] = std::move(levelTemplate);
 }
 
+void LevelDatabase::buildTableTotals() {
+    tableLevels = levelTemplates.empty() ? 0 : levelTemplates.rbegin()->first;
+    tableTotals.assign(static_cast<size_t>(tableLevels) + 1, LevelTotals{});
+    for (int level = 1; level <= tableLevels; ++level) {
+        LevelTotals& totals = tableTotals[level];
+        totals = tableTotals[level - 1];
+        const LevelTemplate* template_ptr = getLevelTemplate(level);
+        if (template_ptr) {
+            totals.experience = template_ptr->totalExperienceRequired;
+            totals.health += template_ptr->healthBonus;
+            totals.stamina += template_ptr->staminaBonus;
+            totals.defence += template_ptr->defenceBonus;
+            totals.resistance += template_ptr->resistanceBonus;
+        }
+    }
+    tableCurveSum = curvePowerSum(tableLevels);
+}
+
+LevelDatabase::LevelTotals LevelDatabase::getTotals(int level) const {
+    if (level <= tableLevels) return tableTotals[std::max(level, 0)];
+
+    // Past the table: the endgame lines from createEndgameLevels, carried on
+    LevelTotals totals = tableTotals[tableLevels];
+    uint64_t levels = static_cast<uint64_t>(level - tableLevels);
+    uint64_t steps = endgameSteps(level) - endgameSteps(tableLevels);
+    uint64_t halfSteps = endgameHalfSteps(level) - endgameHalfSteps(tableLevels);
+    totals.health += 100 * levels + 20 * steps;
+    totals.stamina += 50 * levels + 10 * steps;
+    totals.defence += 8 * levels + halfSteps;
+    totals.resistance += 6 * levels + halfSteps;
+
+    totals.experience = experienceFromCurve(level, curvePowerSum(level));
+    return totals;
+}
+
+uint64_t LevelDatabase::experienceFromCurve(int level, uint64_t curveSum) const {
+    return tableTotals[tableLevels].experience + (curveSum - tableCurveSum) +
+           (triangle(level) - triangle(tableLevels)) * 50;
+}
+
+void LevelDatabase::buildRewardTable() {
+    rewardPlayerLevels = tableLevels;
+    rewardEnemyLevels = std::max(rewardPlayerLevels, EnemyDatabase::getInstance().getMaxLevel());
+
+    rewardTable.assign(static_cast<size_t>(rewardPlayerLevels) * rewardEnemyLevels * 2, 0);
+    size_t index = 0;
+    for (int playerLevel = 1; playerLevel <= rewardPlayerLevels; ++playerLevel) {
+        for (int enemyLevel = 1; enemyLevel <= rewardEnemyLevels; ++enemyLevel) {
+            rewardTable[index++] = computeExperienceReward(playerLevel, enemyLevel, false);
+            rewardTable[index++] = computeExperienceReward(playerLevel, enemyLevel, true);
+        }
+    }
+}
+
 unsigned int LevelDatabase::calculateExperienceRequirement(int level) const {
     if (level <= 1) return 0;
 
-    // Formula: base * (level^1.8) + (level * 50)
-    double base = 100.0;
-    double exponential = std::pow(static_cast<double>(level), 1.8);
-    double linear = static_cast<double>(level) * 50.0;
-
-    return static_cast<unsigned int>(base * exponential + linear);
+    // Formula: floor(100 * level^1.8) + level * 50, all in integers
+    return static_cast<unsigned int>(curvePower(level, 0) + static_cast<uint64_t>(level) * 50);
 }
 
 void LevelDatabase::createEarlyLevels() {
-    auto level1 = std::make_unique<LevelTemplate>(1, 0, 0, 0, 0, 0, 0, "Novice Adventurer", 1.0,
-                                                  1.0, 1.0, 1.0);
+    auto level1 = std::make_unique<LevelTemplate>(1, 0, 0, 0, 0, 0, 0, "Novice Adventurer", 1000,
+                                                  1000, 1000, 1000);
     addLevelTemplate(std::move(level1));
 
     auto level2 =
-        std::make_unique<LevelTemplate>(2, 100, 100, 15, 5, 1, 0, "Apprentice", 1.0, 1.0, 1.0, 1.0);
+        std::make_unique<LevelTemplate>(2, 100, 100, 15, 5, 1, 0, "Apprentice",
+                                        1000, 1000, 1000, 1000);
     addLevelTemplate(std::move(level2));
 
     auto level3 =
-        std::make_unique<LevelTemplate>(3, 150, 250, 20, 8, 1, 1, "Trainee", 1.0, 1.0, 1.0, 1.0);
+        std::make_unique<LevelTemplate>(3, 150, 250, 20, 8, 1, 1, "Trainee",
+                                        1000, 1000, 1000, 1000);
     addLevelTemplate(std::move(level3));
 
     auto level4 =
-        std::make_unique<LevelTemplate>(4, 200, 450, 25, 10, 2, 1, "Scout", 1.0, 1.0, 1.0, 1.0);
+        std::make_unique<LevelTemplate>(4, 200, 450, 25, 10, 2, 1, "Scout", 1000, 1000, 1000, 1000);
     addLevelTemplate(std::move(level4));
 
     auto level5 =
-        std::make_unique<LevelTemplate>(5, 300, 750, 30, 12, 2, 1, "Warrior", 1.1, 1.0, 1.0, 1.0);
+        std::make_unique<LevelTemplate>(5, 300, 750, 30, 12, 2, 1, "Warrior",
+                                        1100, 1000, 1000, 1000);
     addLevelTemplate(std::move(level5));
 
     auto level6 =
-        std::make_unique<LevelTemplate>(6, 400, 1150, 35, 15, 3, 2, "Veteran", 1.1, 1.0, 1.0, 1.0);
+        std::make_unique<LevelTemplate>(6, 400, 1150, 35, 15, 3, 2, "Veteran",
+                                        1100, 1000, 1000, 1000);
     addLevelTemplate(std::move(level6));
 
     auto level7 = std::make_unique<LevelTemplate>(7, 500, 1650, 40, 18, 3, 2, "Skilled Fighter",
-                                                  1.1, 1.1, 1.0, 1.0);
+                                                  1100, 1100, 1000, 1000);
     addLevelTemplate(std::move(level7));
 
     auto level8 = std::make_unique<LevelTemplate>(8, 650, 2300, 45, 20, 4, 3, "Seasoned Warrior",
-                                                  1.1, 1.1, 1.0, 1.0);
+                                                  1100, 1100, 1000, 1000);
     addLevelTemplate(std::move(level8));
 
     auto level9 = std::make_unique<LevelTemplate>(9, 800, 3100, 50, 25, 4, 3, "Veteran Warrior",
-                                                  1.1, 1.1, 1.1, 1.0);
+                                                  1100, 1100, 1100, 1000);
     addLevelTemplate(std::move(level9));
 
     auto level10 = std::make_unique<LevelTemplate>(10, 1000, 4100, 60, 30, 5, 4, "Elite Warrior",
-                                                   1.2, 1.1, 1.1, 1.1);
+                                                   1200, 1100, 1100, 1100);
     addLevelTemplate(std::move(level10));
 }
 
@@ -236,10 +377,10 @@ void LevelDatabase::createMidLevels() {
             title = "Legendary Hero";
         }
 
-        double healthMult = 1.1 + (level - 10) * 0.02;
-        double staminaMult = 1.1 + (level - 10) * 0.015;
-        double defenceMult = 1.1 + (level - 10) * 0.01;
-        double resistanceMult = 1.1 + (level - 10) * 0.01;
+        Permille healthMult = 1100 + (level - 10) * 20;
+        Permille staminaMult = 1100 + (level - 10) * 15;
+        Permille defenceMult = 1100 + (level - 10) * 10;
+        Permille resistanceMult = 1100 + (level - 10) * 10;
 
         auto levelTemplate = std::make_unique<LevelTemplate>(
             level, expRequired, totalExp, healthBonus, staminaBonus, defenceBonus, resistanceBonus,
@@ -268,10 +409,10 @@ void LevelDatabase::createHighLevels() {
             title = "Demigod";
         }
 
-        double healthMult = 1.3 + (level - 25) * 0.025;
-        double staminaMult = 1.2 + (level - 25) * 0.02;
-        double defenceMult = 1.2 + (level - 25) * 0.015;
-        double resistanceMult = 1.2 + (level - 25) * 0.015;
+        Permille healthMult = 1300 + (level - 25) * 25;
+        Permille staminaMult = 1200 + (level - 25) * 20;
+        Permille defenceMult = 1200 + (level - 25) * 15;
+        Permille resistanceMult = 1200 + (level - 25) * 15;
 
         auto levelTemplate = std::make_unique<LevelTemplate>(
             level, expRequired, totalExp, healthBonus, staminaBonus, defenceBonus, resistanceBonus,
@@ -302,10 +443,10 @@ void LevelDatabase::createEndgameLevels() {
             title = "The One";
         }
 
-        double healthMult = 1.5 + (level - 50) * 0.03;
-        double staminaMult = 1.4 + (level - 50) * 0.025;
-        double defenceMult = 1.3 + (level - 50) * 0.02;
-        double resistanceMult = 1.3 + (level - 50) * 0.02;
+        Permille healthMult = 1500 + (level - 50) * 30;
+        Permille staminaMult = 1400 + (level - 50) * 25;
+        Permille defenceMult = 1300 + (level - 50) * 20;
+        Permille resistanceMult = 1300 + (level - 50) * 20;
 
         auto levelTemplate = std::make_unique<LevelTemplate>(
             level, expRequired, totalExp, healthBonus, staminaBonus, defenceBonus, resistanceBonus,
@@ -5,11 +5,15 @@
 #ifndef TERMINAL_RPG_LEVELDATABASE_HPP
 #define TERMINAL_RPG_LEVELDATABASE_HPP
 
+#include <cstdint>
 #include <vector>
 #include <memory>
 #include <map>
 #include <string>
 
+#include "../text/textbuffer.hpp"
+#include "fixedpoint.hpp"
+
 struct LevelTemplate {
     int level;
     unsigned int experienceRequired;
@@ -18,75 +22,101 @@ struct LevelTemplate {
     unsigned int staminaBonus;
     unsigned int defenceBonus;
     unsigned int resistanceBonus;
-    std::string levelTitle;
+    InternedString levelTitle;
 
-    // Stat multipliers for scaling
-    double healthMultiplier;
-    double staminaMultiplier;
-    double defenceMultiplier;
-    double resistanceMultiplier;
+    // Stat multipliers for scaling, in thousandths
+    Permille healthMultiplier;
+    Permille staminaMultiplier;
+    Permille defenceMultiplier;
+    Permille resistanceMultiplier;
 
     LevelTemplate(int level, unsigned int experienceRequired, unsigned int totalExperienceRequired,
                  unsigned int healthBonus, unsigned int staminaBonus, unsigned int defenceBonus,
                  unsigned int resistanceBonus, const std::string& levelTitle,
-                 double healthMultiplier = 1.0,
-                 double staminaMultiplier = 1.0, double defenceMultiplier = 1.0,
-                 double resistanceMultiplier = 1.0);
+                 Permille healthMultiplier = PERMILLE_ONE,
+                 Permille staminaMultiplier = PERMILLE_ONE,
+                 Permille defenceMultiplier = PERMILLE_ONE,
+                 Permille resistanceMultiplier = PERMILLE_ONE);
 };
 
 struct ExperienceReward {
     int baseExperience;
-    double levelDifferenceMultiplier;
-    double rarityMultiplier;
+    Permille levelDifferenceMultiplier;
+    Permille rarityMultiplier;
     int minExperience;
     int maxExperience;
 
     // Default constructor
-    ExperienceReward() : baseExperience(20), levelDifferenceMultiplier(1.0),
-                        rarityMultiplier(1.0), minExperience(1), maxExperience(1000) {}
+    ExperienceReward() : baseExperience(20), levelDifferenceMultiplier(PERMILLE_ONE),
+                        rarityMultiplier(PERMILLE_ONE), minExperience(1), maxExperience(1000) {}
 
-    ExperienceReward(int baseExp, double levelMult = 1.0, double rarityMult = 1.0,
-                    int minExp = 1, int maxExp = 1000);
+    ExperienceReward(int baseExp, Permille levelMult = PERMILLE_ONE,
+                    Permille rarityMult = PERMILLE_ONE, int minExp = 1, int maxExp = 1000);
 };
 
 class LevelDatabase {
 public:
+    // Highest level cap an endless game can ask for
+    static constexpr int MAX_LEVEL_CAP = 1000000;
+
     static LevelDatabase& getInstance();
 
+    // Builds the level table and resets the level cap to its last level
     void initialize();
 
-    // Get level template by level number (returns nullptr if not found)
+    // Raises the level cap past the table (endless mode). Levels beyond the table follow the
+    // endgame curves without being stored: stat bonuses in closed form, experience exact from
+    // the nearest checkpoint of the curve's running total (experiencecurve.hpp), which bounds a
+    // query to one block of per-level roots whatever the cap. False if cap is below the table's
+    // last level or above MAX_LEVEL_CAP.
+    bool setLevelCap(int cap);
+
+    // Get level template by level number (returns nullptr if not found, including levels past
+    // the table)
     const LevelTemplate* getLevelTemplate(int level) const;
 
-    // Calculate experience required to reach a specific level
-    unsigned int getExperienceForLevel(int targetLevel) const;
+    // Calculate experience required to reach a specific level (0 outside 1 to the level cap)
+    uint64_t getExperienceForLevel(int targetLevel) const;
 
     // Calculate what level a player should be based on total experience
-    int getLevelFromExperience(unsigned int totalExperience) const;
+    int getLevelFromExperience(uint64_t totalExperience) const;
 
     // Calculate experience needed for next level
-    unsigned int getExperienceForNextLevel(int currentLevel) const;
+    uint64_t getExperienceForNextLevel(int currentLevel) const;
 
-    // Calculate experience reward for defeating an enemy
+    // Calculate experience reward for defeating an enemy. A lookup for any player level in the
+    // table and any enemy level up to the higher of that and the strongest enemy; other levels
+    // are worked out on the spot, with the same result
     int calculateExperienceReward(int playerLevel, int enemyLevel, bool isBoss = false) const;
 
     // Get level progression info
-    std::string getLevelProgressionInfo(int currentLevel, unsigned int currentExp) const;
+    std::string getLevelProgressionInfo(int currentLevel, uint64_t currentExp) const;
+    void writeLevelProgressionInfo(int currentLevel, uint64_t currentExp, TextBuffer& out) const;
 
     // Check if player can level up and return new level
-    int checkLevelUp(unsigned int currentExperience, int currentLevel) const;
+    int checkLevelUp(uint64_t currentExperience, int currentLevel) const;
 
-    // Get stat bonuses for a specific level
+    // Get stat bonuses for a specific level (summed over every level up to it, saturating at
+    // UINT_MAX)
     void getStatBonuses(int level, unsigned int& healthBonus, unsigned int& staminaBonus,
                        unsigned int& defenceBonus, unsigned int& resistanceBonus) const;
 
     // Get level title for a specific level
     std::string getLevelTitle(int level) const;
 
-    // Get maximum level
+    // Get maximum level (the level cap)
     int getMaxLevel() const;
 
 private:
+    // Experience and stat bonuses summed from level 1
+    struct LevelTotals {
+        uint64_t experience;
+        uint64_t health;
+        uint64_t stamina;
+        uint64_t defence;
+        uint64_t resistance;
+    };
+
     LevelDatabase() = default;
     ~LevelDatabase() = default;
     LevelDatabase(const LevelDatabase&) = delete;
@@ -95,6 +125,20 @@ private:
     std::map<int, std::unique_ptr<LevelTemplate>> levelTemplates;
     ExperienceReward experienceRewards;
 
+    // Running totals for the table's levels, indexed by level (0 is all zeros)
+    std::vector<LevelTotals> tableTotals;
+    int tableLevels = 0;
+    int levelCap = 0;
+
+    // The curve's running total at the table's last level, where the endless levels pick it up
+    uint64_t tableCurveSum = 0;
+
+    // Every reward the table's levels can give, built by initialize(). Indexed by
+    // ((playerLevel - 1) * rewardEnemyLevels + enemyLevel - 1) * 2 + isBoss
+    std::vector<int> rewardTable;
+    int rewardPlayerLevels = 0;
+    int rewardEnemyLevels = 0;
+
     // Helper methods to create level data
     void createEarlyLevels();      // Levels 1-10
     void createMidLevels();        // Levels 11-25
@@ -104,6 +148,19 @@ private:
     // Helper to add level template
     void addLevelTemplate(std::unique_ptr<LevelTemplate> levelTemplate);
 
+    // The reward formula itself. All integer maths: the exact product of the modifiers,
+    // rounded down once at the end
+    int computeExperienceReward(int playerLevel, int enemyLevel, bool isBoss) const;
+    void buildRewardTable();
+    void buildTableTotals();
+
+    // Total experience at a level past the table, given the curve's running total there
+    uint64_t experienceFromCurve(int level, uint64_t curveSum) const;
+
+    // Totals for any level from 0 to the cap: the table's, plus the endgame curves for anything
+    // past it
+    LevelTotals getTotals(int level) const;
+
     // Helper to calculate balanced experience requirements
     unsigned int calculateExperienceRequirement(int level) const;
 };
@@ -0,0 +1,193 @@
+//
+// Created by Connor on 19/10/2026.
+//
+
+#include "botplayer.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <sstream>
+
+namespace {
+bool endsWith(const std::string& text, const std::string& suffix) {
+    return text.size() >= suffix.size() &&
+           text.compare(text.size() - suffix.size(), suffix.size(), suffix) == 0;
+}
+
+bool contains(const std::string& text, const std::string& part) {
+    return text.find(part) != std::string::npos;
+}
+
+const char* const POWER_ATTACK_REFUSED = "You don't have enough stamina for a power attack! (Need ";
+}  // namespace
+
+const char* getBotPolicyName(BotPolicy policy) {
+    switch (policy) {
+        case BotPolicy::AGGRESSIVE:
+            return "aggressive";
+        case BotPolicy::DEFENSIVE:
+            return "defensive";
+        case BotPolicy::MERCHANT_HEAVY:
+            return "merchant";
+        default:
+            return "unknown";
+    }
+}
+
+bool parseBotPolicy(const std::string& name, BotPolicy& policy) {
+    for (int i = 0; i < static_cast<int>(BotPolicy::COUNT); ++i) {
+        if (name == getBotPolicyName(static_cast<BotPolicy>(i))) {
+            policy = static_cast<BotPolicy>(i);
+            return true;
+        }
+    }
+    return false;
+}
+
+bool parseFrameStat(const std::string& frame, const std::string& label, int& current, int& max) {
+    size_t position = frame.rfind(label);
+    if (position == std::string::npos) return false;
+
+    std::istringstream stream(frame.substr(position + label.size()));
+    char slash = '\0';
+    return static_cast<bool>(stream >> current >> slash >> max) && slash == '/';
+}
+
+int countFrameOptions(const std::string& frame, const std::string& header) {
+    size_t position = frame.rfind(header);
+    if (position == std::string::npos) return 0;
+
+    // Options are numbered 1, 2, 3...; a list that starts over at 1 is a different menu
+    std::istringstream stream(frame.substr(position + header.size()));
+    std::string line;
+    int count = 0;
+    while (std::getline(stream, line)) {
+        if (line.empty() || !std::isdigit(static_cast<unsigned char>(line[0]))) continue;
+        int number = 0;
+        size_t digits = 0;
+        while (digits < line.size() && std::isdigit(static_cast<unsigned char>(line[digits]))) {
+            number = number * 10 + (line[digits++] - '0');
+        }
+        if (digits >= line.size() || line[digits] != '.') continue;
+        if (number == count + 1) {
+            count = number;
+        } else if (number == 1) {
+            break;
+        }
+    }
+    return count;
+}
+
+BotPlayer::BotPlayer(BotPolicy policy, unsigned int seed, unsigned int continuesPerGame)
+    : policy(policy), rng(seed), continuesPerGame(continuesPerGame) {
+    reset();
+}
+
+void BotPlayer::reset() {
+    continuesLeft = continuesPerGame;
+    merchantActions = 0;
+    merchantStock = 0;
+    powerAttackCost = 15;
+    hasPotions = false;
+    gameOver = false;
+}
+
+bool BotPlayer::chooseAnswer(const std::string& frame, std::string& answer) {
+    answer.clear();
+
+    // Remember what the game told us since the last prompt
+    if (contains(frame, "You bought ") || contains(frame, "You found: ")) hasPotions = true;
+    if (contains(frame, "You have no usable items in combat!")) hasPotions = false;
+    size_t refused = frame.rfind(POWER_ATTACK_REFUSED);
+    if (refused != std::string::npos) {
+        std::istringstream(frame.substr(refused + std::string(POWER_ATTACK_REFUSED).size())) >>
+            powerAttackCost;
+    }
+    if (contains(frame, "------ Merchant Inventory ------")) {
+        merchantActions = 0;
+        merchantStock = countFrameOptions(frame, "------ Merchant Inventory ------");
+    }
+    if (contains(frame, "You bought ") && merchantStock > 0) --merchantStock;
+
+    if (contains(frame, "Game Over!") || contains(frame, "Thanks for playing!")) {
+        gameOver = true;
+        return true;
+    }
+
+    if (endsWith(frame, "Enter your character's name: ")) {
+        answer = std::string("Bot-") + getBotPolicyName(policy);
+    } else if (endsWith(frame, "Continue adventuring? (y/n): ")) {
+        if (continuesLeft == 0) {
+            answer = "n";
+        } else {
+            --continuesLeft;
+            answer = "y";
+        }
+    } else if (endsWith(frame, "Enter your choice (1-6): ")) {
+        answer = chooseCombatAction(frame);
+    } else if (contains(frame, "Enter a target (1-") && endsWith(frame, "): ")) {
+        // Packs: always go for the first enemy, so kills come as early as possible
+        answer = "1";
+    } else if (endsWith(frame, "Press Enter to continue...")) {
+        answer = "";
+    } else if (endsWith(frame, "Do you want to open it? (y/n): ")) {
+        answer = policy == BotPolicy::DEFENSIVE ? "n" : "y";
+    } else if (endsWith(frame, "0. Cancel\n")) {
+        // Potion choice: drink the first one
+        answer = "1";
+    } else if (endsWith(frame, "Choose gear to equip: ")) {
+        answer = "0";
+    } else if (endsWith(frame, "Enter your choice: ")) {
+        answer = chooseMerchantAction();
+    } else if (endsWith(frame, "Which item would you like to buy? Enter the number: ")) {
+        answer = std::to_string(randomInt(1, std::max(1, merchantStock)));
+    } else if (endsWith(frame, "Enter the number of the item to sell: ")) {
+        int owned = countFrameOptions(frame, "Your inventory:");
+        answer = std::to_string(randomInt(1, std::max(1, owned)));
+    } else {
+        return false;
+    }
+    return true;
+}
+
+bool BotPlayer::isGameOver() const { return gameOver; }
+
+BotPolicy BotPlayer::getPolicy() const { return policy; }
+
+std::string BotPlayer::chooseCombatAction(const std::string& frame) {
+    int health = 0, maxHealth = 1, stamina = 0, maxStamina = 1;
+    parseFrameStat(frame, "Your Health: ", health, maxHealth);
+    parseFrameStat(frame, "Your Stamina: ", stamina, maxStamina);
+
+    switch (policy) {
+        case BotPolicy::AGGRESSIVE:
+            if (stamina >= powerAttackCost) return "3";
+            return stamina >= 5 ? "1" : "2";
+        case BotPolicy::DEFENSIVE:
+            if (hasPotions && health * 3 < maxHealth) return "4";
+            if (stamina * 2 < maxStamina) return "2";
+            return "1";
+        default:
+            return stamina >= 5 ? "1" : "2";
+    }
+}
+
+std::string BotPlayer::chooseMerchantAction() {
+    if (policy != BotPolicy::MERCHANT_HEAVY) return "3";
+
+    // Browse a little at every merchant: buy twice, sell once, then move on
+    switch (merchantActions++) {
+        case 0:
+        case 1:
+            return merchantStock > 0 ? "1" : "2";
+        case 2:
+            return "2";
+        default:
+            return "3";
+    }
+}
+
+int BotPlayer::randomInt(int min, int max) {
+    std::uniform_int_distribution<> distr(min, max);
+    return distr(rng);
+}
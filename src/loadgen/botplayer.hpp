@@ -0,0 +1,59 @@
+//
+// Created by Connor on 19/10/2026.
+//
+
+#ifndef TERMINAL_RPG_BOTPLAYER_HPP
+#define TERMINAL_RPG_BOTPLAYER_HPP
+
+#include <random>
+#include <string>
+
+enum class BotPolicy { AGGRESSIVE, DEFENSIVE, MERCHANT_HEAVY, COUNT };
+
+const char* getBotPolicyName(BotPolicy policy);
+bool parseBotPolicy(const std::string& name, BotPolicy& policy);
+
+// Plays the game by reading the text frames the game sends, exactly like a person at the
+// terminal would, so it works over the real wire protocol.
+// - Aggressive: power attacks whenever it can, always opens chests, never trades
+// - Defensive: defends on low stamina, drinks potions on low health, leaves chests alone
+// - Merchant-heavy: fights plainly but buys and sells at every merchant it meets
+class BotPlayer {
+public:
+    BotPlayer(BotPolicy policy, unsigned int seed, unsigned int continuesPerGame);
+
+    // Starts over for a new game (e.g. after reconnecting)
+    void reset();
+
+    // Works out the line to send for a frame. Returns false if the frame ends in a prompt the
+    // bot doesn't recognise (the game got out of sync with what the bot expected).
+    bool chooseAnswer(const std::string& frame, std::string& answer);
+
+    // True once a frame has ended the game (the server hangs up after it)
+    bool isGameOver() const;
+
+    BotPolicy getPolicy() const;
+
+private:
+    BotPolicy policy;
+    std::mt19937 rng;
+    unsigned int continuesPerGame;
+    unsigned int continuesLeft;
+    unsigned int merchantActions;
+    int merchantStock;    // Items left on the current merchant's list
+    int powerAttackCost;  // Learned from the game when a power attack is refused
+    bool hasPotions;      // Best guess, reset when the game says there are none
+    bool gameOver;
+
+    std::string chooseCombatAction(const std::string& frame);
+    std::string chooseMerchantAction();
+    int randomInt(int min, int max);
+};
+
+// "Label: current/max" pair from the last occurrence of the label in a frame; false if absent
+bool parseFrameStat(const std::string& frame, const std::string& label, int& current, int& max);
+
+// Number of "N. ..." options listed after the last occurrence of header in a frame
+int countFrameOptions(const std::string& frame, const std::string& header);
+
+#endif  // TERMINAL_RPG_BOTPLAYER_HPP
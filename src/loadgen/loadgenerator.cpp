@@ -0,0 +1,467 @@
+//
+// Created by Connor on 19/10/2026.
+//
+
+#include "loadgenerator.hpp"
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <thread>
+
+namespace {
+using Clock = std::chrono::steady_clock;
+
+constexpr int MAX_EVENTS = 256;
+constexpr int TICK_MILLISECONDS = 10;  // How often workers connect newly ramped clients
+constexpr char FRAME_TERMINATOR = '\0';
+
+double toMicroseconds(uint64_t nanoseconds) { return static_cast<double>(nanoseconds) / 1000.0; }
+
+double secondsSince(Clock::time_point start) {
+    return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+uint64_t packEventData(size_t clientIndex, uint32_t generation) {
+    return (static_cast<uint64_t>(generation) << 32) | static_cast<uint32_t>(clientIndex);
+}
+}  // namespace
+
+LoadGenConfig::LoadGenConfig()
+    : socketPath("/tmp/terminal_rpg.sock"),
+      tcpPort(0),
+      clients(100),
+      threads(1),
+      rampSeconds(5.0),
+      durationSeconds(20.0),
+      reportIntervalSeconds(1.0),
+      policies{BotPolicy::AGGRESSIVE, BotPolicy::DEFENSIVE, BotPolicy::MERCHANT_HEAVY},
+      continuesPerGame(20),
+      seed(1) {}
+
+LoadGenReport::LoadGenReport()
+    : turns(0),
+      gamesCompleted(0),
+      connectErrors(0),
+      disconnectErrors(0),
+      protocolErrors(0),
+      elapsedSeconds(0.0) {}
+
+void LoadGenReport::merge(const LoadGenReport& other) {
+    turns += other.turns;
+    gamesCompleted += other.gamesCompleted;
+    connectErrors += other.connectErrors;
+    disconnectErrors += other.disconnectErrors;
+    protocolErrors += other.protocolErrors;
+    elapsedSeconds = std::max(elapsedSeconds, other.elapsedSeconds);
+    turnLatency.merge(other.turnLatency);
+    for (size_t i = 0; i < policyLatency.size(); ++i) {
+        policyLatency[i].merge(other.policyLatency[i]);
+    }
+}
+
+uint64_t LoadGenReport::getErrorCount() const {
+    return connectErrors + disconnectErrors + protocolErrors;
+}
+
+double LoadGenReport::getTurnsPerSecond() const {
+    return elapsedSeconds > 0.0 ? static_cast<double>(turns) / elapsedSeconds : 0.0;
+}
+
+std::string LoadGenReport::format() const {
+    std::ostringstream out;
+    out << std::fixed << std::setprecision(1);
+    out << "Turns: " << turns << " in " << elapsedSeconds << "s (" << getTurnsPerSecond()
+        << " turns/sec)\n";
+    out << "Games completed: " << gamesCompleted << '\n';
+    out << "Errors: " << getErrorCount() << " (connect " << connectErrors << ", disconnect "
+        << disconnectErrors << ", protocol " << protocolErrors << ")\n";
+
+    out << "Turn latency (microseconds, line sent to frame received)\n";
+    out << std::left << std::setw(12) << "policy" << std::right << std::setw(10) << "turns"
+        << std::setw(11) << "p50" << std::setw(11) << "p99" << std::setw(11) << "p999"
+        << std::setw(11) << "max" << '\n';
+    auto printRow = [&out](const char* name, const LatencyHistogram& histogram) {
+        out << std::left << std::setw(12) << name << std::right << std::setw(10)
+            << histogram.getCount() << std::setw(11)
+            << toMicroseconds(histogram.getValueAtPercentile(50.0)) << std::setw(11)
+            << toMicroseconds(histogram.getValueAtPercentile(99.0)) << std::setw(11)
+            << toMicroseconds(histogram.getValueAtPercentile(99.9)) << std::setw(11)
+            << toMicroseconds(histogram.getMax()) << '\n';
+    };
+    for (size_t i = 0; i < policyLatency.size(); ++i) {
+        if (policyLatency[i].getCount() == 0) continue;
+        printRow(getBotPolicyName(static_cast<BotPolicy>(i)), policyLatency[i]);
+    }
+    printRow("all", turnLatency);
+    return out.str();
+}
+
+// One thread's share of the clients, all driven from a single epoll loop
+class LoadWorker {
+public:
+    LoadWorker(const LoadGenConfig& config, unsigned int index)
+        : config(config), epollFd(-1), stopping(false), connectedClients(0), intervalTurns(0) {
+        for (unsigned int id = index; id < config.clients; id += config.threads) {
+            BotPolicy policy = config.policies[id % config.policies.size()];
+            clients.push_back(Client{id, -1, 0, BotPlayer(policy, config.seed + id,
+                                                           config.continuesPerGame),
+                                     {}, {}, 0, false, false, {}});
+        }
+    }
+
+    ~LoadWorker() {
+        join();
+        for (Client& client : clients) {
+            if (client.fd >= 0) ::close(client.fd);
+        }
+        if (epollFd >= 0) ::close(epollFd);
+    }
+
+    bool open(std::string& error) {
+        epollFd = epoll_create1(EPOLL_CLOEXEC);
+        if (epollFd < 0) {
+            error = std::string("epoll_create1: ") + std::strerror(errno);
+            return false;
+        }
+        return true;
+    }
+
+    void start(Clock::time_point begin) {
+        thread = std::thread([this, begin] { loop(begin); });
+    }
+
+    void requestStop() { stopping.store(true); }
+
+    void join() {
+        if (thread.joinable()) thread.join();
+    }
+
+    unsigned int getConnectedClients() const { return connectedClients.load(); }
+
+    // Hands over the latency samples and turn count gathered since the last call
+    void takeInterval(LatencyHistogram& latency, uint64_t& turns, uint64_t& errors) {
+        std::lock_guard<std::mutex> lock(statsMutex);
+        latency.merge(intervalLatency);
+        intervalLatency.reset();
+        turns += intervalTurns;
+        intervalTurns = 0;
+        errors += report.getErrorCount();
+    }
+
+    // Only valid after join()
+    const LoadGenReport& getReport() const { return report; }
+
+private:
+    struct Client {
+        unsigned int id;
+        int fd;
+        uint32_t generation;
+        BotPlayer bot;
+        std::string input;
+        std::string output;
+        size_t outputOffset;
+        bool connecting;
+        bool awaitingReply;
+        Clock::time_point sentAt;
+    };
+
+    const LoadGenConfig& config;
+    int epollFd;
+    std::thread thread;
+    std::atomic<bool> stopping;
+    std::atomic<unsigned int> connectedClients;
+    std::vector<Client> clients;
+
+    std::mutex statsMutex;  // Guards report and the interval figures while running
+    LoadGenReport report;
+    LatencyHistogram intervalLatency;
+    uint64_t intervalTurns;
+
+    void loop(Clock::time_point begin) {
+        epoll_event events[MAX_EVENTS];
+        while (!stopping.load()) {
+            double elapsed = secondsSince(begin);
+            unsigned int target = config.clients;
+            if (config.rampSeconds > 0.0 && elapsed < config.rampSeconds) {
+                target = static_cast<unsigned int>(config.clients * elapsed / config.rampSeconds);
+            }
+            for (size_t i = 0; i < clients.size(); ++i) {
+                if (clients[i].id < target && clients[i].fd < 0) connectClient(i);
+            }
+
+            int count = epoll_wait(epollFd, events, MAX_EVENTS, TICK_MILLISECONDS);
+            for (int i = 0; i < count; ++i) {
+                size_t index = static_cast<size_t>(events[i].data.u64 & 0xffffffffu);
+                uint32_t generation = static_cast<uint32_t>(events[i].data.u64 >> 32);
+                Client& client = clients[index];
+                if (client.fd < 0 || client.generation != generation) continue;
+
+                if (client.connecting) {
+                    finishConnect(client);
+                    continue;
+                }
+                if (events[i].events & (EPOLLIN | EPOLLHUP | EPOLLERR)) {
+                    if (!readFrom(client)) continue;
+                }
+                if (events[i].events & EPOLLOUT) {
+                    flush(client);
+                }
+            }
+        }
+
+        std::lock_guard<std::mutex> lock(statsMutex);
+        report.elapsedSeconds = secondsSince(begin);
+    }
+
+    void connectClient(size_t index) {
+        Client& client = clients[index];
+        int fd;
+        int result;
+        if (config.tcpPort != 0) {
+            fd = ::socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+            sockaddr_in address{};
+            address.sin_family = AF_INET;
+            address.sin_port = htons(static_cast<uint16_t>(config.tcpPort));
+            address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+            int enable = 1;
+            setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &enable, sizeof(enable));
+            result = ::connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address));
+        } else {
+            fd = ::socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+            sockaddr_un address{};
+            address.sun_family = AF_UNIX;
+            std::strncpy(address.sun_path, config.socketPath.c_str(),
+                         sizeof(address.sun_path) - 1);
+            result = ::connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address));
+        }
+
+        if (result < 0 && errno != EINPROGRESS) {
+            // Refused or backlog full; retried on the next tick
+            ::close(fd);
+            countError(report.connectErrors);
+            return;
+        }
+
+        client.fd = fd;
+        client.generation++;
+        client.connecting = result < 0;
+        client.bot.reset();
+        client.input.clear();
+        client.output.clear();
+        client.outputOffset = 0;
+        client.awaitingReply = false;
+
+        epoll_event event{};
+        event.events = client.connecting ? EPOLLOUT : EPOLLIN;
+        event.data.u64 = packEventData(index, client.generation);
+        epoll_ctl(epollFd, EPOLL_CTL_ADD, fd, &event);
+        if (!client.connecting) connectedClients.fetch_add(1);
+    }
+
+    void finishConnect(Client& client) {
+        int socketError = 0;
+        socklen_t length = sizeof(socketError);
+        getsockopt(client.fd, SOL_SOCKET, SO_ERROR, &socketError, &length);
+        if (socketError != 0) {
+            countError(report.connectErrors);
+            closeClient(client);
+            return;
+        }
+        client.connecting = false;
+        connectedClients.fetch_add(1);
+        watch(client, false);
+    }
+
+    // Returns false if the client was closed
+    bool readFrom(Client& client) {
+        char buffer[4096];
+        while (true) {
+            ssize_t received = ::recv(client.fd, buffer, sizeof(buffer), 0);
+            if (received > 0) {
+                client.input.append(buffer, static_cast<size_t>(received));
+                continue;
+            }
+            if (received < 0 && errno == EINTR) continue;
+            if (received < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) break;
+
+            // The server hung up: expected only once the game is over
+            handleFrames(client);
+            if (client.fd < 0) return false;
+            if (client.bot.isGameOver()) {
+                std::lock_guard<std::mutex> lock(statsMutex);
+                report.gamesCompleted++;
+            } else {
+                countError(report.disconnectErrors);
+            }
+            closeClient(client);
+            return false;
+        }
+        handleFrames(client);
+        return client.fd >= 0;
+    }
+
+    void handleFrames(Client& client) {
+        size_t frameStart = 0;
+        size_t terminator;
+        while (client.fd >= 0 &&
+               (terminator = client.input.find(FRAME_TERMINATOR, frameStart)) !=
+                   std::string::npos) {
+            handleFrame(client, client.input.substr(frameStart, terminator - frameStart));
+            frameStart = terminator + 1;
+        }
+        if (client.fd >= 0) client.input.erase(0, frameStart);
+    }
+
+    void handleFrame(Client& client, const std::string& frame) {
+        Clock::time_point now = Clock::now();
+        if (client.awaitingReply) {
+            client.awaitingReply = false;
+            uint64_t latency = static_cast<uint64_t>(
+                std::chrono::duration_cast<std::chrono::nanoseconds>(now - client.sentAt)
+                    .count());
+            std::lock_guard<std::mutex> lock(statsMutex);
+            report.turns++;
+            report.turnLatency.record(latency);
+            report.policyLatency[static_cast<size_t>(client.bot.getPolicy())].record(latency);
+            intervalLatency.record(latency);
+            intervalTurns++;
+        }
+
+        std::string answer;
+        if (!client.bot.chooseAnswer(frame, answer)) {
+            countError(report.protocolErrors);
+            closeClient(client);
+            return;
+        }
+        if (client.bot.isGameOver()) return;  // Wait for the server to hang up
+
+        client.output.append(answer);
+        client.output.push_back('\n');
+        client.sentAt = now;
+        client.awaitingReply = true;
+        flush(client);
+    }
+
+    void flush(Client& client) {
+        while (client.outputOffset < client.output.size()) {
+            ssize_t sent = ::send(client.fd, client.output.data() + client.outputOffset,
+                                  client.output.size() - client.outputOffset, MSG_NOSIGNAL);
+            if (sent > 0) {
+                client.outputOffset += static_cast<size_t>(sent);
+                continue;
+            }
+            if (sent < 0 && errno == EINTR) continue;
+            if (sent < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+                watch(client, true);
+                return;
+            }
+            countError(report.disconnectErrors);
+            closeClient(client);
+            return;
+        }
+        client.output.clear();
+        client.outputOffset = 0;
+    }
+
+    void watch(Client& client, bool writable) {
+        epoll_event event{};
+        event.events = static_cast<uint32_t>(EPOLLIN);
+        if (writable) event.events |= static_cast<uint32_t>(EPOLLOUT);
+        event.data.u64 = packEventData(static_cast<size_t>(&client - clients.data()),
+                                       client.generation);
+        epoll_ctl(epollFd, EPOLL_CTL_MOD, client.fd, &event);
+    }
+
+    void closeClient(Client& client) {
+        if (client.fd < 0) return;
+        if (!client.connecting) connectedClients.fetch_sub(1);
+        epoll_ctl(epollFd, EPOLL_CTL_DEL, client.fd, nullptr);
+        ::close(client.fd);
+        client.fd = -1;
+        client.connecting = false;
+    }
+
+    void countError(uint64_t& counter) {
+        std::lock_guard<std::mutex> lock(statsMutex);
+        counter++;
+    }
+};
+
+LoadGenerator::LoadGenerator(const LoadGenConfig& config) : config(config) {}
+
+LoadGenerator::~LoadGenerator() = default;
+
+bool LoadGenerator::run(std::string& error, std::ostream& progress) {
+    if (config.clients == 0 || config.policies.empty() || config.reportIntervalSeconds <= 0.0) {
+        error = "need at least one client, one policy and a positive report interval";
+        return false;
+    }
+    config.threads = std::max(1u, std::min(config.threads, config.clients));
+
+    std::vector<std::unique_ptr<LoadWorker>> workers;
+    for (unsigned int i = 0; i < config.threads; ++i) {
+        workers.push_back(std::make_unique<LoadWorker>(config, i));
+        if (!workers.back()->open(error)) return false;
+    }
+
+    Clock::time_point begin = Clock::now();
+    for (auto& worker : workers) {
+        worker->start(begin);
+    }
+
+    progress << std::fixed << std::setprecision(1);
+    auto interval = std::chrono::duration<double>(config.reportIntervalSeconds);
+    Clock::time_point nextReport = begin;
+    Clock::time_point lastReport = begin;
+    Clock::time_point end = begin + std::chrono::duration_cast<Clock::duration>(
+                                        std::chrono::duration<double>(config.durationSeconds));
+    while (Clock::now() < end) {
+        nextReport += std::chrono::duration_cast<Clock::duration>(interval);
+        std::this_thread::sleep_until(std::min(nextReport, end));
+
+        LatencyHistogram latency;
+        uint64_t turns = 0;
+        uint64_t errors = 0;
+        unsigned int connected = 0;
+        for (auto& worker : workers) {
+            worker->takeInterval(latency, turns, errors);
+            connected += worker->getConnectedClients();
+        }
+        double span = secondsSince(lastReport);
+        lastReport = Clock::now();
+        progress << "[" << std::setw(6) << secondsSince(begin) << "s] clients " << connected
+                 << "/" << config.clients << "  turns/s "
+                 << (span > 0.0 ? static_cast<double>(turns) / span : 0.0) << "  p50 "
+                 << toMicroseconds(latency.getValueAtPercentile(50.0)) << "us  p99 "
+                 << toMicroseconds(latency.getValueAtPercentile(99.0)) << "us  errors "
+                 << errors << '\n'
+                 << std::flush;
+    }
+
+    for (auto& worker : workers) {
+        worker->requestStop();
+    }
+    report = LoadGenReport();
+    for (auto& worker : workers) {
+        worker->join();
+        report.merge(worker->getReport());
+    }
+    return true;
+}
+
+const LoadGenReport& LoadGenerator::getReport() const { return report; }
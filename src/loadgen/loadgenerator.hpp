@@ -0,0 +1,72 @@
+//
+// Created by Connor on 19/10/2026.
+//
+
+#ifndef TERMINAL_RPG_LOADGENERATOR_HPP
+#define TERMINAL_RPG_LOADGENERATOR_HPP
+
+#include <array>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "../metrics/latencyhistogram.hpp"
+#include "botplayer.hpp"
+
+struct LoadGenConfig {
+    std::string socketPath;  // Unix domain socket, used when tcpPort is 0
+    int tcpPort;             // 127.0.0.1 TCP port
+    unsigned int clients;
+    unsigned int threads;
+    double rampSeconds;      // Clients are connected gradually over this long
+    double durationSeconds;  // Total run time, ramp included
+    double reportIntervalSeconds;
+    std::vector<BotPolicy> policies;  // Handed out to clients round-robin
+    unsigned int continuesPerGame;
+    unsigned int seed;
+
+    LoadGenConfig();
+};
+
+struct LoadGenReport {
+    uint64_t turns;  // Lines answered by the server
+    uint64_t gamesCompleted;
+    uint64_t connectErrors;
+    uint64_t disconnectErrors;  // Server hung up mid-game
+    uint64_t protocolErrors;    // Frame ended in a prompt the bot didn't recognise
+    double elapsedSeconds;
+    LatencyHistogram turnLatency;  // Nanoseconds from line sent to full frame received
+    std::array<LatencyHistogram, static_cast<size_t>(BotPolicy::COUNT)> policyLatency;
+
+    LoadGenReport();
+    void merge(const LoadGenReport& other);
+    uint64_t getErrorCount() const;
+    double getTurnsPerSecond() const;
+
+    // Summary table: throughput, latency percentiles (microseconds) and error counts
+    std::string format() const;
+};
+
+// Drives a game server with many bot clients over the real wire protocol. Each client plays
+// full games and reconnects when one ends. Clients are spread over a few threads, each running
+// its own epoll loop, so the generator itself stays cheap compared with the server under test.
+class LoadGenerator {
+public:
+    explicit LoadGenerator(const LoadGenConfig& config);
+    ~LoadGenerator();
+
+    LoadGenerator(const LoadGenerator&) = delete;
+    LoadGenerator& operator=(const LoadGenerator&) = delete;
+
+    // Runs for durationSeconds, printing a progress line every reportIntervalSeconds
+    bool run(std::string& error, std::ostream& progress);
+
+    const LoadGenReport& getReport() const;
+
+private:
+    LoadGenConfig config;
+    LoadGenReport report;
+};
+
+#endif  // TERMINAL_RPG_LOADGENERATOR_HPP
@@ -0,0 +1,105 @@
+#include <csignal>
+#include <cstdlib>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+#include "loadgen/loadgenerator.hpp"
+
+// Function declarations
+bool parseArguments(int argc, char* argv[], LoadGenConfig& config);
+bool parsePolicyList(const std::string& list, std::vector<BotPolicy>& policies);
+void printUsage(const char* program);
+
+int main(int argc, char* argv[]) {
+    LoadGenConfig config;
+    if (!parseArguments(argc, argv, config)) {
+        printUsage(argv[0]);
+        return 1;
+    }
+    std::signal(SIGPIPE, SIG_IGN);
+
+    std::string target = config.tcpPort != 0
+                             ? "tcp:127.0.0.1:" + std::to_string(config.tcpPort)
+                             : "unix:" + config.socketPath;
+    std::cout << "Driving " << target << " with " << config.clients << " client(s) on "
+              << config.threads << " thread(s), ramping over " << config.rampSeconds << "s for "
+              << config.durationSeconds << "s\n";
+
+    LoadGenerator generator(config);
+    std::string error;
+    if (!generator.run(error, std::cout)) {
+        std::cerr << "Load generation failed: " << error << '\n';
+        return 1;
+    }
+
+    std::cout << '\n' << generator.getReport().format();
+    return 0;
+}
+
+bool parseArguments(int argc, char* argv[], LoadGenConfig& config) {
+    for (int i = 1; i < argc; ++i) {
+        std::string argument = argv[i];
+        if (i + 1 >= argc) return false;
+        std::string value = argv[++i];
+
+        if (argument == "--socket") {
+            config.socketPath = value;
+        } else if (argument == "--port") {
+            config.tcpPort = std::atoi(value.c_str());
+            if (config.tcpPort <= 0 || config.tcpPort > 65535) return false;
+        } else if (argument == "--clients") {
+            config.clients = static_cast<unsigned int>(std::strtoul(value.c_str(), nullptr, 10));
+            if (config.clients == 0) return false;
+        } else if (argument == "--threads") {
+            config.threads = static_cast<unsigned int>(std::strtoul(value.c_str(), nullptr, 10));
+            if (config.threads == 0) return false;
+        } else if (argument == "--ramp") {
+            config.rampSeconds = std::atof(value.c_str());
+        } else if (argument == "--duration") {
+            config.durationSeconds = std::atof(value.c_str());
+            if (config.durationSeconds <= 0.0) return false;
+        } else if (argument == "--interval") {
+            config.reportIntervalSeconds = std::atof(value.c_str());
+            if (config.reportIntervalSeconds <= 0.0) return false;
+        } else if (argument == "--policy") {
+            if (!parsePolicyList(value, config.policies)) return false;
+        } else if (argument == "--continues") {
+            config.continuesPerGame =
+                static_cast<unsigned int>(std::strtoul(value.c_str(), nullptr, 10));
+        } else if (argument == "--seed") {
+            config.seed = static_cast<unsigned int>(std::strtoul(value.c_str(), nullptr, 10));
+        } else {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool parsePolicyList(const std::string& list, std::vector<BotPolicy>& policies) {
+    policies.clear();
+    std::istringstream stream(list);
+    std::string name;
+    while (std::getline(stream, name, ',')) {
+        BotPolicy policy;
+        if (!parseBotPolicy(name, policy)) return false;
+        policies.push_back(policy);
+    }
+    return !policies.empty();
+}
+
+void printUsage(const char* program) {
+    std::cerr << "Usage: " << program << " [options]\n"
+              << "  --socket PATH     Server's Unix domain socket\n"
+              << "                    (default /tmp/terminal_rpg.sock)\n"
+              << "  --port N          Connect to 127.0.0.1:N instead of the Unix socket\n"
+              << "  --clients N       Concurrent bot clients (default 100)\n"
+              << "  --threads N       Client threads (default 1)\n"
+              << "  --ramp SECONDS    Connect clients gradually over this long (default 5)\n"
+              << "  --duration SECONDS  Total run time, ramp included (default 20)\n"
+              << "  --interval SECONDS  Progress report interval (default 1)\n"
+              << "  --policy LIST     Comma separated mix of aggressive, defensive, merchant\n"
+              << "                    (default aggressive,defensive,merchant)\n"
+              << "  --continues N     Adventures per game before quitting (default 20)\n"
+              << "  --seed N          Base seed for the bots' choices (default 1)\n";
+}
@@ -0,0 +1,399 @@
+//
+// Created by Connor on 19/10/2026.
+//
+
+#include "loottable.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+
+#include "../items/itemdatabase.hpp"
+
+LootEntry LootEntry::item(const std::string& itemName, double weight) {
+    return {LootEntryKind::ITEM, itemName, MISC, weight};
+}
+
+LootEntry LootEntry::ofType(ItemType type, double weight) {
+    return {LootEntryKind::ITEM_TYPE, "", type, weight};
+}
+
+LootEntry LootEntry::table(const std::string& tableName, double weight) {
+    return {LootEntryKind::TABLE, tableName, MISC, weight};
+}
+
+LootEntry LootEntry::nothing(double weight) {
+    return {LootEntryKind::NOTHING, "", MISC, weight};
+}
+
+// LootTable implementation
+LootTable::LootTable(const std::string& name) : name(name) {}
+
+bool LootTable::build(const std::vector<std::pair<const ItemTemplate*, double>>& weightedOutcomes) {
+    items.clear();
+    probabilities.clear();
+    double total = 0.0;
+    for (const auto& outcome : weightedOutcomes) {
+        if (!(outcome.second > 0.0) || !std::isfinite(outcome.second)) continue;
+        items.push_back(outcome.first);
+        probabilities.push_back(outcome.second);
+        total += outcome.second;
+    }
+    if (items.empty() || items.size() >= NO_ITEM) {
+        items.clear();
+        probabilities.clear();
+        thresholds.clear();
+        aliases.clear();
+        return false;
+    }
+    for (double& probability : probabilities) probability /= total;
+
+    // Vose's alias method: every column holds its own outcome up to a threshold and
+    // tops up from exactly one larger outcome
+    size_t count = items.size();
+    thresholds.assign(count, UINT32_MAX);
+    aliases.resize(count);
+    std::vector<double> scaled(count);
+    std::vector<uint32_t> small;
+    std::vector<uint32_t> large;
+    for (size_t i = 0; i < count; ++i) {
+        scaled[i] = probabilities[i] * static_cast<double>(count);
+        aliases[i] = static_cast<uint32_t>(i);
+        (scaled[i] < 1.0 ? small : large).push_back(static_cast<uint32_t>(i));
+    }
+    while (!small.empty() && !large.empty()) {
+        uint32_t less = small.back();
+        small.pop_back();
+        uint32_t more = large.back();
+        large.pop_back();
+
+        thresholds[less] = static_cast<uint32_t>(scaled[less] * 4294967296.0);
+        aliases[less] = more;
+        scaled[more] = (scaled[more] + scaled[less]) - 1.0;
+        (scaled[more] < 1.0 ? small : large).push_back(more);
+    }
+    // Whatever is left is full up to rounding error, so it always keeps its own outcome
+    return true;
+}
+
+const std::string& LootTable::getName() const { return name; }
+
+size_t LootTable::getOutcomeCount() const { return items.size(); }
+
+const ItemTemplate* LootTable::getOutcome(size_t outcome) const {
+    return outcome < items.size() ? items[outcome] : nullptr;
+}
+
+double LootTable::getProbability(size_t outcome) const {
+    return outcome < probabilities.size() ? probabilities[outcome] : 0.0;
+}
+
+size_t LootTable::pick(uint32_t column, uint32_t coin) const {
+    return coin < thresholds[column] || aliases[column] == column ? column : aliases[column];
+}
+
+size_t LootTable::drawIndex(std::mt19937& rng) const {
+    if (items.empty()) return NO_ITEM;
+    uint32_t column = static_cast<uint32_t>((static_cast<uint64_t>(rng()) * items.size()) >> 32);
+    return pick(column, static_cast<uint32_t>(rng()));
+}
+
+const ItemTemplate* LootTable::draw(std::mt19937& rng) const {
+    size_t outcome = drawIndex(rng);
+    return outcome == NO_ITEM ? nullptr : items[outcome];
+}
+
+void LootTable::drawBatch(std::mt19937& rng, uint32_t* outcomes, size_t count) const {
+    if (items.empty()) {
+        for (size_t i = 0; i < count; ++i) outcomes[i] = NO_ITEM;
+        return;
+    }
+    // Random numbers are generated a block at a time so the lookup loop stays tight
+    constexpr size_t BLOCK = 256;
+    uint32_t columns[BLOCK];
+    uint32_t coins[BLOCK];
+    uint64_t outcomeCount = items.size();
+    for (size_t start = 0; start < count; start += BLOCK) {
+        size_t block = std::min(BLOCK, count - start);
+        for (size_t i = 0; i < block; ++i) {
+            columns[i] = static_cast<uint32_t>((static_cast<uint64_t>(rng()) * outcomeCount) >> 32);
+            coins[i] = static_cast<uint32_t>(rng());
+        }
+        for (size_t i = 0; i < block; ++i) {
+            outcomes[start + i] = static_cast<uint32_t>(pick(columns[i], coins[i]));
+        }
+    }
+}
+
+// LootTableDatabase implementation
+LootTableDatabase& LootTableDatabase::getInstance() {
+    static LootTableDatabase instance;
+    return instance;
+}
+
+void LootTableDatabase::initialize() {
+    definitions.clear();
+    createChestTables();
+    createEnemyDropTables();
+    compileAll();
+}
+
+bool LootTableDatabase::addTable(const LootTableDefinition& definition) {
+    auto previous = definitions.find(definition.name);
+    bool replacing = previous != definitions.end();
+    LootTableDefinition old = replacing ? previous->second : LootTableDefinition{};
+
+    definitions[definition.name] = definition;
+    if (compileAll()) return true;
+
+    // Put things back the way they were
+    if (replacing) {
+        definitions[definition.name] = old;
+    } else {
+        definitions.erase(definition.name);
+    }
+    return false;
+}
+
+const LootTable* LootTableDatabase::getTable(const std::string& tableName) const {
+    auto it = tables.find(tableName);
+    return (it != tables.end()) ? it->second.get() : nullptr;
+}
+
+const LootTable* LootTableDatabase::getChestTable(ChestTier tier) const {
+    return getTable(getChestTableName(tier));
+}
+
+ChestTier LootTableDatabase::getChestTierForLevel(int playerLevel) {
+    if (playerLevel >= 10) return ChestTier::GOLDEN;
+    if (playerLevel >= 5) return ChestTier::IRON;
+    return ChestTier::WOODEN;
+}
+
+const char* LootTableDatabase::getChestTableName(ChestTier tier) {
+    switch (tier) {
+        case ChestTier::WOODEN:
+            return "Wooden Chest";
+        case ChestTier::IRON:
+            return "Iron Chest";
+        case ChestTier::GOLDEN:
+            return "Golden Chest";
+    }
+    return "Wooden Chest";
+}
+
+const LootTable* LootTableDatabase::getEnemyDropTable(EnemyType type, EnemyRarity rarity) const {
+    return enemyDropTables[static_cast<size_t>(type) * ENEMY_RARITY_COUNT +
+                           static_cast<size_t>(rarity)];
+}
+
+int LootTableDatabase::getDropRolls(EnemyRarity rarity) {
+    switch (rarity) {
+        case EnemyRarity::COMMON:
+        case EnemyRarity::UNCOMMON:
+            return 1;
+        case EnemyRarity::RARE:
+        case EnemyRarity::EPIC:
+            return 2;
+        case EnemyRarity::LEGENDARY:
+            return 3;
+        case EnemyRarity::BOSS:
+            return MAX_DROP_ROLLS;
+    }
+    return 1;
+}
+
+std::string LootTableDatabase::getEnemyDropTableName(EnemyType type, EnemyRarity rarity) {
+    static const char* const typeNames[ENEMY_TYPE_COUNT] = {
+        "Beast", "Undead", "Humanoid", "Dragon", "Elemental", "Demon", "Goblinoid"};
+    static const char* const rarityNames[ENEMY_RARITY_COUNT] = {
+        "Common", "Uncommon", "Rare", "Epic", "Legendary", "Boss"};
+    return std::string(typeNames[static_cast<size_t>(type)]) + " Drops (" +
+           rarityNames[static_cast<size_t>(rarity)] + ")";
+}
+
+int LootTableDatabase::rollEnemyDrops(EnemyType type, EnemyRarity rarity, std::mt19937& rng,
+                                      const ItemTemplate** drops) const {
+    const LootTable* table = getEnemyDropTable(type, rarity);
+    if (!table) return 0;
+    int dropCount = 0;
+    for (int roll = getDropRolls(rarity); roll > 0; --roll) {
+        const ItemTemplate* drop = table->draw(rng);
+        if (drop) drops[dropCount++] = drop;
+    }
+    return dropCount;
+}
+
+bool LootTableDatabase::compileAll() {
+    // Nothing changes unless every table compiles
+    std::map<std::string, std::unique_ptr<LootTable>> compiled;
+    for (const auto& pair : definitions) {
+        std::vector<std::pair<const ItemTemplate*, double>> outcomes;
+        std::set<std::string> visiting;
+        auto table = std::make_unique<LootTable>(pair.first);
+        if (!expand(pair.first, 1.0, visiting, outcomes) || !table->build(outcomes)) {
+            return false;
+        }
+        compiled[pair.first] = std::move(table);
+    }
+
+    for (auto it = tables.begin(); it != tables.end();) {
+        it = compiled.count(it->first) ? std::next(it) : tables.erase(it);
+    }
+    for (auto& pair : compiled) {
+        // Rebuild in place so table pointers held elsewhere stay valid
+        auto existing = tables.find(pair.first);
+        if (existing != tables.end()) {
+            *existing->second = std::move(*pair.second);
+        } else {
+            tables[pair.first] = std::move(pair.second);
+        }
+    }
+
+    // Flat lookup so a kill doesn't need a name lookup
+    for (size_t type = 0; type < ENEMY_TYPE_COUNT; ++type) {
+        for (size_t rarity = 0; rarity < ENEMY_RARITY_COUNT; ++rarity) {
+            enemyDropTables[type * ENEMY_RARITY_COUNT + rarity] = getTable(getEnemyDropTableName(
+                static_cast<EnemyType>(type), static_cast<EnemyRarity>(rarity)));
+        }
+    }
+    return true;
+}
+
+bool LootTableDatabase::expand(
+    const std::string& tableName, double share, std::set<std::string>& visiting,
+    std::vector<std::pair<const ItemTemplate*, double>>& outcomes) const {
+    auto it = definitions.find(tableName);
+    if (it == definitions.end()) return false;
+    if (!visiting.insert(tableName).second) return false;  // Table contains itself
+    const LootTableDefinition& definition = it->second;
+    const ItemDatabase& itemDatabase = ItemDatabase::getInstance();
+
+    // Resolve type groups first, so an empty group doesn't take a share of the rolls
+    std::vector<std::vector<std::pair<const ItemTemplate*, double>>> groups(
+        definition.entries.size());
+    double total = 0.0;
+    for (size_t i = 0; i < definition.entries.size(); ++i) {
+        const LootEntry& entry = definition.entries[i];
+        if (!(entry.weight > 0.0)) continue;
+        if (entry.kind == LootEntryKind::ITEM_TYPE) {
+            double groupWeight = 0.0;
+            for (const std::string& itemName : itemDatabase.getItemsByType(entry.itemType)) {
+                const ItemTemplate* itemTemplate = itemDatabase.getItemTemplate(itemName);
+                double weight = definition.rarityWeights[itemTemplate->rarity];
+                if (weight <= 0.0) continue;
+                groups[i].emplace_back(itemTemplate, weight);
+                groupWeight += weight;
+            }
+            if (groupWeight <= 0.0) continue;
+            for (auto& member : groups[i]) member.second /= groupWeight;
+        }
+        total += entry.weight;
+    }
+
+    auto add = [&outcomes](const ItemTemplate* itemTemplate, double weight) {
+        for (auto& outcome : outcomes) {
+            if (outcome.first == itemTemplate) {
+                outcome.second += weight;
+                return;
+            }
+        }
+        outcomes.emplace_back(itemTemplate, weight);
+    };
+
+    bool resolved = true;
+    for (size_t i = 0; i < definition.entries.size() && resolved; ++i) {
+        const LootEntry& entry = definition.entries[i];
+        if (!(entry.weight > 0.0)) continue;
+        if (entry.kind == LootEntryKind::ITEM_TYPE && groups[i].empty()) continue;
+        double entryShare = share * entry.weight / total;
+        switch (entry.kind) {
+            case LootEntryKind::ITEM: {
+                const ItemTemplate* itemTemplate = itemDatabase.getItemTemplate(entry.name);
+                if (!itemTemplate) {
+                    resolved = false;
+                    break;
+                }
+                add(itemTemplate, entryShare);
+                break;
+            }
+            case LootEntryKind::ITEM_TYPE:
+                for (const auto& member : groups[i]) add(member.first, entryShare * member.second);
+                break;
+            case LootEntryKind::TABLE:
+                resolved = expand(entry.name, entryShare, visiting, outcomes);
+                break;
+            case LootEntryKind::NOTHING:
+                add(nullptr, entryShare);
+                break;
+        }
+    }
+
+    visiting.erase(tableName);
+    return resolved;
+}
+
+void LootTableDatabase::createChestTables() {
+    // Wooden chests keep the old item type split but mostly hold common items
+    LootTableDefinition wooden;
+    wooden.name = "Wooden Chest";
+    wooden.entries = {LootEntry::ofType(CURRENCY, 40), LootEntry::ofType(POTION, 25),
+                      LootEntry::ofType(WEAPON, 20), LootEntry::ofType(ARMOR, 10),
+                      LootEntry::ofType(MISC, 5)};
+    wooden.rarityWeights = {100.0, 40.0, 12.0, 3.0, 1.0, 0.25};
+    definitions[wooden.name] = wooden;
+
+    LootTableDefinition iron = wooden;
+    iron.name = "Iron Chest";
+    iron.rarityWeights = {50.0, 50.0, 30.0, 10.0, 3.0, 1.0};
+    definitions[iron.name] = iron;
+
+    // Golden chests roll an iron chest half the time, otherwise gear that leans rare
+    LootTableDefinition golden;
+    golden.name = "Golden Chest";
+    golden.entries = {LootEntry::table("Iron Chest", 50), LootEntry::ofType(WEAPON, 25),
+                      LootEntry::ofType(ARMOR, 25)};
+    golden.rarityWeights = {5.0, 20.0, 40.0, 25.0, 10.0, 5.0};
+    definitions[golden.name] = golden;
+}
+
+void LootTableDatabase::createEnemyDropTables() {
+    // What each kind of enemy tends to carry: currency, potion, weapon, armor, misc
+    static const double typeWeights[ENEMY_TYPE_COUNT][5] = {
+        {20, 40, 0, 10, 30},   // Beast
+        {35, 15, 20, 15, 15},  // Undead
+        {35, 20, 25, 15, 5},   // Humanoid
+        {50, 10, 10, 20, 10},  // Dragon
+        {25, 45, 10, 5, 15},   // Elemental
+        {30, 20, 25, 10, 15},  // Demon
+        {45, 15, 25, 10, 5},   // Goblinoid
+    };
+    // Tougher enemies drop more often and drop rarer items
+    static const double dropChance[ENEMY_RARITY_COUNT] = {0.25, 0.35, 0.45, 0.55, 0.7, 1.0};
+    static const std::array<double, RARITY_COUNT> rarityWeights[ENEMY_RARITY_COUNT] = {
+        {{100.0, 30.0, 5.0, 1.0, 0.2, 0.0}},    // Common
+        {{70.0, 45.0, 12.0, 3.0, 0.5, 0.05}},   // Uncommon
+        {{40.0, 45.0, 25.0, 8.0, 2.0, 0.2}},    // Rare
+        {{20.0, 35.0, 35.0, 15.0, 5.0, 1.0}},   // Epic
+        {{10.0, 20.0, 35.0, 25.0, 10.0, 3.0}},  // Legendary
+        {{0.0, 10.0, 30.0, 35.0, 20.0, 8.0}},   // Boss
+    };
+    static const ItemType itemTypes[5] = {CURRENCY, POTION, WEAPON, ARMOR, MISC};
+
+    for (size_t type = 0; type < ENEMY_TYPE_COUNT; ++type) {
+        for (size_t rarity = 0; rarity < ENEMY_RARITY_COUNT; ++rarity) {
+            LootTableDefinition drops;
+            drops.name = getEnemyDropTableName(static_cast<EnemyType>(type),
+                                               static_cast<EnemyRarity>(rarity));
+            double itemWeight = 0.0;
+            for (size_t i = 0; i < 5; ++i) {
+                drops.entries.push_back(LootEntry::ofType(itemTypes[i], typeWeights[type][i]));
+                itemWeight += typeWeights[type][i];
+            }
+            double chance = dropChance[rarity];
+            drops.entries.push_back(LootEntry::nothing(itemWeight * (1.0 - chance) / chance));
+            drops.rarityWeights = rarityWeights[rarity];
+            definitions[drops.name] = drops;
+        }
+    }
+}
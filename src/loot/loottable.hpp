@@ -0,0 +1,130 @@
+//
+// Created by Connor on 19/10/2026.
+//
+
+#ifndef TERMINAL_RPG_LOOTTABLE_HPP
+#define TERMINAL_RPG_LOOTTABLE_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <random>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "../enemies/enemy.hpp"
+#include "../items/item.hpp"
+
+struct ItemTemplate;
+
+enum class LootEntryKind {
+    ITEM,       // One named item
+    ITEM_TYPE,  // Every item of a type, split by the table's rarity weights
+    TABLE,      // Another loot table
+    NOTHING     // An empty roll
+};
+
+struct LootEntry {
+    LootEntryKind kind;
+    std::string name;  // Item or table name
+    ItemType itemType;
+    double weight;
+
+    static LootEntry item(const std::string& itemName, double weight);
+    static LootEntry ofType(ItemType type, double weight);
+    static LootEntry table(const std::string& tableName, double weight);
+    static LootEntry nothing(double weight);
+};
+
+constexpr size_t RARITY_COUNT = MYTHIC + 1;
+
+struct LootTableDefinition {
+    std::string name;
+    std::vector<LootEntry> entries;
+    // Relative weight of each Rarity inside ITEM_TYPE entries
+    std::array<double, RARITY_COUNT> rarityWeights{1.0, 1.0, 1.0, 1.0, 1.0, 1.0};
+};
+
+// A loot table flattened into a Walker alias table: nested tables and type groups are
+// expanded when it's compiled, so every draw is two random numbers and one lookup
+class LootTable {
+public:
+    static constexpr uint32_t NO_ITEM = UINT32_MAX;
+
+    explicit LootTable(const std::string& name);
+
+    // Outcomes must be unique; weights don't need to be normalised (returns false if all zero)
+    bool build(const std::vector<std::pair<const ItemTemplate*, double>>& weightedOutcomes);
+
+    const std::string& getName() const;
+    size_t getOutcomeCount() const;
+    const ItemTemplate* getOutcome(size_t outcome) const;  // nullptr is an empty roll
+    double getProbability(size_t outcome) const;
+
+    size_t drawIndex(std::mt19937& rng) const;
+    const ItemTemplate* draw(std::mt19937& rng) const;
+    // Fills outcome indices for many rolls at once (no allocation)
+    void drawBatch(std::mt19937& rng, uint32_t* outcomes, size_t count) const;
+
+private:
+    std::string name;
+    std::vector<const ItemTemplate*> items;
+    std::vector<double> probabilities;
+    std::vector<uint32_t> thresholds;  // Keep the column below this, else take the alias
+    std::vector<uint32_t> aliases;
+
+    size_t pick(uint32_t column, uint32_t coin) const;
+};
+
+enum class ChestTier { WOODEN, IRON, GOLDEN };
+
+class LootTableDatabase {
+public:
+    static constexpr int MAX_DROP_ROLLS = 4;
+
+    static LootTableDatabase& getInstance();
+
+    // Builds the built-in tables (needs ItemDatabase to be initialized first)
+    void initialize();
+
+    // Adds or replaces a table definition and recompiles every table. Returns false and
+    // changes nothing if it doesn't compile (unknown names, a table that contains itself)
+    bool addTable(const LootTableDefinition& definition);
+
+    const LootTable* getTable(const std::string& tableName) const;
+    const LootTable* getChestTable(ChestTier tier) const;
+
+    static ChestTier getChestTierForLevel(int playerLevel);
+    static const char* getChestTableName(ChestTier tier);
+
+    // Enemy drops: one table per type and rarity, rolled getDropRolls() times per kill
+    const LootTable* getEnemyDropTable(EnemyType type, EnemyRarity rarity) const;
+    static int getDropRolls(EnemyRarity rarity);
+    static std::string getEnemyDropTableName(EnemyType type, EnemyRarity rarity);
+    // Writes the kill's drops into `drops` (room for MAX_DROP_ROLLS), returns how many
+    int rollEnemyDrops(EnemyType type, EnemyRarity rarity, std::mt19937& rng,
+                       const ItemTemplate** drops) const;
+
+private:
+    LootTableDatabase() = default;
+    ~LootTableDatabase() = default;
+    LootTableDatabase(const LootTableDatabase&) = delete;
+    LootTableDatabase& operator=(const LootTableDatabase&) = delete;
+
+    std::map<std::string, LootTableDefinition> definitions;
+    std::map<std::string, std::unique_ptr<LootTable>> tables;
+    std::array<const LootTable*, ENEMY_TYPE_COUNT * ENEMY_RARITY_COUNT> enemyDropTables{};
+
+    void createChestTables();
+    void createEnemyDropTables();
+    bool compileAll();
+    // Appends the table's outcomes scaled to `share` of the total
+    bool expand(const std::string& tableName, double share, std::set<std::string>& visiting,
+                std::vector<std::pair<const ItemTemplate*, double>>& outcomes) const;
+};
+
+#endif  // TERMINAL_RPG_LOOTTABLE_HPP
@@ -0,0 +1,83 @@
+//
+// Created by Connor on 19/10/2026.
+//
+
+#include "merchant.hpp"
+
+#include <algorithm>
+
+#include "../items/itemdatabase.hpp"
+#include "pricingengine.hpp"
+
+namespace {
+// Rarer items are scarcer on the shelf
+int getMaxQuantity(Rarity rarity) {
+    switch (rarity) {
+        case COMMON:
+            return 3;
+        case UNCOMMON:
+            return 2;
+        default:
+            return 1;
+    }
+}
+}  // namespace
+
+Merchant::Merchant(ItemType specialty, uint64_t now) : specialty(specialty), lastRestock(now) {
+    const ItemDatabase& itemDatabase = ItemDatabase::getInstance();
+    for (const std::string& itemName : itemDatabase.getItemsByType(specialty)) {
+        const ItemTemplate* itemTemplate = itemDatabase.getItemTemplate(itemName);
+        int maxQuantity = getMaxQuantity(itemTemplate->rarity);
+        stock.push_back({itemTemplate, maxQuantity, maxQuantity, itemTemplate->value});
+        stockItems.push_back(itemTemplate);
+    }
+    stockPrices.resize(stock.size());
+}
+
+ItemType Merchant::getSpecialty() const { return specialty; }
+
+const std::vector<MerchantStockEntry>& Merchant::getStock() const { return stock; }
+
+void Merchant::restock(uint64_t now) {
+    if (now <= lastRestock) return;
+    uint64_t steps = (now - lastRestock) / RESTOCK_INTERVAL;
+    if (steps == 0) return;
+    lastRestock += steps * RESTOCK_INTERVAL;
+
+    for (MerchantStockEntry& entry : stock) {
+        if (entry.quantity >= entry.maxQuantity) continue;
+        uint64_t missing = static_cast<uint64_t>(entry.maxQuantity - entry.quantity);
+        entry.quantity += static_cast<int>(std::min(steps, missing));
+    }
+}
+
+void Merchant::updatePrices(const PricingEngine& pricing) {
+    pricing.readPrices(stockItems.data(), stockItems.size(), stockPrices.data());
+    for (size_t i = 0; i < stock.size(); ++i) stock[i].price = stockPrices[i];
+}
+
+Item* Merchant::takeItem(size_t entry, int inventorySlotId) {
+    if (entry >= stock.size() || stock[entry].quantity <= 0) return nullptr;
+    --stock[entry].quantity;
+    return ItemDatabase::getInstance().createItem(*stock[entry].item, inventorySlotId);
+}
+
+bool Merchant::acceptItem(const ItemTemplate& itemTemplate) {
+    for (MerchantStockEntry& entry : stock) {
+        if (entry.item == &itemTemplate) {
+            ++entry.quantity;
+            return true;
+        }
+    }
+    return false;
+}
+
+MerchantRoster::MerchantRoster(uint64_t now) {
+    for (ItemType type : {WEAPON, ARMOR, POTION, CURRENCY, MISC}) {
+        merchants.emplace_back(type, now);
+    }
+}
+
+Merchant& MerchantRoster::getMerchant(ItemType specialty) {
+    return merchants[static_cast<size_t>(specialty)];
+}
@@ -0,0 +1,69 @@
+//
+// Created by Connor on 19/10/2026.
+//
+
+#ifndef TERMINAL_RPG_MERCHANT_HPP
+#define TERMINAL_RPG_MERCHANT_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "../items/item.hpp"
+
+struct ItemTemplate;
+class PricingEngine;
+
+struct MerchantStockEntry {
+    const ItemTemplate* item;
+    int quantity;
+    int maxQuantity;
+    int price;
+};
+
+// A merchant that remembers its stock between visits. Stock is kept as template handles and
+// counts; an Item is only created when the player buys one.
+class Merchant {
+public:
+    // Game time (random events) it takes to restock one unit of every entry
+    static constexpr uint64_t RESTOCK_INTERVAL = 5;
+
+    Merchant(ItemType specialty, uint64_t now);
+
+    ItemType getSpecialty() const;
+    const std::vector<MerchantStockEntry>& getStock() const;
+
+    // Tops each entry up by one unit for every RESTOCK_INTERVAL since the last restock
+    void restock(uint64_t now);
+
+    // Reprices every entry from one pricing snapshot
+    void updatePrices(const PricingEngine& pricing);
+
+    // Creates one unit of the entry for the buyer (nullptr if it's sold out)
+    Item* takeItem(size_t entry, int inventorySlotId);
+
+    // Puts an item the player sold back on the shelf; false if the merchant doesn't stock it
+    bool acceptItem(const ItemTemplate& itemTemplate);
+
+private:
+    ItemType specialty;
+    uint64_t lastRestock;
+    std::vector<MerchantStockEntry> stock;
+    // updatePrices' arguments and results, parallel to stock and sized with it, so repricing
+    // on every visit doesn't allocate
+    std::vector<const ItemTemplate*> stockItems;
+    std::vector<int> stockPrices;
+};
+
+// Every merchant a player can run into, one per item type
+class MerchantRoster {
+public:
+    explicit MerchantRoster(uint64_t now);
+
+    Merchant& getMerchant(ItemType specialty);
+
+private:
+    std::vector<Merchant> merchants;
+};
+
+#endif  // TERMINAL_RPG_MERCHANT_HPP
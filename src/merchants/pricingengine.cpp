@@ -0,0 +1,169 @@
+//
+// Created by Connor on 19/10/2026.
+//
+
+#include "pricingengine.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+#include "../items/itemdatabase.hpp"
+
+namespace {
+// Each recompute keeps this much of the old pressure, so trading fades out over time
+constexpr float PRESSURE_DECAY = 0.9f;
+// Net trades it takes to move a price halfway to its limit
+constexpr float PRESSURE_SOFTNESS = 20.0f;
+
+int64_t steadyNanos() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+}  // namespace
+
+PricingEngine& PricingEngine::getInstance() {
+    static PricingEngine instance;
+    return instance;
+}
+
+void PricingEngine::initialize() {
+    std::lock_guard<std::mutex> lock(recomputeMutex);
+    const ItemDatabase& itemDatabase = ItemDatabase::getInstance();
+    templateCount = itemDatabase.getTemplateCount();
+
+    demand.reset(new std::atomic<int64_t>[templateCount]);
+    supply.reset(new std::atomic<int64_t>[templateCount]);
+    baseValues.assign(templateCount, 0.0f);
+    pressure.assign(templateCount, 0.0f);
+    netTrades.assign(templateCount, 0.0f);
+    nextPrices.assign(templateCount, 0);
+    for (size_t i = 0; i < templateCount; ++i) {
+        demand[i].store(0, std::memory_order_relaxed);
+        supply[i].store(0, std::memory_order_relaxed);
+        baseValues[i] = static_cast<float>(itemDatabase.getTemplateByIndex(i)->value);
+        nextPrices[i] = itemDatabase.getTemplateByIndex(i)->value;
+    }
+
+    current.store(nullptr, std::memory_order_release);
+    for (PriceSnapshot& snapshot : ring) {
+        snapshot.sequence.store(0, std::memory_order_relaxed);
+        snapshot.prices.reset(new std::atomic<int32_t>[templateCount]);
+    }
+    nextVersion = 0;
+    publish();
+    nextRecomputeNanos.store(steadyNanos() + recomputeIntervalNanos.load(),
+                             std::memory_order_relaxed);
+}
+
+void PricingEngine::recordPurchase(const ItemTemplate& item, int count) {
+    if (item.index < templateCount) {
+        demand[item.index].fetch_add(count, std::memory_order_relaxed);
+    }
+}
+
+void PricingEngine::recordSale(const ItemTemplate& item, int count) {
+    if (item.index < templateCount) {
+        supply[item.index].fetch_add(count, std::memory_order_relaxed);
+    }
+}
+
+void PricingEngine::recompute() {
+    std::lock_guard<std::mutex> lock(recomputeMutex);
+    if (templateCount == 0) return;
+
+    for (size_t i = 0; i < templateCount; ++i) {
+        int64_t bought = demand[i].exchange(0, std::memory_order_relaxed);
+        int64_t sold = supply[i].exchange(0, std::memory_order_relaxed);
+        netTrades[i] = static_cast<float>(bought - sold);
+    }
+
+    // Plain float arrays with no branches, so the compiler vectorizes these loops
+    float* pressures = pressure.data();
+    const float* net = netTrades.data();
+    const float* base = baseValues.data();
+    int32_t* prices = nextPrices.data();
+    for (size_t i = 0; i < templateCount; ++i) {
+        pressures[i] = pressures[i] * PRESSURE_DECAY + net[i];
+    }
+    for (size_t i = 0; i < templateCount; ++i) {
+        float swing = pressures[i] / (std::fabs(pressures[i]) + PRESSURE_SOFTNESS);
+        float price = base[i] * (1.0f + MAX_SWING * swing);
+        // Never let anything that's worth something drop to 0
+        price = std::max(price, std::min(base[i], 1.0f));
+        prices[i] = static_cast<int32_t>(price + 0.5f);
+    }
+    publish();
+}
+
+bool PricingEngine::recomputeIfDue() {
+    int64_t now = steadyNanos();
+    int64_t due = nextRecomputeNanos.load(std::memory_order_relaxed);
+    if (now < due) return false;
+    int64_t next = now + recomputeIntervalNanos.load(std::memory_order_relaxed);
+    if (!nextRecomputeNanos.compare_exchange_strong(due, next, std::memory_order_relaxed)) {
+        return false;  // Another thread got there first
+    }
+    recompute();
+    return true;
+}
+
+void PricingEngine::setRecomputeInterval(std::chrono::milliseconds interval) {
+    int64_t nanos = std::chrono::duration_cast<std::chrono::nanoseconds>(interval).count();
+    recomputeIntervalNanos.store(nanos, std::memory_order_relaxed);
+    nextRecomputeNanos.store(steadyNanos() + nanos, std::memory_order_relaxed);
+}
+
+int PricingEngine::getPrice(const ItemTemplate& item) const {
+    const ItemTemplate* items[] = {&item};
+    int price = 0;
+    readPrices(items, 1, &price);
+    return price;
+}
+
+void PricingEngine::readPrices(const ItemTemplate* const* items, size_t count,
+                               int* prices) const {
+    for (;;) {
+        const PriceSnapshot* snapshot = current.load(std::memory_order_acquire);
+        if (!snapshot) {
+            for (size_t i = 0; i < count; ++i) prices[i] = items[i]->value;
+            return;
+        }
+        uint64_t sequence = snapshot->sequence.load(std::memory_order_acquire);
+        if (sequence & 1) continue;  // Being recycled right now
+
+        for (size_t i = 0; i < count; ++i) {
+            size_t index = items[i]->index;
+            prices[i] = index < templateCount
+                            ? snapshot->prices[index].load(std::memory_order_relaxed)
+                            : items[i]->value;  // Added after initialize()
+        }
+
+        // Only keep what we read if the snapshot wasn't recycled underneath us
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (snapshot->sequence.load(std::memory_order_relaxed) == sequence) return;
+    }
+}
+
+uint64_t PricingEngine::getSnapshotVersion() const {
+    const PriceSnapshot* snapshot = current.load(std::memory_order_acquire);
+    return snapshot ? snapshot->version.load(std::memory_order_relaxed) : 0;
+}
+
+void PricingEngine::publish() {
+    // Fill in the oldest snapshot in the ring, then make it the current one
+    PriceSnapshot* previous = current.load(std::memory_order_relaxed);
+    size_t slot = previous ? (static_cast<size_t>(previous - ring.data()) + 1) % SNAPSHOT_RING : 0;
+    PriceSnapshot& snapshot = ring[slot];
+
+    uint64_t sequence = snapshot.sequence.load(std::memory_order_relaxed);
+    snapshot.sequence.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    for (size_t i = 0; i < templateCount; ++i) {
+        snapshot.prices[i].store(nextPrices[i], std::memory_order_relaxed);
+    }
+    snapshot.version.store(++nextVersion, std::memory_order_relaxed);
+    snapshot.sequence.store(sequence + 2, std::memory_order_release);
+
+    current.store(&snapshot, std::memory_order_release);
+}
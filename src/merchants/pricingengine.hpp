@@ -0,0 +1,83 @@
+//
+// Created by Connor on 19/10/2026.
+//
+
+#ifndef TERMINAL_RPG_PRICINGENGINE_HPP
+#define TERMINAL_RPG_PRICINGENGINE_HPP
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+struct ItemTemplate;
+
+// Merchant prices driven by supply and demand across every session. Trades only bump
+// per-template counters; recompute() folds them into new prices for all templates in one
+// pass and publishes the result as a snapshot that readers get without taking a lock.
+class PricingEngine {
+public:
+    // Published snapshots are recycled in a ring; a reader that races a recycle retries
+    static constexpr size_t SNAPSHOT_RING = 4;
+    // How far demand can push a price above (or supply below) the item's base value
+    static constexpr float MAX_SWING = 0.5f;
+
+    static PricingEngine& getInstance();
+
+    // Sizes everything for the ItemDatabase's templates and resets prices to base values.
+    // Call before sessions start trading.
+    void initialize();
+
+    // Safe from any thread
+    void recordPurchase(const ItemTemplate& item, int count = 1);  // Player bought
+    void recordSale(const ItemTemplate& item, int count = 1);      // Player sold
+
+    void recompute();
+    // Recomputes if the interval has passed since the last recompute; any thread may call it
+    // and only one will do the work
+    bool recomputeIfDue();
+    void setRecomputeInterval(std::chrono::milliseconds interval);
+
+    int getPrice(const ItemTemplate& item) const;
+    // Reads prices for several items from the same snapshot
+    void readPrices(const ItemTemplate* const* items, size_t count, int* prices) const;
+    uint64_t getSnapshotVersion() const;
+
+private:
+    struct PriceSnapshot {
+        std::atomic<uint64_t> sequence{0};  // Odd while the writer is filling it in
+        std::atomic<uint64_t> version{0};
+        std::unique_ptr<std::atomic<int32_t>[]> prices;
+    };
+
+    PricingEngine() = default;
+    ~PricingEngine() = default;
+    PricingEngine(const PricingEngine&) = delete;
+    PricingEngine& operator=(const PricingEngine&) = delete;
+
+    size_t templateCount = 0;
+    std::unique_ptr<std::atomic<int64_t>[]> demand;
+    std::unique_ptr<std::atomic<int64_t>[]> supply;
+
+    // Writer side, guarded by recomputeMutex
+    std::mutex recomputeMutex;
+    std::vector<float> baseValues;
+    std::vector<float> pressure;
+    std::vector<float> netTrades;
+    std::vector<int32_t> nextPrices;
+    uint64_t nextVersion = 0;
+
+    std::array<PriceSnapshot, SNAPSHOT_RING> ring;
+    std::atomic<PriceSnapshot*> current{nullptr};
+
+    std::atomic<int64_t> recomputeIntervalNanos{1000000000};
+    std::atomic<int64_t> nextRecomputeNanos{0};
+
+    void publish();
+};
+
+#endif  // TERMINAL_RPG_PRICINGENGINE_HPP
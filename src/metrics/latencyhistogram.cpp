@@ -0,0 +1,192 @@
+//
+// Created by Connor on 19/10/2026.
+//
+
+#include "latencyhistogram.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <limits>
+#include <sstream>
+
+namespace {
+int mostSignificantBit(uint64_t value) {
+    int bit = 0;
+    while (value >>= 1) ++bit;
+    return bit;
+}
+
+// Number of buckets needed to cover the full uint64_t range
+constexpr size_t bucketCountForRange() {
+    return (64 - (LatencyHistogram::SUB_BUCKET_BITS - 1)) *
+               LatencyHistogram::SUB_BUCKET_HALF_COUNT +
+           LatencyHistogram::SUB_BUCKET_HALF_COUNT;
+}
+
+double toMicroseconds(uint64_t nanoseconds) { return static_cast<double>(nanoseconds) / 1000.0; }
+}  // namespace
+
+LatencyHistogram::LatencyHistogram()
+    : counts(bucketCountForRange(), 0),
+      totalCount(0),
+      minValue(std::numeric_limits<uint64_t>::max()),
+      maxValue(0),
+      sum(0) {}
+
+size_t LatencyHistogram::bucketIndexFor(uint64_t value) {
+    if (value < SUB_BUCKET_COUNT) {
+        return static_cast<size_t>(value);
+    }
+    // Values past the first range are shifted down so that the sub-bucket lands in
+    // [SUB_BUCKET_HALF_COUNT, SUB_BUCKET_COUNT), then offset by one half-range per shift
+    int shift = mostSignificantBit(value) - (SUB_BUCKET_BITS - 1);
+    uint64_t subBucket = value >> shift;
+    return static_cast<size_t>(shift * SUB_BUCKET_HALF_COUNT + subBucket);
+}
+
+uint64_t LatencyHistogram::highestEquivalentValue(size_t index) {
+    if (index < SUB_BUCKET_COUNT) {
+        return index;
+    }
+    uint64_t shift = index / SUB_BUCKET_HALF_COUNT - 1;
+    uint64_t subBucket = index - shift * SUB_BUCKET_HALF_COUNT;
+    // Unsigned wrap-around makes the top bucket come out as UINT64_MAX
+    return ((subBucket + 1) << shift) - 1;
+}
+
+void LatencyHistogram::record(uint64_t value) {
+    ++counts[bucketIndexFor(value)];
+    ++totalCount;
+    minValue = std::min(minValue, value);
+    maxValue = std::max(maxValue, value);
+    sum += value;
+}
+
+void LatencyHistogram::merge(const LatencyHistogram& other) {
+    for (size_t i = 0; i < counts.size(); ++i) {
+        counts[i] += other.counts[i];
+    }
+    totalCount += other.totalCount;
+    minValue = std::min(minValue, other.minValue);
+    maxValue = std::max(maxValue, other.maxValue);
+    sum += other.sum;
+}
+
+void LatencyHistogram::reset() {
+    std::fill(counts.begin(), counts.end(), 0);
+    totalCount = 0;
+    minValue = std::numeric_limits<uint64_t>::max();
+    maxValue = 0;
+    sum = 0;
+}
+
+uint64_t LatencyHistogram::getCount() const { return totalCount; }
+
+uint64_t LatencyHistogram::getMin() const { return totalCount ? minValue : 0; }
+
+uint64_t LatencyHistogram::getMax() const { return maxValue; }
+
+double LatencyHistogram::getMean() const {
+    return totalCount ? static_cast<double>(sum / totalCount) : 0.0;
+}
+
+uint64_t LatencyHistogram::getValueAtPercentile(double percentile) const {
+    if (totalCount == 0) return 0;
+
+    percentile = std::min(100.0, std::max(0.0, percentile));
+    uint64_t target = static_cast<uint64_t>(std::ceil(percentile / 100.0 * totalCount));
+    target = std::max<uint64_t>(1, target);
+
+    uint64_t cumulative = 0;
+    for (size_t i = 0; i < counts.size(); ++i) {
+        cumulative += counts[i];
+        if (cumulative >= target) {
+            return std::min(highestEquivalentValue(i), maxValue);
+        }
+    }
+    return maxValue;
+}
+
+const char* getPlayerCommandName(PlayerCommand command) {
+    switch (command) {
+        case PlayerCommand::COMBAT_ATTACK:
+            return "combat.attack";
+        case PlayerCommand::COMBAT_DEFEND:
+            return "combat.defend";
+        case PlayerCommand::COMBAT_POWER_ATTACK:
+            return "combat.power_attack";
+        case PlayerCommand::COMBAT_USE_ITEM:
+            return "combat.use_item";
+        case PlayerCommand::COMBAT_EQUIP_WEAPON:
+            return "combat.equip_weapon";
+        case PlayerCommand::COMBAT_FLEE:
+            return "combat.flee";
+        case PlayerCommand::MERCHANT_BUY:
+            return "merchant.buy";
+        case PlayerCommand::MERCHANT_SELL:
+            return "merchant.sell";
+        case PlayerCommand::CHEST_OPEN:
+            return "chest.open";
+        case PlayerCommand::EQUIP:
+            return "equip";
+        case PlayerCommand::COUNT:
+            break;
+    }
+    return "unknown";
+}
+
+void CommandLatencyTracker::record(PlayerCommand command, uint64_t nanoseconds) {
+    histograms[static_cast<size_t>(command)].record(nanoseconds);
+}
+
+void CommandLatencyTracker::merge(const CommandLatencyTracker& other) {
+    for (size_t i = 0; i < histograms.size(); ++i) {
+        histograms[i].merge(other.histograms[i]);
+    }
+}
+
+void CommandLatencyTracker::reset() {
+    for (LatencyHistogram& histogram : histograms) {
+        histogram.reset();
+    }
+}
+
+const LatencyHistogram& CommandLatencyTracker::getHistogram(PlayerCommand command) const {
+    return histograms[static_cast<size_t>(command)];
+}
+
+std::string CommandLatencyTracker::formatReport() const {
+    std::ostringstream report;
+    report << std::fixed << std::setprecision(1);
+    report << "Command latency (microseconds, input received to frame flushed)\n";
+    report << std::left << std::setw(22) << "command" << std::right << std::setw(8) << "count"
+           << std::setw(11) << "p50" << std::setw(11) << "p99" << std::setw(11) << "p999"
+           << std::setw(11) << "max" << "\n";
+
+    bool anySamples = false;
+    for (size_t i = 0; i < histograms.size(); ++i) {
+        const LatencyHistogram& histogram = histograms[i];
+        if (histogram.getCount() == 0) continue;
+        anySamples = true;
+
+        report << std::left << std::setw(22) << getPlayerCommandName(static_cast<PlayerCommand>(i))
+               << std::right << std::setw(8) << histogram.getCount() << std::setw(11)
+               << toMicroseconds(histogram.getValueAtPercentile(50.0)) << std::setw(11)
+               << toMicroseconds(histogram.getValueAtPercentile(99.0)) << std::setw(11)
+               << toMicroseconds(histogram.getValueAtPercentile(99.9)) << std::setw(11)
+               << toMicroseconds(histogram.getMax()) << "\n";
+    }
+    if (!anySamples) {
+        report << "(no commands recorded yet)\n";
+    }
+    return report.str();
+}
+
+bool CommandLatencyTracker::writeReport(const std::string& path) const {
+    std::ofstream file(path);
+    if (!file) return false;
+    file << formatReport();
+    return static_cast<bool>(file);
+}
@@ -0,0 +1,83 @@
+//
+// Created by Connor on 19/10/2026.
+//
+
+#ifndef TERMINAL_RPG_LATENCYHISTOGRAM_HPP
+#define TERMINAL_RPG_LATENCYHISTOGRAM_HPP
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// HDR-style histogram: values are grouped into power-of-two ranges, each split into a fixed
+// number of linear sub-buckets, giving a constant relative error (< 1.6%) over the full range
+// of uint64_t while recording in O(1) with no allocation after construction.
+class LatencyHistogram {
+public:
+    LatencyHistogram();
+
+    void record(uint64_t value);
+    void merge(const LatencyHistogram& other);
+    void reset();
+
+    uint64_t getCount() const;
+    uint64_t getMin() const;
+    uint64_t getMax() const;
+    double getMean() const;
+
+    // Returns the highest value equivalent to the bucket holding the given percentile (0-100)
+    uint64_t getValueAtPercentile(double percentile) const;
+
+    static constexpr int SUB_BUCKET_BITS = 7;
+    static constexpr uint64_t SUB_BUCKET_COUNT = uint64_t{1} << SUB_BUCKET_BITS;
+    static constexpr uint64_t SUB_BUCKET_HALF_COUNT = SUB_BUCKET_COUNT / 2;
+
+    static size_t bucketIndexFor(uint64_t value);
+    static uint64_t highestEquivalentValue(size_t index);
+
+private:
+    std::vector<uint64_t> counts;
+    uint64_t totalCount;
+    uint64_t minValue;
+    uint64_t maxValue;
+    long double sum;
+};
+
+enum class PlayerCommand {
+    COMBAT_ATTACK,
+    COMBAT_DEFEND,
+    COMBAT_POWER_ATTACK,
+    COMBAT_USE_ITEM,
+    COMBAT_EQUIP_WEAPON,
+    COMBAT_FLEE,
+    MERCHANT_BUY,
+    MERCHANT_SELL,
+    CHEST_OPEN,
+    EQUIP,
+    COUNT
+};
+
+const char* getPlayerCommandName(PlayerCommand command);
+
+// One latency histogram per player command, measured in nanoseconds from input received to
+// the resulting frame being flushed
+class CommandLatencyTracker {
+public:
+    void record(PlayerCommand command, uint64_t nanoseconds);
+    void merge(const CommandLatencyTracker& other);
+    void reset();
+
+    const LatencyHistogram& getHistogram(PlayerCommand command) const;
+
+    // Human readable p50/p99/p999 table for every command that has samples
+    std::string formatReport() const;
+
+    // Writes formatReport() to the given path, returns false if the file could not be written
+    bool writeReport(const std::string& path) const;
+
+private:
+    std::array<LatencyHistogram, static_cast<size_t>(PlayerCommand::COUNT)> histograms;
+};
+
+#endif  // TERMINAL_RPG_LATENCYHISTOGRAM_HPP
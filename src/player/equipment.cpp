@@ -0,0 +1,87 @@
+//
+// Created by Connor on 19/10/2026.
+//
+
+#include "equipment.hpp"
+
+#include <algorithm>
+
+bool getEquipmentSlot(ItemType type, EquipmentSlot& slot) {
+    switch (type) {
+        case WEAPON:
+            slot = EquipmentSlot::WEAPON;
+            return true;
+        case ARMOR:
+            slot = EquipmentSlot::ARMOR;
+            return true;
+        case POTION:
+        case CURRENCY:
+        case MISC:
+            break;
+    }
+    return false;
+}
+
+int getItemDurability(const Item& item) {
+    switch (item.getType()) {
+        case WEAPON:
+            return item.getWeaponData().getDurability();
+        case ARMOR:
+            return item.getArmorData().getDurability();
+        default:
+            return 0;
+    }
+}
+
+Equipment::Equipment() : slots{}, defenceBonus(0) {}
+
+Item* Equipment::get(EquipmentSlot slot) const { return slots[static_cast<size_t>(slot)]; }
+
+Item* Equipment::set(EquipmentSlot slot, Item* item) {
+    Item*& held = slots[static_cast<size_t>(slot)];
+    Item* previous = held;
+    if (previous) previous->setEquipped(false);
+    held = item;
+    if (item) item->setEquipped(true);
+    refreshBonuses();
+    return previous;
+}
+
+bool Equipment::find(const Item* item, EquipmentSlot& slot) const {
+    if (!item) return false;
+    for (size_t i = 0; i < EQUIPMENT_SLOT_COUNT; ++i) {
+        if (slots[i] == item) {
+            slot = static_cast<EquipmentSlot>(i);
+            return true;
+        }
+    }
+    return false;
+}
+
+int Equipment::getDefenceBonus() const { return defenceBonus; }
+
+bool Equipment::wear(EquipmentSlot slot, int amount) {
+    Item* item = get(slot);
+    if (!item || amount <= 0) return false;
+    int durability = getItemDurability(*item);
+    if (durability <= 0) return false;
+
+    durability = std::max(durability - amount, 0);
+    if (item->getType() == WEAPON) {
+        WeaponData weaponData = item->getWeaponData();
+        weaponData.setDurability(durability);
+        item->setWeaponData(weaponData);
+    } else if (item->getType() == ARMOR) {
+        ArmorData armorData = item->getArmorData();
+        armorData.setDurability(durability);
+        item->setArmorData(armorData);
+    }
+    return durability == 0;
+}
+
+void Equipment::refreshBonuses() {
+    defenceBonus = 0;
+    for (const Item* item : slots) {
+        if (item && item->getType() == ARMOR) defenceBonus += item->getArmorData().getArmorValue();
+    }
+}
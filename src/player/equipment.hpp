@@ -0,0 +1,52 @@
+//
+// Created by Connor on 19/10/2026.
+//
+
+#ifndef TERMINAL_RPG_EQUIPMENT_HPP
+#define TERMINAL_RPG_EQUIPMENT_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include "../items/item.hpp"
+
+// Where an item is worn. New kinds of gear (shields, rings) get a slot here and a case in
+// getEquipmentSlot(); everything else works off the slot.
+enum class EquipmentSlot : uint8_t { WEAPON, ARMOR };
+
+constexpr size_t EQUIPMENT_SLOT_COUNT = static_cast<size_t>(EquipmentSlot::ARMOR) + 1;
+
+// The slot an item type goes in; false if it can't be equipped
+bool getEquipmentSlot(ItemType type, EquipmentSlot& slot);
+
+// Durability of the item in its slot's data (0 for anything else)
+int getItemDurability(const Item& item);
+
+// One item per slot. The defence bonus of everything worn is summed whenever the gear changes,
+// so combat reads one number instead of walking the slots on every hit. Doesn't own the items.
+class Equipment {
+public:
+    Equipment();
+
+    Item* get(EquipmentSlot slot) const;
+    // Puts item in slot (nullptr empties it) and keeps the items' equipped flags in step;
+    // returns whatever was there before
+    Item* set(EquipmentSlot slot, Item* item);
+    // Finds the slot holding item; false if it isn't equipped
+    bool find(const Item* item, EquipmentSlot& slot) const;
+
+    int getDefenceBonus() const;
+
+    // Wears the item in slot down by amount. Returns true if that broke it; broken gear stays
+    // in its slot until it's taken off. Gear with no durability (0) never wears.
+    bool wear(EquipmentSlot slot, int amount);
+
+private:
+    std::array<Item*, EQUIPMENT_SLOT_COUNT> slots;
+    int defenceBonus;
+
+    void refreshBonuses();
+};
+
+#endif  // TERMINAL_RPG_EQUIPMENT_HPP
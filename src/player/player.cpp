@@ -1,15 +1,16 @@
 #include "player.hpp"
 
 #include <algorithm>
+#include <climits>
 #include <iostream>
 
 #include "../levels/leveldatabase.hpp"
 
 Player::Player(const std::string& name, int health, unsigned int maxHealth, unsigned int stamina,
                unsigned int maxStamina, unsigned int defence, unsigned int resistance,
-               unsigned int level, unsigned int experience, unsigned int gold,
-               unsigned int nextLevelExp, unsigned int totalWeight, Item* equippedWeapon,
-               Item* equippedArmor, std::vector<Item*> inventory)
+               unsigned int level, uint64_t experience, unsigned int gold, uint64_t nextLevelExp,
+               unsigned int totalWeight, Item* equippedWeapon, Item* equippedArmor,
+               std::vector<Item*> inventory)
     : name(name),
       health(health),
       maxHealth(maxHealth),
@@ -23,22 +24,25 @@ Player::Player(const std::string& name, int health, unsigned int maxHealth, unsi
       nextLevelExp(nextLevelExp),
       totalWeight(totalWeight),
       inventory(inventory),
-      equippedWeapon(equippedWeapon),
-      equippedArmor(equippedArmor),
+      effectiveDefence(defence),
       baseMaxHealth(maxHealth),
       baseMaxStamina(maxStamina),
       baseDefence(defence),
-      baseResistance(resistance) {}
+      baseResistance(resistance) {
+    equipment.set(EquipmentSlot::WEAPON, equippedWeapon);
+    equipment.set(EquipmentSlot::ARMOR, equippedArmor);
+    refreshDefence();
+}
 
 void Player::takeDamage(unsigned int damage) {
-    int actualDamage = static_cast<int>(damage) - static_cast<int>(defence);
+    int actualDamage = static_cast<int>(damage) - static_cast<int>(getDefence());
     if (actualDamage < 0) actualDamage = 0;
     health -= actualDamage;
     if (health < 0) health = 0;
 }
 
 void Player::takeSpellDamage(unsigned int damage) {
-    int actualDamage = static_cast<int>(damage) - static_cast<int>(resistance);
+    int actualDamage = static_cast<int>(damage) - static_cast<int>(getResistance());
     if (actualDamage < 0) actualDamage = 0;
     health -= actualDamage;
     if (health < 0) health = 0;
@@ -50,6 +54,11 @@ void Player::heal(unsigned int amount) {
     if (health < 0) health = 0;
 }
 
+void Player::loseHealth(unsigned int amount) {
+    health -= static_cast<int>(amount);
+    if (health < 0) health = 0;
+}
+
 void Player::useStamina(unsigned int amount) {
     if (amount > stamina) {
         stamina = 0;
@@ -73,7 +82,14 @@ void Player::changeMaxStamina(signed int amount) {
     if (stamina > maxStamina) stamina = maxStamina;
 }
 
-void Player::changeDefence(signed int amount) { defence += amount; }
+void Player::changeDefence(signed int amount) {
+    defence += amount;
+    refreshDefence();
+}
+
+void Player::refreshDefence() {
+    effectiveDefence = defence + static_cast<unsigned int>(equipment.getDefenceBonus());
+}
 
 void Player::changeResistance(signed int amount) { resistance += amount; }
 
@@ -95,16 +111,17 @@ void Player::removeWeight(unsigned int amount) {
         totalWeight -= amount;
 }
 
-bool Player::pickupItem(Item* item) {
+bool Player::pickupItem(Item* item, std::ostream& out) {
     if (!item) return false;
 
     // Special handling for currency items
     if (item->getType() == CURRENCY) {
         // Add gold value to player's gold
-        addGold(item->getValue());
-        std::cout << "Picked up " << item->getName() << " and gained " << item->getValue()
-                  << " gold!" << std::endl;
-        std::cout << "Current gold: " << gold << std::endl;
+        unsigned int goldValue = item->getValue() * item->getQuantity();
+        addGold(goldValue);
+        out << "Picked up " << item->getName() << " and gained " << goldValue << " gold!"
+            << std::endl;
+        out << "Current gold: " << gold << std::endl;
 
         // Currency items are used up immediately, so we delete the item.
         delete item;
@@ -112,39 +129,70 @@ bool Player::pickupItem(Item* item) {
     } else {
         // Weight limit check (assume 100 for now, adjust as needed)
         unsigned int maxWeight = 100;
-        if (totalWeight + item->getWeight() > maxWeight) {
-            std::cout << "Cannot pick up " << item->getName() << ", too heavy!" << std::endl;
+        if (totalWeight + item->getStackWeight() > maxWeight) {
+            out << "Cannot pick up " << item->getName() << ", too heavy!" << std::endl;
             return false;
         }
-        // Regular items are added to inventory
+        // Regular items are added to inventory. The name is interned, so it outlives the item
+        // if it merges into a stack and is deleted.
+        std::string_view itemName = item->getName();
         addItemToInventory(item);
-        std::cout << "Picked up " << item->getName() << " and added it to inventory." << std::endl;
+        out << "Picked up " << itemName << " and added it to inventory." << std::endl;
         return true;
     }
 }
 
-void Player::addItemToInventory(Item* item) {
-    if (!item) return;
+Item* Player::addItemToInventory(Item* item) {
+    if (!item) return nullptr;
 
     // Add weight to player
-    addWeight(item->getWeight());
+    addWeight(item->getStackWeight());
+
+    // Merge into a matching stack rather than taking up another slot
+    if (item->isStackable()) {
+        for (Item* stack : inventory) {
+            if (stack->stacksWith(*item)) {
+                stack->setQuantity(stack->getQuantity() + item->getQuantity());
+                delete item;
+                return stack;
+            }
+        }
+    }
 
     // Add item to inventory
     inventory.push_back(item);
+    return item;
 }
 
-void Player::gainExperience(unsigned int amount) {
+bool Player::removeItemFromInventory(Item* item, int count) {
+    auto it = std::find(inventory.begin(), inventory.end(), item);
+    if (it == inventory.end() || count <= 0) return false;
+
+    count = std::min(count, item->getQuantity());
+    removeWeight(item->getWeight() * count);
+    if (count < item->getQuantity()) {
+        item->setQuantity(item->getQuantity() - count);
+        return true;
+    }
+    // Gear that leaves the inventory comes off first
+    EquipmentSlot slot;
+    if (equipment.find(item, slot)) equip(slot, nullptr);
+    inventory.erase(it);
+    delete item;
+    return true;
+}
+
+void Player::gainExperience(unsigned int amount, std::ostream& out) {
     experience += amount;
-    std::cout << "Gained " << amount << " experience!" << std::endl;
+    out << "Gained " << amount << " experience!" << std::endl;
 
     // Check for level up
     if (checkAndLevelUp()) {
-        std::cout << "Level up! You are now level " << level << "!" << std::endl;
+        out << "Level up! You are now level " << level << "!" << std::endl;
         updateStatsForLevel();
 
         // Show level progression info
-        std::cout << LevelDatabase::getInstance().getLevelProgressionInfo(level, experience)
-                  << std::endl;
+        out << LevelDatabase::getInstance().getLevelProgressionInfo(level, experience) << std::endl;
     }
 
     // Update next level experience
@@ -166,14 +214,19 @@ void Player::updateStatsForLevel() {
     LevelDatabase::getInstance().getStatBonuses(level, healthBonus, staminaBonus, defenceBonus,
                                                 resistanceBonus);
 
-    // Update max stats with bonuses
+    // Update max stats with bonuses. Endless levels can push them past what health (an int) holds.
+    auto withBonus = [](unsigned int base, unsigned int bonus) {
+        return static_cast<unsigned int>(
+            std::min<uint64_t>(static_cast<uint64_t>(base) + bonus, INT_MAX));
+    };
     unsigned int oldMaxHealth = maxHealth;
     unsigned int oldMaxStamina = maxStamina;
 
-    maxHealth = baseMaxHealth + healthBonus;
-    maxStamina = baseMaxStamina + staminaBonus;
-    defence = baseDefence + defenceBonus;
-    resistance = baseResistance + resistanceBonus;
+    maxHealth = withBonus(baseMaxHealth, healthBonus);
+    maxStamina = withBonus(baseMaxStamina, staminaBonus);
+    defence = withBonus(baseDefence, defenceBonus);
+    resistance = withBonus(baseResistance, resistanceBonus);
+    refreshDefence();
 
     // Heal proportionally when max health/stamina increases
     if (maxHealth > oldMaxHealth) {
@@ -187,21 +240,49 @@ void Player::updateStatsForLevel() {
     nextLevelExp = LevelDatabase::getInstance().getExperienceForNextLevel(level);
 }
 
-void Player::setEquippedWeapon(Item* weapon) { equippedWeapon = weapon; }
+void Player::setEquippedWeapon(Item* weapon) { equip(EquipmentSlot::WEAPON, weapon); }
+
+void Player::setEquippedArmor(Item* armor) { equip(EquipmentSlot::ARMOR, armor); }
+
+Item* Player::equip(EquipmentSlot slot, Item* item) {
+    Item* previous = equipment.set(slot, item);
+    refreshDefence();
+    return previous;
+}
+
+Item* Player::getEquipped(EquipmentSlot slot) const { return equipment.get(slot); }
+
+const Equipment& Player::getEquipment() const { return equipment; }
 
-void Player::setEquippedArmor(Item* armor) { equippedArmor = armor; }
+bool Player::wearEquipped(EquipmentSlot slot, int amount) { return equipment.wear(slot, amount); }
+
+void Player::breakEquipped(EquipmentSlot slot) {
+    Item* item = equip(slot, nullptr);
+    if (item) removeItemFromInventory(item);
+}
 
 int Player::getHealth() const { return health; }
 unsigned int Player::getMaxHealth() const { return maxHealth; }
 unsigned int Player::getStamina() const { return stamina; }
 unsigned int Player::getMaxStamina() const { return maxStamina; }
-unsigned int Player::getDefence() const { return defence; }
-unsigned int Player::getResistance() const { return resistance; }
+unsigned int Player::getDefence() const {
+    int modifier = statusEffects.getModifier(StatusEffectType::DEFENCE);
+    return effectiveDefence + static_cast<unsigned int>(modifier);
+}
+unsigned int Player::getResistance() const {
+    int modifier = statusEffects.getModifier(StatusEffectType::RESISTANCE);
+    return resistance + static_cast<unsigned int>(modifier);
+}
 const std::string& Player::getName() const { return name; }
 unsigned int Player::getLevel() const { return level; }
-unsigned int Player::getExperience() const { return experience; }
+uint64_t Player::getExperience() const { return experience; }
 unsigned int Player::getGold() const { return gold; }
-unsigned int Player::getNextLevelExp() const { return nextLevelExp; }
+uint64_t Player::getNextLevelExp() const { return nextLevelExp; }
 const std::vector<Item*>& Player::getInventory() const { return inventory; }
-Item* Player::getEquippedWeapon() const { return equippedWeapon; }
-Item* Player::getEquippedArmor() const { return equippedArmor; }
+
+unsigned int Player::getTotalWeight() const { return totalWeight; }
+
+StatusEffects& Player::getStatusEffects() { return statusEffects; }
+const StatusEffects& Player::getStatusEffects() const { return statusEffects; }
+Item* Player::getEquippedWeapon() const { return equipment.get(EquipmentSlot::WEAPON); }
+Item* Player::getEquippedArmor() const { return equipment.get(EquipmentSlot::ARMOR); }
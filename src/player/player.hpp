@@ -4,9 +4,24 @@
 
 #ifndef TERMINAL_RPG_PLAYER_HPP
 #define TERMINAL_RPG_PLAYER_HPP
+#include <cstdint>
+#include <iostream>
 #include <string>
 #include <vector>
+#include "../effects/statuseffects.hpp"
 #include "../items/item.hpp"
+#include "../levels/fixedpoint.hpp"
+#include "equipment.hpp"
+
+// Share of max stamina won back by defending, and at the end of any other turn
+constexpr Permille DEFEND_STAMINA_RECOVERY = 300;
+constexpr Permille TURN_STAMINA_RECOVERY = 60;
+
+// Stamina recovered from maxStamina at the given share, rounded down. Every combat mode and
+// simulator goes through this so they all agree to the point.
+constexpr unsigned int getStaminaRecovery(unsigned int maxStamina, Permille share) {
+    return static_cast<unsigned int>(applyPermille(maxStamina, share));
+}
 
 class Player {
 public:
@@ -18,9 +33,9 @@ public:
            unsigned int defence,
            unsigned int resistance,
            unsigned int level,
-           unsigned int experience,
+           uint64_t experience,
            unsigned int gold,
-           unsigned int nextLevelExp,
+           uint64_t nextLevelExp,
            unsigned int totalWeight,
            Item* equippedWeapon = nullptr,
            Item* equippedArmor = nullptr,
@@ -32,6 +47,9 @@ public:
 
     void heal(unsigned int amount);
 
+    // Damage that ignores defence and resistance (e.g. poison)
+    void loseHealth(unsigned int amount);
+
     void useStamina(unsigned int amount);
 
     void recoverStamina(unsigned int amount);
@@ -52,17 +70,31 @@ public:
 
     void removeWeight(unsigned int amount);
 
-    void addItemToInventory(Item* item);
+    // Stackable items merge into an existing stack (and the passed item is deleted); returns
+    // the inventory slot the item ended up in
+    Item* addItemToInventory(Item* item);
+
+    // Takes count units off the stack, deleting the item (and taking it off) once none are left
+    bool removeItemFromInventory(Item* item, int count = 1);
 
-    bool pickupItem(Item* item);
+    bool pickupItem(Item* item, std::ostream& out = std::cout);
 
     // Leveling methods
-    void gainExperience(unsigned int amount);
+    void gainExperience(unsigned int amount, std::ostream& out = std::cout);
     bool checkAndLevelUp();
     void updateStatsForLevel();
     void setEquippedWeapon(Item* weapon);
     void setEquippedArmor(Item* armor);
 
+    // Puts item in slot (nullptr takes the slot off); returns what was there before
+    Item* equip(EquipmentSlot slot, Item* item);
+    Item* getEquipped(EquipmentSlot slot) const;
+    const Equipment& getEquipment() const;
+    // Wears equipped gear down; returns true if it broke. Broken gear stays on until
+    // breakEquipped() takes it off and throws it away, which is the one way gear breaks.
+    bool wearEquipped(EquipmentSlot slot, int amount);
+    void breakEquipped(EquipmentSlot slot);
+
     int getHealth() const;
 
     unsigned int getMaxHealth() const;
@@ -71,6 +103,7 @@ public:
 
     unsigned int getMaxStamina() const;
 
+    // Base defence plus worn armour (cached when either changes) plus status effects
     unsigned int getDefence() const;
 
     unsigned int getResistance() const;
@@ -79,18 +112,24 @@ public:
 
     unsigned int getLevel() const;
 
-    unsigned int getExperience() const;
+    uint64_t getExperience() const;
 
     unsigned int getGold() const;
 
-    unsigned int getNextLevelExp() const;
+    uint64_t getNextLevelExp() const;
 
     const std::vector<Item*>& getInventory() const;
 
+    unsigned int getTotalWeight() const;
+
     Item* getEquippedWeapon() const;
 
     Item* getEquippedArmor() const;
 
+    // Timed buffs and debuffs; defence and resistance above already include them
+    StatusEffects& getStatusEffects();
+    const StatusEffects& getStatusEffects() const;
+
 private:
     const std::string name;
     int health;
@@ -100,16 +139,19 @@ private:
     unsigned int defence;
     unsigned int resistance;
     unsigned int level;
-    unsigned int experience;
+    uint64_t experience;
     unsigned int gold;
-    unsigned int nextLevelExp;
+    uint64_t nextLevelExp;
     unsigned int totalWeight;
     std::vector<Item*> inventory;
-    Item* equippedWeapon;
-    Item* equippedArmor;
+    Equipment equipment;
+    unsigned int effectiveDefence;  // defence + equipment bonus
     unsigned int baseMaxHealth;
     unsigned int baseMaxStamina;
     unsigned int baseDefence;
     unsigned int baseResistance;
+    StatusEffects statusEffects;
+
+    void refreshDefence();
 };
 #endif //TERMINAL_RPG_PLAYER_HPP
\ No newline at end of file
@@ -0,0 +1,589 @@
+//
+// Created by Connor on 19/10/2026.
+//
+
+#include "gameserver.hpp"
+
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <pthread.h>
+#include <sched.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <mutex>
+#include <random>
+#include <unordered_map>
+
+#include "../game/sessionscheduler.hpp"
+
+namespace {
+constexpr int MAX_EVENTS = 256;
+constexpr size_t READ_CHUNK = 4096;
+constexpr size_t MAX_LINE_LENGTH = 4096;
+// Unsent output at which a connection stops being read until the client catches up, and the
+// point past which it is dropped (input read before the pause can still produce a burst of frames)
+constexpr size_t OUTPUT_HIGH_WATER = 256 * 1024;
+constexpr size_t MAX_BUFFERED_OUTPUT = 8 * 1024 * 1024;
+
+// epoll user data carries the fd plus a generation so events for a closed fd can never be
+// mistaken for a new connection that reused the same number
+uint64_t packEventData(int fd, uint32_t generation) {
+    return (static_cast<uint64_t>(generation) << 32) | static_cast<uint32_t>(fd);
+}
+
+int unpackFd(uint64_t data) { return static_cast<int>(data & 0xffffffffu); }
+
+uint32_t unpackGeneration(uint64_t data) { return static_cast<uint32_t>(data >> 32); }
+
+std::string errorText(const char* what) { return std::string(what) + ": " + std::strerror(errno); }
+}  // namespace
+
+GameServerConfig::GameServerConfig()
+    : socketPath("/tmp/terminal_rpg.sock"),
+      tcpPort(0),
+      workerCount(std::max(1u, std::thread::hardware_concurrency())),
+      pinWorkers(true) {}
+
+// One worker thread: an epoll loop over its own connections driving its own SessionScheduler
+class ServerShard {
+public:
+    ServerShard(unsigned int index, bool pin)
+        : index(index),
+          pin(pin),
+          epollFd(-1),
+          wakeFd(-1),
+          stopping(false),
+          activeSessions(0),
+          inputsHandled(0),
+          seedSource(std::random_device{}()),
+          scheduler([this](SessionId id, const std::string& frame, bool finished) {
+              queueFrame(id, frame, finished);
+          }),
+          nextGeneration(1),
+          openingFd(-1) {}
+
+    ~ServerShard() {
+        join();
+        for (auto& entry : connections) {
+            ::close(entry.first);
+        }
+        if (wakeFd >= 0) ::close(wakeFd);
+        if (epollFd >= 0) ::close(epollFd);
+    }
+
+    bool open(std::string& error) {
+        epollFd = epoll_create1(EPOLL_CLOEXEC);
+        if (epollFd < 0) {
+            error = errorText("epoll_create1");
+            return false;
+        }
+        wakeFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        if (wakeFd < 0) {
+            error = errorText("eventfd");
+            return false;
+        }
+        epoll_event event{};
+        event.events = EPOLLIN;
+        event.data.u64 = packEventData(wakeFd, 0);
+        if (epoll_ctl(epollFd, EPOLL_CTL_ADD, wakeFd, &event) < 0) {
+            error = errorText("epoll_ctl");
+            return false;
+        }
+        return true;
+    }
+
+    void startThread() {
+        thread = std::thread([this] {
+            if (pin) pinToCore();
+            loop();
+        });
+    }
+
+    // Called from the acceptor thread
+    void addConnection(int fd) {
+        {
+            std::lock_guard<std::mutex> lock(mailboxMutex);
+            mailbox.push_back(fd);
+        }
+        wake();
+    }
+
+    void requestStop() {
+        stopping.store(true);
+        wake();
+    }
+
+    void join() {
+        if (thread.joinable()) thread.join();
+    }
+
+    uint64_t getActiveSessions() const { return activeSessions.load(); }
+    uint64_t getInputsHandled() const { return inputsHandled.load(); }
+    const CommandLatencyTracker& getLatencyTracker() const {
+        return scheduler.getLatencyTracker();
+    }
+
+private:
+    struct Connection {
+        int fd;
+        uint32_t generation;
+        SessionId session;
+        std::string input;
+        // Buffered writer: frames accumulate here and go out in one send per loop iteration
+        std::string output;
+        size_t outputOffset;
+        bool dirty;
+        bool waitingForWritable;
+        bool closeAfterFlush;
+        bool peerClosed;    // Client half-closed; answer what it sent, then close
+        bool readPaused;    // Too much output queued; reading resumes once it has gone out
+        uint32_t interest;  // epoll events currently registered
+    };
+
+    unsigned int index;
+    bool pin;
+    int epollFd;
+    int wakeFd;
+    std::thread thread;
+    std::mutex mailboxMutex;
+    std::vector<int> mailbox;
+    std::atomic<bool> stopping;
+    std::atomic<uint64_t> activeSessions;
+    std::atomic<uint64_t> inputsHandled;
+    std::mt19937 seedSource;
+    SessionScheduler scheduler;
+    std::unordered_map<int, Connection> connections;
+    std::unordered_map<SessionId, int> sessionFds;
+    std::vector<int> dirtyFds;
+    uint32_t nextGeneration;
+    int openingFd;  // Connection whose session is being opened (its id is not known yet)
+
+    void wake() {
+        uint64_t one = 1;
+        ssize_t ignored = ::write(wakeFd, &one, sizeof(one));
+        (void)ignored;
+    }
+
+    void pinToCore() {
+        unsigned int cores = std::max(1u, std::thread::hardware_concurrency());
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        CPU_SET(index % cores, &set);
+        pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+    }
+
+    void loop() {
+        epoll_event events[MAX_EVENTS];
+        while (!stopping.load()) {
+            int count = epoll_wait(epollFd, events, MAX_EVENTS, -1);
+            if (count < 0) {
+                if (errno == EINTR) continue;
+                break;
+            }
+
+            for (int i = 0; i < count; ++i) {
+                int fd = unpackFd(events[i].data.u64);
+                if (fd == wakeFd) {
+                    uint64_t value;
+                    ssize_t ignored = ::read(wakeFd, &value, sizeof(value));
+                    (void)ignored;
+                    drainMailbox();
+                    continue;
+                }
+
+                auto it = connections.find(fd);
+                if (it == connections.end() ||
+                    it->second.generation != unpackGeneration(events[i].data.u64)) {
+                    continue;  // Stale event for a connection closed earlier in this batch
+                }
+
+                if (events[i].events & EPOLLIN) {
+                    if (!readFrom(it->second)) continue;
+                } else if (events[i].events & (EPOLLHUP | EPOLLERR)) {
+                    closeConnection(fd);
+                    continue;
+                }
+                if (events[i].events & EPOLLOUT) {
+                    flush(it->second);
+                }
+            }
+
+            inputsHandled.fetch_add(scheduler.runPending(), std::memory_order_relaxed);
+            flushDirty();
+            activeSessions.store(connections.size(), std::memory_order_relaxed);
+        }
+
+        std::vector<int> fds;
+        for (const auto& entry : connections) fds.push_back(entry.first);
+        for (int fd : fds) closeConnection(fd);
+        activeSessions.store(0);
+    }
+
+    void drainMailbox() {
+        std::vector<int> accepted;
+        {
+            std::lock_guard<std::mutex> lock(mailboxMutex);
+            accepted.swap(mailbox);
+        }
+
+        for (int fd : accepted) {
+            Connection connection{fd, nextGeneration++, 0, {}, {}, 0, false, false, false, false,
+                                  false, static_cast<uint32_t>(EPOLLIN | EPOLLRDHUP)};
+            epoll_event event{};
+            event.events = connection.interest;
+            event.data.u64 = packEventData(fd, connection.generation);
+            if (epoll_ctl(epollFd, EPOLL_CTL_ADD, fd, &event) < 0) {
+                ::close(fd);
+                continue;
+            }
+            connections.emplace(fd, std::move(connection));
+
+            openingFd = fd;
+            SessionId id = scheduler.openSession(seedSource());
+            openingFd = -1;
+
+            auto it = connections.find(fd);
+            if (it != connections.end()) {
+                it->second.session = id;
+                sessionFds[id] = fd;
+            }
+        }
+        flushDirty();
+        activeSessions.store(connections.size(), std::memory_order_relaxed);
+    }
+
+    // Returns false if the connection was closed
+    bool readFrom(Connection& connection) {
+        char buffer[READ_CHUNK];
+        bool peerClosed = false;
+        while (true) {
+            ssize_t received = ::recv(connection.fd, buffer, sizeof(buffer), 0);
+            if (received > 0) {
+                connection.input.append(buffer, static_cast<size_t>(received));
+                continue;
+            }
+            if (received == 0) {
+                peerClosed = true;
+            } else if (errno == EINTR) {
+                continue;
+            } else if (errno != EAGAIN && errno != EWOULDBLOCK) {
+                closeConnection(connection.fd);
+                return false;
+            }
+            break;
+        }
+
+        size_t lineStart = 0;
+        size_t newline;
+        while ((newline = connection.input.find('\n', lineStart)) != std::string::npos) {
+            size_t lineEnd = newline;
+            if (lineEnd > lineStart && connection.input[lineEnd - 1] == '\r') --lineEnd;
+            scheduler.submitInput(connection.session,
+                                  connection.input.substr(lineStart, lineEnd - lineStart));
+            lineStart = newline + 1;
+        }
+        connection.input.erase(0, lineStart);
+
+        if (connection.input.size() > MAX_LINE_LENGTH) {
+            closeConnection(connection.fd);
+            return false;
+        }
+        if (peerClosed) {
+            // A last line without its newline still counts. The lines go through runPending
+            // with everything else this iteration; the flush after it closes the connection.
+            if (!connection.input.empty()) {
+                scheduler.submitInput(connection.session, connection.input);
+                connection.input.clear();
+            }
+            connection.peerClosed = true;
+            connection.closeAfterFlush = true;
+            markDirty(connection);
+            updateInterest(connection);
+        }
+        return true;
+    }
+
+    void markDirty(Connection& connection) {
+        if (connection.dirty) return;
+        connection.dirty = true;
+        dirtyFds.push_back(connection.fd);
+    }
+
+    void queueFrame(SessionId id, const std::string& frame, bool finished) {
+        auto fdIt = sessionFds.find(id);
+        int fd = fdIt != sessionFds.end() ? fdIt->second : openingFd;
+        auto it = connections.find(fd);
+        if (it == connections.end()) return;
+
+        Connection& connection = it->second;
+        connection.output.append(frame);
+        connection.output.push_back(FRAME_TERMINATOR);
+        if (finished) connection.closeAfterFlush = true;
+        markDirty(connection);
+    }
+
+    void flushDirty() {
+        std::vector<int> fds;
+        fds.swap(dirtyFds);
+        for (int fd : fds) {
+            auto it = connections.find(fd);
+            if (it == connections.end()) continue;
+            it->second.dirty = false;
+            flush(it->second);
+        }
+    }
+
+    void flush(Connection& connection) {
+        if (connection.output.size() - connection.outputOffset > MAX_BUFFERED_OUTPUT) {
+            closeConnection(connection.fd);  // Not reading its frames at all
+            return;
+        }
+        while (connection.outputOffset < connection.output.size()) {
+            ssize_t sent = ::send(connection.fd, connection.output.data() + connection.outputOffset,
+                                  connection.output.size() - connection.outputOffset, MSG_NOSIGNAL);
+            if (sent > 0) {
+                connection.outputOffset += static_cast<size_t>(sent);
+                continue;
+            }
+            if (sent < 0 && errno == EINTR) continue;
+            if (sent < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+                connection.waitingForWritable = true;
+                connection.readPaused =
+                    connection.output.size() - connection.outputOffset > OUTPUT_HIGH_WATER;
+                updateInterest(connection);
+                return;
+            }
+            closeConnection(connection.fd);
+            return;
+        }
+
+        // Everything went out; keep the buffer's capacity for the next frame
+        connection.output.clear();
+        connection.outputOffset = 0;
+        if (connection.closeAfterFlush) {
+            closeConnection(connection.fd);
+            return;
+        }
+        connection.waitingForWritable = false;
+        connection.readPaused = false;
+        updateInterest(connection);
+    }
+
+    // Reads unless the client has half-closed or is behind on its frames; waits for writable
+    // while output is stuck
+    void updateInterest(Connection& connection) {
+        uint32_t interest = 0;
+        if (!connection.peerClosed && !connection.readPaused) {
+            interest |= static_cast<uint32_t>(EPOLLIN | EPOLLRDHUP);
+        }
+        if (connection.waitingForWritable) interest |= static_cast<uint32_t>(EPOLLOUT);
+        if (interest == connection.interest) return;
+        connection.interest = interest;
+        epoll_event event{};
+        event.events = interest;
+        event.data.u64 = packEventData(connection.fd, connection.generation);
+        epoll_ctl(epollFd, EPOLL_CTL_MOD, connection.fd, &event);
+    }
+
+    void closeConnection(int fd) {
+        auto it = connections.find(fd);
+        if (it == connections.end()) return;
+
+        SessionId id = it->second.session;
+        scheduler.closeSession(id);
+        sessionFds.erase(id);
+        epoll_ctl(epollFd, EPOLL_CTL_DEL, fd, nullptr);
+        ::close(fd);
+        connections.erase(it);
+    }
+};
+
+GameServer::GameServer(const GameServerConfig& config)
+    : config(config), epollFd(-1), stopEventFd(-1), connectionsAccepted(0), nextShard(0) {}
+
+GameServer::~GameServer() {
+    for (auto& shard : shards) {
+        shard->requestStop();
+    }
+    shards.clear();
+    closeListeners();
+    if (stopEventFd >= 0) ::close(stopEventFd);
+    if (epollFd >= 0) ::close(epollFd);
+}
+
+bool GameServer::start(std::string& error) {
+    if (config.socketPath.empty() && config.tcpPort == 0) {
+        error = "no listener configured (need a socket path or a TCP port)";
+        return false;
+    }
+
+    epollFd = epoll_create1(EPOLL_CLOEXEC);
+    stopEventFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (epollFd < 0 || stopEventFd < 0) {
+        error = errorText("epoll/eventfd");
+        return false;
+    }
+    epoll_event event{};
+    event.events = EPOLLIN;
+    event.data.fd = stopEventFd;
+    epoll_ctl(epollFd, EPOLL_CTL_ADD, stopEventFd, &event);
+
+    if (!config.socketPath.empty() && !listenUnix(error)) return false;
+    if (config.tcpPort != 0 && !listenTcp(error)) return false;
+
+    unsigned int workerCount = std::max(1u, config.workerCount);
+    for (unsigned int i = 0; i < workerCount; ++i) {
+        auto shard = std::make_unique<ServerShard>(i, config.pinWorkers);
+        if (!shard->open(error)) return false;
+        shards.push_back(std::move(shard));
+    }
+    for (auto& shard : shards) {
+        shard->startThread();
+    }
+    return true;
+}
+
+void GameServer::run() {
+    epoll_event events[MAX_EVENTS];
+    bool running = true;
+    while (running) {
+        int count = epoll_wait(epollFd, events, MAX_EVENTS, -1);
+        if (count < 0) {
+            if (errno == EINTR) continue;
+            break;
+        }
+        for (int i = 0; i < count; ++i) {
+            if (events[i].data.fd == stopEventFd) {
+                running = false;
+                break;
+            }
+            acceptConnections(events[i].data.fd);
+        }
+    }
+
+    closeListeners();
+    for (auto& shard : shards) {
+        shard->requestStop();
+    }
+    for (auto& shard : shards) {
+        shard->join();
+    }
+}
+
+void GameServer::stop() {
+    // write() is async-signal-safe, so this is fine from a signal handler
+    uint64_t one = 1;
+    ssize_t ignored = ::write(stopEventFd, &one, sizeof(one));
+    (void)ignored;
+}
+
+GameServerStats GameServer::getStats() const {
+    GameServerStats stats{connectionsAccepted.load(), 0, 0};
+    for (const auto& shard : shards) {
+        stats.activeSessions += shard->getActiveSessions();
+        stats.inputsHandled += shard->getInputsHandled();
+    }
+    return stats;
+}
+
+CommandLatencyTracker GameServer::collectLatency() const {
+    CommandLatencyTracker merged;
+    for (const auto& shard : shards) {
+        merged.merge(shard->getLatencyTracker());
+    }
+    return merged;
+}
+
+bool GameServer::listenUnix(std::string& error) {
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    if (config.socketPath.size() >= sizeof(address.sun_path)) {
+        error = "socket path too long: " + config.socketPath;
+        return false;
+    }
+    std::strncpy(address.sun_path, config.socketPath.c_str(), sizeof(address.sun_path) - 1);
+
+    int fd = ::socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (fd < 0) {
+        error = errorText("socket");
+        return false;
+    }
+    ::unlink(config.socketPath.c_str());  // Left behind by a previous run
+    if (::bind(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0 ||
+        ::listen(fd, SOMAXCONN) < 0) {
+        error = errorText("bind/listen on unix socket");
+        ::close(fd);
+        return false;
+    }
+
+    epoll_event event{};
+    event.events = EPOLLIN;
+    event.data.fd = fd;
+    epoll_ctl(epollFd, EPOLL_CTL_ADD, fd, &event);
+    listenFds.push_back(fd);
+    return true;
+}
+
+bool GameServer::listenTcp(std::string& error) {
+    int fd = ::socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (fd < 0) {
+        error = errorText("socket");
+        return false;
+    }
+    int enable = 1;
+    setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &enable, sizeof(enable));
+
+    sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_port = htons(static_cast<uint16_t>(config.tcpPort));
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    if (::bind(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0 ||
+        ::listen(fd, SOMAXCONN) < 0) {
+        error = errorText("bind/listen on tcp port");
+        ::close(fd);
+        return false;
+    }
+
+    epoll_event event{};
+    event.events = EPOLLIN;
+    event.data.fd = fd;
+    epoll_ctl(epollFd, EPOLL_CTL_ADD, fd, &event);
+    listenFds.push_back(fd);
+    return true;
+}
+
+void GameServer::acceptConnections(int listenFd) {
+    while (true) {
+        int fd = ::accept4(listenFd, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (fd < 0) {
+            if (errno == EINTR) continue;
+            return;  // EAGAIN: backlog drained (other errors: try again on the next wakeup)
+        }
+
+        int enable = 1;
+        setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &enable, sizeof(enable));  // No-op for AF_UNIX
+
+        connectionsAccepted.fetch_add(1, std::memory_order_relaxed);
+        shards[nextShard]->addConnection(fd);
+        nextShard = (nextShard + 1) % shards.size();
+    }
+}
+
+void GameServer::closeListeners() {
+    for (int fd : listenFds) {
+        ::close(fd);
+    }
+    listenFds.clear();
+    if (!config.socketPath.empty()) {
+        ::unlink(config.socketPath.c_str());
+    }
+}
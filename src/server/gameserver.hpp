@@ -0,0 +1,80 @@
+//
+// Created by Connor on 19/10/2026.
+//
+
+#ifndef TERMINAL_RPG_GAMESERVER_HPP
+#define TERMINAL_RPG_GAMESERVER_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../metrics/latencyhistogram.hpp"
+
+// Wire protocol: clients send newline-terminated lines (one answer per prompt). The server
+// answers every line with one frame: the session's text output followed by a single '\0'.
+// The connection is closed after the frame that ends the game.
+constexpr char FRAME_TERMINATOR = '\0';
+
+struct GameServerConfig {
+    std::string socketPath;  // Unix domain socket, empty to disable
+    int tcpPort;             // 127.0.0.1 TCP port, 0 to disable
+    unsigned int workerCount;
+    bool pinWorkers;  // Pin each shard's thread to its own core
+
+    GameServerConfig();
+};
+
+struct GameServerStats {
+    uint64_t connectionsAccepted;
+    uint64_t activeSessions;
+    uint64_t inputsHandled;
+};
+
+class ServerShard;
+
+// Serves many GameSessions from one process. The calling thread only accepts connections;
+// each accepted client is handed to one of workerCount shards. Every shard is a thread with its
+// own epoll loop and SessionScheduler, so a session is only ever touched by one thread and the
+// shared content databases are only read.
+class GameServer {
+public:
+    explicit GameServer(const GameServerConfig& config);
+    ~GameServer();
+
+    GameServer(const GameServer&) = delete;
+    GameServer& operator=(const GameServer&) = delete;
+
+    // Binds the listening sockets and starts the shard threads
+    bool start(std::string& error);
+
+    // Accepts connections until stop() is called, then shuts the shards down
+    void run();
+
+    // Safe to call from other threads and from signal handlers
+    void stop();
+
+    GameServerStats getStats() const;
+
+    // Per-command latency merged across shards; only meaningful once run() has returned
+    CommandLatencyTracker collectLatency() const;
+
+private:
+    GameServerConfig config;
+    int epollFd;
+    int stopEventFd;
+    std::vector<int> listenFds;
+    std::vector<std::unique_ptr<ServerShard>> shards;
+    std::atomic<uint64_t> connectionsAccepted;
+    size_t nextShard;
+
+    bool listenUnix(std::string& error);
+    bool listenTcp(std::string& error);
+    void acceptConnections(int listenFd);
+    void closeListeners();
+};
+
+#endif  // TERMINAL_RPG_GAMESERVER_HPP
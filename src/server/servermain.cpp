@@ -0,0 +1,105 @@
+#include <csignal>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+#include "combat/effectiveness.hpp"
+#include "enemies/enemydatabase.hpp"
+#include "items/itemdatabase.hpp"
+#include "levels/leveldatabase.hpp"
+#include "loot/loottable.hpp"
+#include "merchants/pricingengine.hpp"
+#include "server/gameserver.hpp"
+
+// Function declarations
+bool parseArguments(int argc, char* argv[], GameServerConfig& config);
+void printUsage(const char* program);
+void handleShutdownSignal(int signal);
+
+GameServer* runningServer = nullptr;
+
+int main(int argc, char* argv[]) {
+    GameServerConfig config;
+    if (!parseArguments(argc, argv, config)) {
+        printUsage(argv[0]);
+        return 1;
+    }
+
+    // Loaded once and only read afterwards, so every shard can share them
+    ItemDatabase::getInstance().initialize();
+    EnemyDatabase::getInstance().initialize();
+    LevelDatabase::getInstance().initialize();
+    LootTableDatabase::getInstance().initialize();
+    PricingEngine::getInstance().initialize();
+    std::string effectivenessError;
+    if (!EffectivenessMatrix::getInstance().loadOverridesFromEnvironment(effectivenessError)) {
+        std::cerr << "Bad effectiveness overrides: " << effectivenessError << '\n';
+        return 1;
+    }
+
+    GameServer server(config);
+    std::string error;
+    if (!server.start(error)) {
+        std::cerr << "Failed to start server: " << error << '\n';
+        return 1;
+    }
+
+    runningServer = &server;
+    std::signal(SIGINT, handleShutdownSignal);
+    std::signal(SIGTERM, handleShutdownSignal);
+    std::signal(SIGPIPE, SIG_IGN);
+
+    std::cout << "Terminal RPG server listening on";
+    if (!config.socketPath.empty()) std::cout << " unix:" << config.socketPath;
+    if (config.tcpPort != 0) std::cout << " tcp:127.0.0.1:" << config.tcpPort;
+    std::cout << " with " << config.workerCount << " worker(s)\n" << std::flush;
+
+    server.run();
+    runningServer = nullptr;
+
+    GameServerStats stats = server.getStats();
+    std::cout << "\nServer stopped. Connections accepted: " << stats.connectionsAccepted
+              << ", inputs handled: " << stats.inputsHandled << '\n';
+    std::cout << server.collectLatency().formatReport();
+    return 0;
+}
+
+bool parseArguments(int argc, char* argv[], GameServerConfig& config) {
+    for (int i = 1; i < argc; ++i) {
+        std::string argument = argv[i];
+        bool hasValue = i + 1 < argc;
+
+        if (argument == "--socket" && hasValue) {
+            config.socketPath = argv[++i];
+        } else if (argument == "--no-socket") {
+            config.socketPath.clear();
+        } else if (argument == "--port" && hasValue) {
+            config.tcpPort = std::atoi(argv[++i]);
+            if (config.tcpPort <= 0 || config.tcpPort > 65535) return false;
+        } else if (argument == "--workers" && hasValue) {
+            int workers = std::atoi(argv[++i]);
+            if (workers <= 0) return false;
+            config.workerCount = static_cast<unsigned int>(workers);
+        } else if (argument == "--no-pin") {
+            config.pinWorkers = false;
+        } else {
+            return false;
+        }
+    }
+    return true;
+}
+
+void printUsage(const char* program) {
+    std::cerr << "Usage: " << program
+              << " [--socket PATH | --no-socket] [--port N] [--workers N] [--no-pin]\n"
+              << "  --socket PATH  Unix domain socket to listen on\n"
+              << "                 (default /tmp/terminal_rpg.sock)\n"
+              << "  --no-socket    Don't listen on a Unix domain socket\n"
+              << "  --port N       Also listen on 127.0.0.1:N\n"
+              << "  --workers N    Number of session shards (default: one per core)\n"
+              << "  --no-pin       Don't pin shard threads to cores\n";
+}
+
+void handleShutdownSignal(int) {
+    if (runningServer) runningServer->stop();
+}
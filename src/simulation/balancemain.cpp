@@ -0,0 +1,263 @@
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+
+#include "combat/effectiveness.hpp"
+#include "enemies/enemydatabase.hpp"
+#include "items/itemdatabase.hpp"
+#include "levels/leveldatabase.hpp"
+#include "loot/loottable.hpp"
+#include "merchants/pricingengine.hpp"
+#include "player/player.hpp"
+#include "simulation/batchcombat.hpp"
+#include "simulation/combatsolver.hpp"
+
+struct BalanceOptions {
+    unsigned int fights = 10000;
+    int maxTurns = 500;
+    BatchPolicy policy = BatchPolicy::ATTACK_OR_DEFEND;
+    std::string weapon;
+    BatchKernel kernel = BatchCombat::getBestKernel();
+    uint32_t seed = 1;
+    bool exact = false;
+    unsigned int kills = 0;  // Item drop mode when set
+};
+
+// Function declarations
+bool parseArguments(int argc, char* argv[], BalanceOptions& options);
+void printUsage(const char* program);
+void printSimulatedTable(const Player& player, const BalanceOptions& options);
+void printExactTable(const Player& player, const BalanceOptions& options);
+void printDropTable(const BalanceOptions& options);
+
+int main(int argc, char* argv[]) {
+    BalanceOptions options;
+    if (!parseArguments(argc, argv, options)) {
+        printUsage(argv[0]);
+        return 1;
+    }
+
+    ItemDatabase::getInstance().initialize();
+    EnemyDatabase::getInstance().initialize();
+    LevelDatabase::getInstance().initialize();
+    LootTableDatabase::getInstance().initialize();
+    PricingEngine::getInstance().initialize();
+    std::string effectivenessError;
+    if (!EffectivenessMatrix::getInstance().loadOverridesFromEnvironment(effectivenessError)) {
+        std::cerr << "Bad effectiveness overrides: " << effectivenessError << '\n';
+        return 1;
+    }
+
+    if (options.kills > 0) {
+        printDropTable(options);
+        return 0;
+    }
+
+    // Same starting character as a new game
+    Player player("Simulated", 100, 100, 50, 50, 0, 0, 1, 0, 100, 100, 0);
+    std::unique_ptr<Item> weapon;
+    if (!options.weapon.empty()) {
+        weapon.reset(ItemDatabase::getInstance().createItem(options.weapon, 1));
+        if (!weapon || weapon->getType() != WEAPON) {
+            std::cerr << "Unknown weapon: " << options.weapon << '\n';
+            return 1;
+        }
+        player.setEquippedWeapon(weapon.get());
+    }
+
+    std::cout << "Weapon: " << (weapon ? weapon->getName() : "none") << '\n';
+    if (options.exact) {
+        printExactTable(player, options);
+    } else {
+        printSimulatedTable(player, options);
+    }
+    return 0;
+}
+
+bool parseArguments(int argc, char* argv[], BalanceOptions& options) {
+    for (int i = 1; i < argc; ++i) {
+        std::string argument = argv[i];
+        if (i + 1 >= argc) return false;
+        std::string value = argv[++i];
+
+        if (argument == "--fights") {
+            options.fights = static_cast<unsigned int>(std::strtoul(value.c_str(), nullptr, 10));
+            if (options.fights == 0) return false;
+        } else if (argument == "--max-turns") {
+            options.maxTurns = std::atoi(value.c_str());
+            if (options.maxTurns <= 0) return false;
+        } else if (argument == "--policy") {
+            if (value == "attack") {
+                options.policy = BatchPolicy::ATTACK;
+            } else if (value == "defend") {
+                options.policy = BatchPolicy::ATTACK_OR_DEFEND;
+            } else if (value == "power") {
+                options.policy = BatchPolicy::POWER_ATTACK_FIRST;
+            } else {
+                return false;
+            }
+        } else if (argument == "--weapon") {
+            options.weapon = value;
+        } else if (argument == "--kernel") {
+            if (value == "scalar") {
+                options.kernel = BatchKernel::SCALAR;
+            } else if (value == "sse4.1") {
+                options.kernel = BatchKernel::SSE41;
+            } else if (value == "avx2") {
+                options.kernel = BatchKernel::AVX2;
+            } else {
+                return false;
+            }
+        } else if (argument == "--exact") {
+            options.exact = value == "on" || value == "1" || value == "true";
+        } else if (argument == "--drops") {
+            options.kills = static_cast<unsigned int>(std::strtoul(value.c_str(), nullptr, 10));
+            if (options.kills == 0) return false;
+        } else if (argument == "--seed") {
+            options.seed = static_cast<uint32_t>(std::strtoul(value.c_str(), nullptr, 10));
+        } else {
+            return false;
+        }
+    }
+    return true;
+}
+
+void printUsage(const char* program) {
+    std::cerr << "Usage: " << program << " [options]\n"
+              << "  --fights N          Fights simulated per enemy (default 10000)\n"
+              << "  --max-turns N       Turn limit per fight (default 500)\n"
+              << "  --policy NAME       attack, defend (attack, defend when tired) or power\n"
+              << "                      (power attack when affordable); default defend\n"
+              << "  --weapon NAME       Equip a weapon from the item database\n"
+              << "  --kernel NAME       scalar, sse4.1 or avx2 (default: best supported)\n"
+              << "  --seed N            Base RNG seed (default 1)\n"
+              << "  --exact on          Solve every fight exactly instead of simulating, also\n"
+              << "                      showing the win rate of optimal play\n"
+              << "  --drops N           Roll item drops for N kills of every enemy instead of\n"
+              << "                      fighting, and show the item inflow per kill\n";
+}
+
+void printSimulatedTable(const Player& player, const BalanceOptions& options) {
+    std::cout << "Simulating " << options.fights << " fights per enemy ("
+              << getBatchKernelName(BatchCombat::isKernelSupported(options.kernel)
+                                        ? options.kernel
+                                        : BatchCombat::getBestKernel())
+              << " kernel)\n\n";
+    std::cout << std::left << std::setw(24) << "enemy" << std::right << std::setw(6) << "level"
+              << std::setw(9) << "win %" << std::setw(9) << "loss %" << std::setw(11)
+              << "timeout %" << std::setw(11) << "avg turns" << '\n';
+    std::cout << std::fixed << std::setprecision(1);
+
+    uint64_t totalTurns = 0;
+    std::chrono::steady_clock::duration simulationTime{};
+    for (const std::string& name : EnemyDatabase::getInstance().getAllEnemyNames()) {
+        std::unique_ptr<Enemy> enemy = EnemyDatabase::getInstance().createEnemy(name);
+
+        BatchCombat batch;
+        batch.setKernel(options.kernel);
+        for (unsigned int i = 0; i < options.fights; ++i) {
+            batch.addFight(makeFightSetup(player, *enemy, options.policy, options.seed + i));
+        }
+
+        auto start = std::chrono::steady_clock::now();
+        batch.run(options.maxTurns);
+        simulationTime += std::chrono::steady_clock::now() - start;
+
+        unsigned int wins = 0, losses = 0;
+        uint64_t turns = 0;
+        for (size_t i = 0; i < batch.getFightCount(); ++i) {
+            if (batch.getOutcome(i) == FightOutcome::PLAYER_WON) ++wins;
+            if (batch.getOutcome(i) == FightOutcome::PLAYER_LOST) ++losses;
+            turns += static_cast<uint64_t>(batch.getTurns(i));
+        }
+        totalTurns += turns;
+
+        double fights = static_cast<double>(options.fights);
+        std::cout << std::left << std::setw(24) << name << std::right << std::setw(6)
+                  << enemy->getLevel() << std::setw(9) << 100.0 * wins / fights << std::setw(9)
+                  << 100.0 * losses / fights << std::setw(11)
+                  << 100.0 * (options.fights - wins - losses) / fights << std::setw(11)
+                  << static_cast<double>(turns) / fights << '\n';
+    }
+
+    double seconds = std::chrono::duration<double>(simulationTime).count();
+    double turnsPerSecond = seconds > 0.0 ? static_cast<double>(totalTurns) / seconds : 0.0;
+    std::cout << "\nSimulated " << totalTurns << " turns in " << std::setprecision(3) << seconds
+              << "s (" << std::setprecision(1) << turnsPerSecond / 1e6 << "M turns/sec)\n";
+}
+
+void printExactTable(const Player& player, const BalanceOptions& options) {
+    std::cout << "Exact outcomes (policy win % vs best possible play)\n\n";
+    std::cout << std::left << std::setw(24) << "enemy" << std::right << std::setw(6) << "level"
+              << std::setw(9) << "win %" << std::setw(11) << "optimal %" << std::setw(11)
+              << "avg turns" << std::setw(15) << "best opening" << '\n';
+    std::cout << std::fixed << std::setprecision(2);
+
+    for (const std::string& name : EnemyDatabase::getInstance().getAllEnemyNames()) {
+        const EnemyTemplate* enemy = EnemyDatabase::getInstance().getEnemyTemplate(name);
+        CombatSolver solver(makeFightSetup(player, *enemy, options.policy, 0));
+        std::cout << std::left << std::setw(24) << name << std::right << std::setw(6)
+                  << enemy->level;
+        if (!solver.isTractable()) {
+            std::cout << "  (state space too large)\n";
+            continue;
+        }
+
+        CombatDistribution distribution = solver.evaluatePolicy(options.policy, options.maxTurns);
+        double optimal = solver.getOptimalWinProbability();
+        CombatAction opening = solver.getOptimalAction(
+            player.getHealth(), static_cast<int>(player.getStamina()), enemy->health);
+        std::cout << std::setw(9) << 100.0 * distribution.winProbability << std::setw(11)
+                  << 100.0 * optimal << std::setw(11) << distribution.getExpectedTurns()
+                  << std::setw(15) << getCombatActionName(opening) << '\n';
+    }
+}
+
+void printDropTable(const BalanceOptions& options) {
+    std::cout << "Item drops over " << options.kills << " kills per enemy\n\n";
+    std::cout << std::left << std::setw(24) << "enemy" << std::right << std::setw(6) << "level"
+              << std::setw(13) << "drops/kill" << std::setw(13) << "value/kill" << std::setw(9)
+              << "rare %" << '\n';
+    std::cout << std::fixed << std::setprecision(2);
+
+    const LootTableDatabase& loot = LootTableDatabase::getInstance();
+    const ItemDatabase& items = ItemDatabase::getInstance();
+    std::mt19937 rng(options.seed);
+    uint64_t totalKills = 0;
+    std::chrono::steady_clock::duration rollTime{};
+    for (const std::string& name : EnemyDatabase::getInstance().getAllEnemyNames()) {
+        const EnemyTemplate* enemy = EnemyDatabase::getInstance().getEnemyTemplate(name);
+
+        uint64_t drops = 0, value = 0, rare = 0;
+        auto start = std::chrono::steady_clock::now();
+        for (unsigned int kill = 0; kill < options.kills; ++kill) {
+            const ItemTemplate* dropped[LootTableDatabase::MAX_DROP_ROLLS];
+            int dropCount = loot.rollEnemyDrops(enemy->type, enemy->rarity, rng, dropped);
+            for (int i = 0; i < dropCount; ++i) {
+                // Create the item like the game would, so the allocation cost is counted
+                std::unique_ptr<Item> item(items.createItem(*dropped[i], 1));
+                value += static_cast<uint64_t>(item->getValue());
+                if (item->getRarity() >= RARE) ++rare;
+            }
+            drops += static_cast<uint64_t>(dropCount);
+        }
+        rollTime += std::chrono::steady_clock::now() - start;
+        totalKills += options.kills;
+
+        double kills = static_cast<double>(options.kills);
+        std::cout << std::left << std::setw(24) << name << std::right << std::setw(6)
+                  << enemy->level << std::setw(13) << static_cast<double>(drops) / kills
+                  << std::setw(13) << static_cast<double>(value) / kills << std::setw(9)
+                  << (drops ? 100.0 * static_cast<double>(rare) / static_cast<double>(drops) : 0.0)
+                  << '\n';
+    }
+
+    double seconds = std::chrono::duration<double>(rollTime).count();
+    double killsPerSecond = seconds > 0.0 ? static_cast<double>(totalKills) / seconds : 0.0;
+    std::cout << "\nRolled " << totalKills << " kills in " << std::setprecision(3) << seconds
+              << "s (" << std::setprecision(1) << killsPerSecond / 1e6 << "M kills/sec)\n";
+}
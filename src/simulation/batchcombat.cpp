@@ -0,0 +1,326 @@
+//
+// Created by Connor on 19/10/2026.
+//
+
+#include "batchcombat.hpp"
+
+#include <algorithm>
+
+#include "../combat/damagepipeline.hpp"
+#include "../combat/effectiveness.hpp"
+#include "batchcombatkernel.hpp"
+
+#if defined(TERMINAL_RPG_BATCH_SIMD) && defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace {
+uint32_t nextRandom(uint32_t& state) {
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    return state;
+}
+
+// min + uniform value in [0, span) using the top 16 bits of r (span is at most 65536)
+int32_t randomRange(uint32_t r, int32_t min, int32_t span) {
+    return min + static_cast<int32_t>(((r >> 16) * static_cast<uint32_t>(span)) >> 16);
+}
+
+// Hands the damage pipeline a lane's pre-drawn values, one per die
+struct LaneDraws {
+    uint32_t draws[3];  // Indexed by DamageRoll
+};
+
+int rollLaneDraw(void* state, DamageRoll roll, int min, int max) {
+    const LaneDraws& lane = *static_cast<const LaneDraws*>(state);
+    return randomRange(lane.draws[static_cast<int>(roll)], min, max - min + 1);
+}
+
+// Reference implementation of one turn for one fight, hitting through the same damage pipelines
+// as the game; the SIMD kernels compute exactly this
+void stepLane(const BatchCombatLanes& l, size_t i) {
+    uint32_t state = l.rng[i];
+    uint32_t accuracyDraw = nextRandom(state);
+    uint32_t damageDraw = nextRandom(state);
+    uint32_t critDraw = nextRandom(state);
+    uint32_t enemyDraw = nextRandom(state);
+    l.rng[i] = state;
+
+    bool armed = l.armed[i] != 0;
+    int32_t stamina = l.playerStamina[i];
+    int32_t powerCost = armed ? l.weaponPowerCost[i] : 15;
+    bool canAttack = stamina >= 5;
+    bool canPower = stamina >= powerCost;
+
+    // Choose the action
+    BatchPolicy policy = static_cast<BatchPolicy>(l.policy[i]);
+    bool choosePower = policy == BatchPolicy::POWER_ATTACK_FIRST && canPower;
+    bool chooseAttack = policy == BatchPolicy::ATTACK || (canAttack && !choosePower);
+    bool defending = !chooseAttack && !choosePower;
+    bool attacking = chooseAttack && canAttack;  // Too tired: the turn is lost
+    bool striking = attacking || choosePower;
+    bool acted = striking || defending;
+
+    if (attacking) stamina -= 5;
+    if (choosePower) stamina -= powerCost;
+    if (defending) stamina = std::min(stamina + l.defendRecovery[i], l.playerMaxStamina[i]);
+
+    // Player's strike
+    if (striking) {
+        LaneDraws draws = {{accuracyDraw, damageDraw, critDraw}};
+        DamageContext strike{};
+        strike.roller = rollLaneDraw;
+        strike.rollerState = &draws;
+        strike.power = choosePower;
+        strike.armed = armed;
+        strike.minDamage = l.weaponMinDamage[i];
+        strike.maxDamage = l.weaponMinDamage[i] + l.weaponDamageSpan[i] - 1;
+        strike.accuracy = l.weaponAccuracy[i];
+        strike.durability = l.weaponDurability[i];
+        strike.targetDefence = l.enemyDefence[i];
+        getPlayerStrikePipeline().run(strike);
+
+        if (armed) {
+            l.weaponDurability[i] = strike.durability;
+            if (strike.weaponBroke) l.armed[i] = 0;
+        }
+        l.enemyHealth[i] = std::max(l.enemyHealth[i] - strike.dealt, 0);
+    }
+    l.turns[i]++;
+    if (l.enemyHealth[i] <= 0) {
+        l.playerStamina[i] = stamina;
+        l.outcome[i] = static_cast<int32_t>(FightOutcome::PLAYER_WON);
+        return;
+    }
+
+    // Enemy's turn
+    if (acted) {
+        LaneDraws draws = {{0, enemyDraw, 0}};
+        DamageContext hit{};
+        hit.roller = rollLaneDraw;
+        hit.rollerState = &draws;
+        hit.minDamage = l.enemyMinAttack[i];
+        hit.maxDamage = l.enemyMinAttack[i] + l.enemyAttackSpan[i] - 1;
+        hit.targetDefence = l.playerDefence[i];
+        hit.targetDefending = defending;
+        getEnemyAttackPipeline().run(hit);
+        l.playerHealth[i] = std::max(l.playerHealth[i] - hit.dealt, 0);
+    }
+    if (!defending) stamina = std::min(stamina + l.regenRecovery[i], l.playerMaxStamina[i]);
+    l.playerStamina[i] = stamina;
+
+    if (l.playerHealth[i] <= 0) {
+        l.outcome[i] = static_cast<int32_t>(FightOutcome::PLAYER_LOST);
+    }
+}
+
+bool cpuSupports(BatchKernel kernel) {
+#if defined(TERMINAL_RPG_BATCH_SIMD)
+#if defined(_MSC_VER)
+    int info[4];
+    __cpuid(info, 0);
+    int highestLeaf = info[0];
+    if (highestLeaf < 1) return false;
+    __cpuidex(info, 1, 0);
+    bool sse41 = (info[2] & (1 << 19)) != 0;
+    bool osSavesYmm = (info[2] & (1 << 27)) != 0 && (_xgetbv(0) & 0x6) == 0x6;
+    bool avx = (info[2] & (1 << 28)) != 0 && osSavesYmm;
+    if (kernel == BatchKernel::SSE41) return sse41;
+    if (highestLeaf < 7) return false;
+    __cpuidex(info, 7, 0);
+    return avx && (info[1] & (1 << 5)) != 0;
+#else
+    __builtin_cpu_init();
+    if (kernel == BatchKernel::SSE41) return __builtin_cpu_supports("sse4.1");
+    return __builtin_cpu_supports("avx2");
+#endif
+#else
+    (void)kernel;
+    return false;
+#endif
+}
+
+// Turns a 32-bit seed into a non-zero xorshift state; neighbouring seeds end up far apart
+uint32_t seedState(uint32_t seed) {
+    uint32_t state = seed * 0x9E3779B9u + 0x7F4A7C15u;
+    state = (state ^ (state >> 16)) * 0x85EBCA6Bu;
+    state ^= state >> 13;
+    return state != 0 ? state : 0x6D2B79F5u;
+}
+}  // namespace
+
+void runBatchCombatScalar(const BatchCombatLanes& lanes, int maxTurns) {
+    for (size_t i = 0; i < lanes.count; ++i) {
+        for (int turn = 0; turn < maxTurns && lanes.outcome[i] == 0; ++turn) {
+            stepLane(lanes, i);
+        }
+    }
+}
+
+const char* getBatchKernelName(BatchKernel kernel) {
+    switch (kernel) {
+        case BatchKernel::SSE41:
+            return "sse4.1";
+        case BatchKernel::AVX2:
+            return "avx2";
+        default:
+            return "scalar";
+    }
+}
+
+FightSetup makeFightSetup(const Player& player, const Enemy& enemy, BatchPolicy policy,
+                          uint32_t seed) {
+    FightSetup setup{};
+    setup.playerHealth = player.getHealth();
+    setup.playerStamina = static_cast<int>(player.getStamina());
+    setup.playerMaxStamina = static_cast<int>(player.getMaxStamina());
+    setup.playerDefence = static_cast<int>(player.getDefence());
+    setup.enemyHealth = enemy.getHealth();
+    setup.enemyMinAttack = enemy.getMinAttack();
+    setup.enemyMaxAttack = enemy.getMaxAttack();
+    setup.enemyDefence = enemy.getDefence();
+
+    const Item* weapon = player.getEquippedWeapon();
+    setup.armed = weapon && weapon->getType() == WEAPON;
+    if (setup.armed) {
+        const WeaponData& weaponData = weapon->getWeaponData();
+        setup.weaponAccuracy = weaponData.getAccuracy();
+        setup.weaponStaminaCost = weaponData.getStaminaCost();
+        setup.weaponDurability = weaponData.getDurability();
+
+        // Effectiveness and the damage channel are fixed for the whole fight, so they're folded
+        // in here (exactly as the game aims a strike) and the kernels never see them
+        DamageContext strike{};
+        strike.armed = true;
+        strike.minDamage = weaponData.getMinDamage();
+        strike.maxDamage = weaponData.getMaxDamage();
+        aimStrike(strike, weaponData.getWeaponType(), enemy.getType(), enemy.getDefence(),
+                  enemy.getResistance());
+        setup.weaponMinDamage = strike.minDamage;
+        setup.weaponMaxDamage = strike.maxDamage;
+        setup.enemyDefence = strike.targetDefence;
+    }
+    setup.policy = policy;
+    setup.seed = seed;
+    return setup;
+}
+
+FightSetup makeFightSetup(const Player& player, const EnemyTemplate& enemy, BatchPolicy policy,
+                          uint32_t seed) {
+    Enemy instance(enemy.name, enemy.description, enemy.level, enemy.health, enemy.minAttack,
+                   enemy.maxAttack, enemy.defence, enemy.resistance, enemy.type, enemy.rarity);
+    return makeFightSetup(player, instance, policy, seed);
+}
+
+BatchCombat::BatchCombat() : kernel(getBestKernel()), fightCount(0) {}
+
+size_t BatchCombat::addFight(const FightSetup& setup) {
+    if (fightCount == outcome.size()) {
+        // Grow by a whole vector of finished padding lanes
+        size_t padded = outcome.size() + LANE_PADDING;
+        for (auto* lanes : {&playerHealth, &playerStamina, &playerMaxStamina, &playerDefence,
+                            &defendRecovery, &regenRecovery, &enemyHealth, &enemyDefence,
+                            &enemyMinAttack, &enemyAttackSpan, &armed, &weaponMinDamage,
+                            &weaponDamageSpan, &weaponAccuracy, &weaponPowerCost,
+                            &weaponDurability, &policy, &outcome, &turns}) {
+            lanes->resize(padded, 0);
+        }
+        rng.resize(padded, 1);
+        for (size_t lane = fightCount; lane < padded; ++lane) {
+            writeLane(lane, FightSetup{}, true);
+        }
+    }
+    writeLane(fightCount, setup, false);
+    return fightCount++;
+}
+
+size_t BatchCombat::getFightCount() const { return fightCount; }
+
+size_t BatchCombat::run(int maxTurns) {
+    BatchCombatLanes lanes{playerHealth.data(),     playerStamina.data(),  playerMaxStamina.data(),
+                           playerDefence.data(),    defendRecovery.data(), regenRecovery.data(),
+                           enemyHealth.data(),      enemyDefence.data(),   enemyMinAttack.data(),
+                           enemyAttackSpan.data(),  armed.data(),          weaponMinDamage.data(),
+                           weaponDamageSpan.data(), weaponAccuracy.data(), weaponPowerCost.data(),
+                           weaponDurability.data(), policy.data(),         outcome.data(),
+                           turns.data(),            rng.data(),            outcome.size()};
+
+    switch (kernel) {
+#if defined(TERMINAL_RPG_BATCH_SIMD)
+        case BatchKernel::AVX2:
+            runBatchCombatAvx2(lanes, maxTurns);
+            break;
+        case BatchKernel::SSE41:
+            runBatchCombatSse41(lanes, maxTurns);
+            break;
+#endif
+        default:
+            runBatchCombatScalar(lanes, maxTurns);
+            break;
+    }
+
+    return static_cast<size_t>(std::count(outcome.begin(), outcome.begin() + fightCount,
+                                          static_cast<int32_t>(FightOutcome::ONGOING)));
+}
+
+FightOutcome BatchCombat::getOutcome(size_t fight) const {
+    return static_cast<FightOutcome>(outcome[fight]);
+}
+
+int BatchCombat::getTurns(size_t fight) const { return turns[fight]; }
+
+int BatchCombat::getPlayerHealth(size_t fight) const { return playerHealth[fight]; }
+
+int BatchCombat::getPlayerStamina(size_t fight) const { return playerStamina[fight]; }
+
+int BatchCombat::getEnemyHealth(size_t fight) const { return enemyHealth[fight]; }
+
+int BatchCombat::getWeaponDurability(size_t fight) const { return weaponDurability[fight]; }
+
+bool BatchCombat::isArmed(size_t fight) const { return armed[fight] != 0; }
+
+BatchKernel BatchCombat::getKernel() const { return kernel; }
+
+void BatchCombat::setKernel(BatchKernel kernel) {
+    this->kernel = isKernelSupported(kernel) ? kernel : getBestKernel();
+}
+
+BatchKernel BatchCombat::getBestKernel() {
+    static const BatchKernel best = isKernelSupported(BatchKernel::AVX2)    ? BatchKernel::AVX2
+                                    : isKernelSupported(BatchKernel::SSE41) ? BatchKernel::SSE41
+                                                                            : BatchKernel::SCALAR;
+    return best;
+}
+
+bool BatchCombat::isKernelSupported(BatchKernel kernel) {
+    return kernel == BatchKernel::SCALAR || cpuSupports(kernel);
+}
+
+void BatchCombat::writeLane(size_t lane, const FightSetup& setup, bool finished) {
+    playerHealth[lane] = setup.playerHealth;
+    playerStamina[lane] = setup.playerStamina;
+    playerMaxStamina[lane] = setup.playerMaxStamina;
+    playerDefence[lane] = setup.playerDefence;
+    // Same fixed-point maths as the interactive loop so the recoveries match it exactly
+    unsigned int maxStamina = static_cast<unsigned int>(std::max(setup.playerMaxStamina, 0));
+    defendRecovery[lane] =
+        static_cast<int32_t>(getStaminaRecovery(maxStamina, DEFEND_STAMINA_RECOVERY));
+    regenRecovery[lane] =
+        static_cast<int32_t>(getStaminaRecovery(maxStamina, TURN_STAMINA_RECOVERY));
+    enemyHealth[lane] = setup.enemyHealth;
+    enemyDefence[lane] = setup.enemyDefence;
+    enemyMinAttack[lane] = setup.enemyMinAttack;
+    enemyAttackSpan[lane] = std::max(setup.enemyMaxAttack - setup.enemyMinAttack + 1, 1);
+    armed[lane] = setup.armed ? -1 : 0;
+    weaponMinDamage[lane] = setup.weaponMinDamage;
+    weaponDamageSpan[lane] = std::max(setup.weaponMaxDamage - setup.weaponMinDamage + 1, 1);
+    weaponAccuracy[lane] = setup.weaponAccuracy;
+    weaponPowerCost[lane] = setup.weaponStaminaCost * 3;
+    weaponDurability[lane] = setup.weaponDurability;
+    policy[lane] = static_cast<int32_t>(setup.policy);
+    outcome[lane] =
+        static_cast<int32_t>(finished ? FightOutcome::PLAYER_WON : FightOutcome::ONGOING);
+    turns[lane] = 0;
+    rng[lane] = seedState(setup.seed);
+}
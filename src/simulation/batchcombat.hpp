@@ -0,0 +1,117 @@
+//
+// Created by Connor on 19/10/2026.
+//
+
+#ifndef TERMINAL_RPG_BATCHCOMBAT_HPP
+#define TERMINAL_RPG_BATCHCOMBAT_HPP
+
+#include <cstdint>
+#include <vector>
+
+#include "../enemies/enemy.hpp"
+#include "../enemies/enemydatabase.hpp"
+#include "../items/item.hpp"
+#include "../player/player.hpp"
+
+// How a simulated player picks its action each turn (numbers match the combat menu)
+enum class BatchPolicy : int32_t {
+    ATTACK,             // Always 1. Attack, losing the turn when too tired
+    ATTACK_OR_DEFEND,   // 1. Attack, or 2. Defend when below 5 stamina
+    POWER_ATTACK_FIRST  // 3. Power Attack when affordable, else as ATTACK_OR_DEFEND
+};
+
+enum class FightOutcome : int32_t { ONGOING, PLAYER_WON, PLAYER_LOST };
+
+enum class BatchKernel { SCALAR, SSE41, AVX2 };
+
+const char* getBatchKernelName(BatchKernel kernel);
+
+// Starting state of one simulated fight
+struct FightSetup {
+    int playerHealth;
+    int playerStamina;
+    int playerMaxStamina;
+    int playerDefence;
+    int enemyHealth;
+    int enemyMinAttack;
+    int enemyMaxAttack;
+    int enemyDefence;  // What the player's strikes go against (resistance for staves)
+    bool armed;
+    int weaponMinDamage;  // Already scaled by the weapon's effectiveness against the enemy
+    int weaponMaxDamage;
+    int weaponAccuracy;
+    int weaponStaminaCost;
+    int weaponDurability;
+    BatchPolicy policy;
+    uint32_t seed;
+};
+
+// Snapshot of the player, their equipped weapon (if any) and an enemy, with the weapon aimed at
+// the enemy's type
+FightSetup makeFightSetup(const Player& player, const Enemy& enemy, BatchPolicy policy,
+                          uint32_t seed);
+FightSetup makeFightSetup(const Player& player, const EnemyTemplate& enemy, BatchPolicy policy,
+                          uint32_t seed);
+
+// Simulates many independent fights in lockstep using the attack / defend / power attack rules
+// of the interactive combat loop. Fights are stored structure-of-arrays so the AVX2 and SSE4.1
+// kernels can advance 8 or 4 of them per instruction; finished fights are masked out. The
+// scalar kernel is the reference, and all kernels give identical results for the same seeds
+// (the per-fight RNG is a xorshift32 drawn four times every turn).
+class BatchCombat {
+public:
+    BatchCombat();
+
+    // Adds a fight, returns its index
+    size_t addFight(const FightSetup& setup);
+    size_t getFightCount() const;
+
+    // Advances every ongoing fight by up to maxTurns turns, returns how many are still ongoing
+    size_t run(int maxTurns);
+
+    FightOutcome getOutcome(size_t fight) const;
+    int getTurns(size_t fight) const;
+    int getPlayerHealth(size_t fight) const;
+    int getPlayerStamina(size_t fight) const;
+    int getEnemyHealth(size_t fight) const;
+    int getWeaponDurability(size_t fight) const;
+    bool isArmed(size_t fight) const;
+
+    // Kernel used by run(); defaults to the best one the CPU supports
+    BatchKernel getKernel() const;
+    // Falls back to the best supported kernel if the requested one isn't available
+    void setKernel(BatchKernel kernel);
+
+    static BatchKernel getBestKernel();
+    static bool isKernelSupported(BatchKernel kernel);
+
+private:
+    static constexpr size_t LANE_PADDING = 8;  // Widest kernel (AVX2, 8 x int32)
+
+    BatchKernel kernel;
+    size_t fightCount;
+    std::vector<int32_t> playerHealth;
+    std::vector<int32_t> playerStamina;
+    std::vector<int32_t> playerMaxStamina;
+    std::vector<int32_t> playerDefence;
+    std::vector<int32_t> defendRecovery;
+    std::vector<int32_t> regenRecovery;
+    std::vector<int32_t> enemyHealth;
+    std::vector<int32_t> enemyDefence;
+    std::vector<int32_t> enemyMinAttack;
+    std::vector<int32_t> enemyAttackSpan;
+    std::vector<int32_t> armed;
+    std::vector<int32_t> weaponMinDamage;
+    std::vector<int32_t> weaponDamageSpan;
+    std::vector<int32_t> weaponAccuracy;
+    std::vector<int32_t> weaponPowerCost;
+    std::vector<int32_t> weaponDurability;
+    std::vector<int32_t> policy;
+    std::vector<int32_t> outcome;
+    std::vector<int32_t> turns;
+    std::vector<uint32_t> rng;
+
+    void writeLane(size_t lane, const FightSetup& setup, bool finished);
+};
+
+#endif  // TERMINAL_RPG_BATCHCOMBAT_HPP
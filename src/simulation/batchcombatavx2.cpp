@@ -0,0 +1,42 @@
+//
+// Created by Connor on 19/10/2026.
+//
+
+// Compiled with -mavx2 (see CMakeLists.txt); only called after a runtime CPU check
+
+#include <immintrin.h>
+
+#include "batchcombatsimd.hpp"
+
+namespace {
+struct Avx2 {
+    using Vec = __m256i;
+    static constexpr size_t WIDTH = 8;
+
+    static Vec load(const int32_t* p) {
+        return _mm256_loadu_si256(reinterpret_cast<const Vec*>(p));
+    }
+    static void store(int32_t* p, Vec v) { _mm256_storeu_si256(reinterpret_cast<Vec*>(p), v); }
+    static Vec set1(int32_t x) { return _mm256_set1_epi32(x); }
+    static Vec add(Vec a, Vec b) { return _mm256_add_epi32(a, b); }
+    static Vec sub(Vec a, Vec b) { return _mm256_sub_epi32(a, b); }
+    static Vec mullo(Vec a, Vec b) { return _mm256_mullo_epi32(a, b); }
+    static Vec srli(Vec a, int n) { return _mm256_srli_epi32(a, n); }
+    static Vec slli(Vec a, int n) { return _mm256_slli_epi32(a, n); }
+    static Vec srai(Vec a, int n) { return _mm256_srai_epi32(a, n); }
+    static Vec bitAnd(Vec a, Vec b) { return _mm256_and_si256(a, b); }
+    static Vec bitOr(Vec a, Vec b) { return _mm256_or_si256(a, b); }
+    static Vec bitXor(Vec a, Vec b) { return _mm256_xor_si256(a, b); }
+    static Vec andNot(Vec a, Vec b) { return _mm256_andnot_si256(a, b); }
+    static Vec cmpEq(Vec a, Vec b) { return _mm256_cmpeq_epi32(a, b); }
+    static Vec cmpGt(Vec a, Vec b) { return _mm256_cmpgt_epi32(a, b); }
+    static Vec min(Vec a, Vec b) { return _mm256_min_epi32(a, b); }
+    static Vec max(Vec a, Vec b) { return _mm256_max_epi32(a, b); }
+    static Vec select(Vec mask, Vec a, Vec b) { return _mm256_blendv_epi8(b, a, mask); }
+    static bool any(Vec mask) { return _mm256_movemask_epi8(mask) != 0; }
+};
+}  // namespace
+
+void runBatchCombatAvx2(const BatchCombatLanes& lanes, int maxTurns) {
+    SimdKernel<Avx2>::run(lanes, maxTurns);
+}
@@ -0,0 +1,49 @@
+//
+// Created by Connor on 19/10/2026.
+//
+
+#ifndef TERMINAL_RPG_BATCHCOMBATKERNEL_HPP
+#define TERMINAL_RPG_BATCHCOMBATKERNEL_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+// Kept free of standard library headers on purpose: the SIMD kernels are compiled with ISA
+// flags (-mavx2, -msse4.1), and any inline library code they instantiated could be merged by
+// the linker into callers running on CPUs without those instructions.
+
+// Raw SoA view of a batch of fights, one array element per fight ("lane"). count is padded to
+// a multiple of the widest vector, padding lanes start finished.
+struct BatchCombatLanes {
+    int32_t* playerHealth;
+    int32_t* playerStamina;
+    int32_t* playerMaxStamina;
+    int32_t* playerDefence;
+    int32_t* defendRecovery;  // Stamina recovered by defending (30% of max, as in the game)
+    int32_t* regenRecovery;   // Stamina recovered on non-defending turns (6% of max)
+    int32_t* enemyHealth;
+    int32_t* enemyDefence;
+    int32_t* enemyMinAttack;
+    int32_t* enemyAttackSpan;  // maxAttack - minAttack + 1
+    int32_t* armed;            // -1 while a weapon is equipped, 0 once unarmed (or broken)
+    int32_t* weaponMinDamage;
+    int32_t* weaponDamageSpan;
+    int32_t* weaponAccuracy;
+    int32_t* weaponPowerCost;  // Weapon stamina cost x3
+    int32_t* weaponDurability;
+    int32_t* policy;
+    int32_t* outcome;
+    int32_t* turns;
+    uint32_t* rng;  // xorshift32 state per lane
+    size_t count;
+};
+
+// Each kernel advances every unfinished lane by up to maxTurns turns, keeping a block of lanes
+// in registers for the whole run. All kernels produce bit-identical results.
+void runBatchCombatScalar(const BatchCombatLanes& lanes, int maxTurns);
+#if defined(TERMINAL_RPG_BATCH_SIMD)
+void runBatchCombatSse41(const BatchCombatLanes& lanes, int maxTurns);
+void runBatchCombatAvx2(const BatchCombatLanes& lanes, int maxTurns);
+#endif
+
+#endif  // TERMINAL_RPG_BATCHCOMBATKERNEL_HPP
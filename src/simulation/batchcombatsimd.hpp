@@ -0,0 +1,177 @@
+//
+// Created by Connor on 19/10/2026.
+//
+
+#ifndef TERMINAL_RPG_BATCHCOMBATSIMD_HPP
+#define TERMINAL_RPG_BATCHCOMBATSIMD_HPP
+
+#include "batchcombatkernel.hpp"
+
+// Lockstep combat turn shared by the SSE4.1 and AVX2 kernels. Only included by their
+// translation units, each of which supplies a vector type V wrapping its intrinsics:
+//   V::WIDTH, load, store, set1, add, sub, mullo, srli, slli, srai, bitAnd, bitOr, bitXor,
+//   andNot (~a & b), cmpEq, cmpGt, min, max, select (mask ? a : b), any
+// Masks are all-ones / all-zero lanes. Everything mirrors stepLane() in batchcombat.cpp.
+namespace {
+
+template <typename V>
+struct SimdKernel {
+    using Vec = typename V::Vec;
+
+    static Vec nextRandom(Vec& state) {
+        state = V::bitXor(state, V::slli(state, 13));
+        state = V::bitXor(state, V::srli(state, 17));
+        state = V::bitXor(state, V::slli(state, 5));
+        return state;
+    }
+
+    // min + uniform value in [0, span) using the top 16 bits of r
+    static Vec randomRange(Vec r, Vec min, Vec span) {
+        return V::add(min, V::srli(V::mullo(V::srli(r, 16), span), 16));
+    }
+
+    static void run(const BatchCombatLanes& lanes, int maxTurns) {
+        const Vec zero = V::set1(0);
+        const Vec one = V::set1(1);
+        const Vec two = V::set1(2);
+        const Vec five = V::set1(5);
+        const Vec ten = V::set1(10);
+        const Vec hundred = V::set1(100);
+        const Vec unarmedPowerCost = V::set1(15);
+        const Vec unarmedMin = V::set1(3);
+        const Vec unarmedSpan = V::set1(6);
+        const Vec unarmedPowerMin = V::set1(6);
+        const Vec unarmedPowerSpan = V::set1(11);
+        const Vec policyAttackOrDefend = V::set1(1);
+        const Vec policyPowerFirst = V::set1(2);
+        const Vec won = V::set1(1);
+        const Vec lost = V::set1(2);
+
+        for (size_t base = 0; base < lanes.count; base += V::WIDTH) {
+            Vec outcome = V::load(lanes.outcome + base);
+            Vec active = V::cmpEq(outcome, zero);
+            if (!V::any(active)) continue;
+
+            Vec playerHealth = V::load(lanes.playerHealth + base);
+            Vec stamina = V::load(lanes.playerStamina + base);
+            Vec maxStamina = V::load(lanes.playerMaxStamina + base);
+            Vec playerDefence = V::load(lanes.playerDefence + base);
+            Vec defendRecovery = V::load(lanes.defendRecovery + base);
+            Vec regenRecovery = V::load(lanes.regenRecovery + base);
+            Vec enemyHealth = V::load(lanes.enemyHealth + base);
+            Vec enemyDefence = V::load(lanes.enemyDefence + base);
+            Vec enemyMinAttack = V::load(lanes.enemyMinAttack + base);
+            Vec enemyAttackSpan = V::load(lanes.enemyAttackSpan + base);
+            Vec armed = V::load(lanes.armed + base);
+            Vec weaponMin = V::load(lanes.weaponMinDamage + base);
+            Vec weaponSpan = V::load(lanes.weaponDamageSpan + base);
+            Vec weaponAccuracy = V::load(lanes.weaponAccuracy + base);
+            Vec weaponPowerCost = V::load(lanes.weaponPowerCost + base);
+            Vec durability = V::load(lanes.weaponDurability + base);
+            Vec policy = V::load(lanes.policy + base);
+            Vec turns = V::load(lanes.turns + base);
+            Vec rng = V::load(reinterpret_cast<int32_t*>(lanes.rng) + base);
+
+            Vec policyAttackOnly = V::cmpEq(policy, zero);
+            Vec policyTired = V::cmpEq(policy, policyAttackOrDefend);
+            Vec policyPower = V::cmpEq(policy, policyPowerFirst);
+
+            for (int turn = 0; turn < maxTurns && V::any(active); ++turn) {
+                Vec state = rng;
+                Vec accuracyDraw = nextRandom(state);
+                Vec damageDraw = nextRandom(state);
+                Vec critDraw = nextRandom(state);
+                Vec enemyDraw = nextRandom(state);
+                rng = V::select(active, state, rng);
+
+                // Choose the action
+                Vec powerCost = V::select(armed, weaponPowerCost, unarmedPowerCost);
+                Vec canAttack = V::cmpGt(stamina, V::sub(five, one));
+                Vec canPower = V::andNot(V::cmpGt(powerCost, stamina), V::set1(-1));
+                Vec choosePower = V::bitAnd(policyPower, canPower);
+                Vec chooseAttack = V::bitOr(
+                    policyAttackOnly,
+                    V::bitAnd(canAttack, V::bitOr(policyTired, V::andNot(canPower, policyPower))));
+                Vec defending = V::andNot(V::bitOr(chooseAttack, choosePower), V::set1(-1));
+                Vec attacking = V::bitAnd(chooseAttack, canAttack);
+                Vec striking = V::bitOr(attacking, choosePower);
+                Vec acted = V::bitOr(striking, defending);
+
+                Vec newStamina = V::sub(V::sub(stamina, V::bitAnd(attacking, five)),
+                                        V::bitAnd(choosePower, powerCost));
+                newStamina = V::select(defending,
+                                       V::min(V::add(newStamina, defendRecovery), maxStamina),
+                                       newStamina);
+
+                // Player's strike
+                Vec accuracyRoll = randomRange(accuracyDraw, one, hundred);
+                Vec accuracyNeeded = V::sub(weaponAccuracy, V::bitAnd(choosePower, ten));
+                Vec hit = V::andNot(V::cmpGt(accuracyRoll, accuracyNeeded), V::set1(-1));
+                Vec weaponDamage = randomRange(damageDraw, weaponMin, weaponSpan);
+                Vec doubled = V::add(weaponDamage, weaponDamage);
+                weaponDamage = V::bitAnd(hit, V::select(choosePower, doubled, weaponDamage));
+                Vec unarmedDamage = V::select(
+                    choosePower, randomRange(damageDraw, unarmedPowerMin, unarmedPowerSpan),
+                    randomRange(damageDraw, unarmedMin, unarmedSpan));
+                Vec damage = V::bitAnd(striking, V::select(armed, weaponDamage, unarmedDamage));
+
+                Vec critRoll = randomRange(critDraw, one, hundred);
+                Vec crit = V::bitAnd(V::bitAnd(attacking, V::cmpGt(damage, zero)),
+                                     V::cmpGt(V::add(ten, one), critRoll));
+                damage = V::add(damage, V::bitAnd(crit, damage));
+
+                // Weapon wear (1 per hit, 2 per power hit, breaking at 0)
+                Vec wears = V::bitAnd(V::bitAnd(armed, V::bitAnd(striking, hit)),
+                                      V::cmpGt(durability, zero));
+                Vec wear = V::min(V::select(choosePower, two, one), durability);
+                Vec newDurability = V::sub(durability, V::bitAnd(wears, wear));
+                Vec broke = V::bitAnd(wears, V::cmpGt(one, newDurability));
+                Vec newArmed = V::andNot(broke, armed);
+
+                Vec dealt = V::bitAnd(V::cmpGt(damage, zero),
+                                      V::max(V::sub(damage, enemyDefence), zero));
+                Vec newEnemyHealth = V::max(V::sub(enemyHealth, dealt), zero);
+                Vec victory = V::bitAnd(active, V::cmpGt(one, newEnemyHealth));
+                Vec fighting = V::andNot(victory, active);
+
+                // Enemy's turn
+                Vec enemyDamage = randomRange(enemyDraw, enemyMinAttack, enemyAttackSpan);
+                Vec halved = V::srai(V::add(enemyDamage, V::srli(enemyDamage, 31)), 1);
+                enemyDamage = V::select(defending, halved, enemyDamage);
+                Vec taken = V::bitAnd(V::bitAnd(fighting, acted),
+                                      V::max(V::sub(enemyDamage, playerDefence), zero));
+                Vec newPlayerHealth = V::max(V::sub(playerHealth, taken), zero);
+
+                Vec regenerates = V::andNot(defending, fighting);
+                newStamina = V::select(regenerates,
+                                       V::min(V::add(newStamina, regenRecovery), maxStamina),
+                                       newStamina);
+                Vec defeat = V::bitAnd(fighting, V::cmpGt(one, newPlayerHealth));
+
+                // Commit the turn for active lanes only
+                stamina = V::select(active, newStamina, stamina);
+                durability = V::select(active, newDurability, durability);
+                armed = V::select(active, newArmed, armed);
+                enemyHealth = V::select(active, newEnemyHealth, enemyHealth);
+                playerHealth = V::select(active, newPlayerHealth, playerHealth);
+                turns = V::add(turns, V::bitAnd(active, one));
+                outcome = V::bitOr(outcome,
+                                   V::bitOr(V::bitAnd(victory, won), V::bitAnd(defeat, lost)));
+                active = V::cmpEq(outcome, zero);
+            }
+
+            V::store(lanes.playerHealth + base, playerHealth);
+            V::store(lanes.playerStamina + base, stamina);
+            V::store(lanes.enemyHealth + base, enemyHealth);
+            V::store(lanes.armed + base, armed);
+            V::store(lanes.weaponDurability + base, durability);
+            V::store(lanes.outcome + base, outcome);
+            V::store(lanes.turns + base, turns);
+            V::store(reinterpret_cast<int32_t*>(lanes.rng) + base, rng);
+        }
+    }
+};
+
+}  // namespace
+
+#endif  // TERMINAL_RPG_BATCHCOMBATSIMD_HPP
@@ -0,0 +1,40 @@
+//
+// Created by Connor on 19/10/2026.
+//
+
+// Compiled with -msse4.1 (see CMakeLists.txt); only called after a runtime CPU check
+
+#include <smmintrin.h>
+
+#include "batchcombatsimd.hpp"
+
+namespace {
+struct Sse41 {
+    using Vec = __m128i;
+    static constexpr size_t WIDTH = 4;
+
+    static Vec load(const int32_t* p) { return _mm_loadu_si128(reinterpret_cast<const Vec*>(p)); }
+    static void store(int32_t* p, Vec v) { _mm_storeu_si128(reinterpret_cast<Vec*>(p), v); }
+    static Vec set1(int32_t x) { return _mm_set1_epi32(x); }
+    static Vec add(Vec a, Vec b) { return _mm_add_epi32(a, b); }
+    static Vec sub(Vec a, Vec b) { return _mm_sub_epi32(a, b); }
+    static Vec mullo(Vec a, Vec b) { return _mm_mullo_epi32(a, b); }
+    static Vec srli(Vec a, int n) { return _mm_srli_epi32(a, n); }
+    static Vec slli(Vec a, int n) { return _mm_slli_epi32(a, n); }
+    static Vec srai(Vec a, int n) { return _mm_srai_epi32(a, n); }
+    static Vec bitAnd(Vec a, Vec b) { return _mm_and_si128(a, b); }
+    static Vec bitOr(Vec a, Vec b) { return _mm_or_si128(a, b); }
+    static Vec bitXor(Vec a, Vec b) { return _mm_xor_si128(a, b); }
+    static Vec andNot(Vec a, Vec b) { return _mm_andnot_si128(a, b); }
+    static Vec cmpEq(Vec a, Vec b) { return _mm_cmpeq_epi32(a, b); }
+    static Vec cmpGt(Vec a, Vec b) { return _mm_cmpgt_epi32(a, b); }
+    static Vec min(Vec a, Vec b) { return _mm_min_epi32(a, b); }
+    static Vec max(Vec a, Vec b) { return _mm_max_epi32(a, b); }
+    static Vec select(Vec mask, Vec a, Vec b) { return _mm_blendv_epi8(b, a, mask); }
+    static bool any(Vec mask) { return _mm_movemask_epi8(mask) != 0; }
+};
+}  // namespace
+
+void runBatchCombatSse41(const BatchCombatLanes& lanes, int maxTurns) {
+    SimdKernel<Sse41>::run(lanes, maxTurns);
+}
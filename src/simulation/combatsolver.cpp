@@ -0,0 +1,405 @@
+//
+// Created by Connor on 19/10/2026.
+//
+
+#include "combatsolver.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <map>
+
+namespace {
+constexpr int MAX_LAYER_SWEEPS = 100000;
+constexpr double CONVERGENCE_TOLERANCE = 1e-15;
+
+// One entry per value, leaving out values that can't happen
+std::vector<std::pair<int, double>> collapse(const std::map<int, double>& probabilities) {
+    std::vector<std::pair<int, double>> distribution;
+    for (const auto& entry : probabilities) {
+        if (entry.second > 0.0) distribution.push_back(entry);
+    }
+    return distribution;
+}
+
+// Chance a 1-100 roll is at or under the given accuracy
+double hitChance(int accuracy) { return std::min(std::max(accuracy, 0), 100) / 100.0; }
+}  // namespace
+
+const char* getCombatActionName(CombatAction action) {
+    switch (action) {
+        case CombatAction::ATTACK:
+            return "attack";
+        case CombatAction::DEFEND:
+            return "defend";
+        case CombatAction::POWER_ATTACK:
+            return "power attack";
+        default:
+            return "unknown";
+    }
+}
+
+double CombatDistribution::getExpectedTurns() const {
+    double resolved = 0.0;
+    double weighted = 0.0;
+    for (size_t t = 0; t < winsByTurn.size(); ++t) {
+        double finished = winsByTurn[t] + lossesByTurn[t];
+        resolved += finished;
+        weighted += finished * static_cast<double>(t + 1);
+    }
+    return resolved > 0.0 ? weighted / resolved : 0.0;
+}
+
+CombatSolver::CombatSolver(const FightSetup& setup)
+    : setup(setup),
+      maxEnemyHealth(std::max(setup.enemyHealth, 0)),
+      maxPlayerHealth(std::max(setup.playerHealth, 0)),
+      maxStamina(std::max(setup.playerMaxStamina, 0)),
+      powerCost(setup.armed ? setup.weaponStaminaCost * 3 : 15) {
+    // Same fixed-point maths as the interactive loop
+    unsigned int staminaBase = static_cast<unsigned int>(maxStamina);
+    defendRecovery = static_cast<int>(getStaminaRecovery(staminaBase, DEFEND_STAMINA_RECOVERY));
+    regenRecovery = static_cast<int>(getStaminaRecovery(staminaBase, TURN_STAMINA_RECOVERY));
+
+    auto dealtAfterDefence = [&setup](int damage) {
+        return damage > 0 ? std::max(damage - setup.enemyDefence, 0) : 0;
+    };
+
+    // Normal attack: accuracy roll, uniform damage, 10% crit on any damaging hit
+    std::map<int, double> attack;
+    std::map<int, double> power;
+    if (setup.armed) {
+        int span = std::max(setup.weaponMaxDamage - setup.weaponMinDamage + 1, 1);
+        double hit = hitChance(setup.weaponAccuracy);
+        double powerHit = hitChance(setup.weaponAccuracy - 10);
+        attack[0] += 1.0 - hit;
+        power[0] += 1.0 - powerHit;
+        for (int damage = setup.weaponMinDamage; damage < setup.weaponMinDamage + span; ++damage) {
+            double each = hit / span;
+            if (damage > 0) {
+                attack[dealtAfterDefence(damage)] += each * 0.9;
+                attack[dealtAfterDefence(damage * 2)] += each * 0.1;
+            } else {
+                attack[0] += each;
+            }
+            power[dealtAfterDefence(damage * 2)] += powerHit / span;
+        }
+    } else {
+        for (int damage = 3; damage <= 8; ++damage) {
+            attack[dealtAfterDefence(damage)] += 0.9 / 6;
+            attack[dealtAfterDefence(damage * 2)] += 0.1 / 6;
+        }
+        for (int damage = 6; damage <= 16; ++damage) {
+            power[dealtAfterDefence(damage)] += 1.0 / 11;
+        }
+    }
+    dealt[static_cast<size_t>(CombatAction::ATTACK)] = collapse(attack);
+    dealt[static_cast<size_t>(CombatAction::POWER_ATTACK)] = collapse(power);
+    dealt[static_cast<size_t>(CombatAction::DEFEND)] = {{0, 1.0}};
+
+    std::map<int, double> normalHit;
+    std::map<int, double> blockedHit;
+    int enemySpan = std::max(setup.enemyMaxAttack - setup.enemyMinAttack + 1, 1);
+    for (int damage = setup.enemyMinAttack; damage < setup.enemyMinAttack + enemySpan; ++damage) {
+        normalHit[std::max(damage - setup.playerDefence, 0)] += 1.0 / enemySpan;
+        blockedHit[std::max(damage / 2 - setup.playerDefence, 0)] += 1.0 / enemySpan;
+    }
+    taken[0] = collapse(normalHit);
+    taken[1] = collapse(blockedHit);
+}
+
+bool CombatSolver::isTractable() const {
+    return getStateCount() <= MAX_STATES && maxEnemyHealth > 0 && maxPlayerHealth > 0;
+}
+
+size_t CombatSolver::getStateCount() const {
+    return static_cast<size_t>(maxEnemyHealth + 1) * static_cast<size_t>(maxPlayerHealth + 1) *
+           static_cast<size_t>(maxStamina + 1);
+}
+
+double CombatSolver::getPolicyWinProbability(BatchPolicy policy) const {
+    if (!isTractable()) return 0.0;
+    std::vector<double> values;
+    solve(false, policy, values, nullptr);
+    return values[index(maxEnemyHealth, maxPlayerHealth,
+                        std::min(std::max(setup.playerStamina, 0), maxStamina))];
+}
+
+double CombatSolver::getOptimalWinProbability() {
+    if (!isTractable()) return 0.0;
+    if (optimalValues.empty()) {
+        solve(true, BatchPolicy::ATTACK, optimalValues, &optimalActions);
+    }
+    return optimalValues[index(maxEnemyHealth, maxPlayerHealth,
+                               std::min(std::max(setup.playerStamina, 0), maxStamina))];
+}
+
+CombatAction CombatSolver::getOptimalAction(int playerHealth, int stamina, int enemyHealth) {
+    if (!isTractable() || playerHealth <= 0 || enemyHealth <= 0) return CombatAction::ATTACK;
+    getOptimalWinProbability();
+    playerHealth = std::min(playerHealth, maxPlayerHealth);
+    enemyHealth = std::min(enemyHealth, maxEnemyHealth);
+    stamina = std::min(std::max(stamina, 0), maxStamina);
+    return static_cast<CombatAction>(optimalActions[index(enemyHealth, playerHealth, stamina)]);
+}
+
+CombatDistribution CombatSolver::evaluatePolicy(BatchPolicy policy, int maxTurns) const {
+    return propagate([this, policy](size_t, int stamina) { return choose(policy, stamina); },
+                     maxTurns);
+}
+
+CombatDistribution CombatSolver::evaluateOptimalPolicy(int maxTurns) {
+    getOptimalWinProbability();
+    return propagate(
+        [this](size_t state, int) { return static_cast<CombatAction>(optimalActions[state]); },
+        maxTurns);
+}
+
+size_t CombatSolver::index(int enemyHealth, int playerHealth, int stamina) const {
+    return (static_cast<size_t>(enemyHealth) * static_cast<size_t>(maxPlayerHealth + 1) +
+            static_cast<size_t>(playerHealth)) *
+               static_cast<size_t>(maxStamina + 1) +
+           static_cast<size_t>(stamina);
+}
+
+bool CombatSolver::losesTurn(CombatAction action, int stamina) const {
+    // Too tired to attack: no strike, no enemy turn, just natural recovery
+    return (action == CombatAction::ATTACK && stamina < 5) ||
+           (action == CombatAction::POWER_ATTACK && stamina < powerCost);
+}
+
+int CombatSolver::staminaAfter(CombatAction action, int stamina) const {
+    if (losesTurn(action, stamina)) return std::min(stamina + regenRecovery, maxStamina);
+    switch (action) {
+        case CombatAction::DEFEND:
+            return std::min(stamina + defendRecovery, maxStamina);
+        case CombatAction::POWER_ATTACK:
+            return std::min(stamina - powerCost + regenRecovery, maxStamina);
+        default:
+            return std::min(stamina - 5 + regenRecovery, maxStamina);
+    }
+}
+
+CombatAction CombatSolver::choose(BatchPolicy policy, int stamina) const {
+    // Mirrors BatchCombat's policies
+    switch (policy) {
+        case BatchPolicy::ATTACK:
+            return CombatAction::ATTACK;
+        case BatchPolicy::POWER_ATTACK_FIRST:
+            if (stamina >= powerCost) return CombatAction::POWER_ATTACK;
+            return stamina >= 5 ? CombatAction::ATTACK : CombatAction::DEFEND;
+        default:
+            return stamina >= 5 ? CombatAction::ATTACK : CombatAction::DEFEND;
+    }
+}
+
+void CombatSolver::solve(bool optimal, BatchPolicy policy, std::vector<double>& values,
+                         std::vector<uint8_t>* actions) const {
+    size_t stateCount = getStateCount();
+    values.assign(stateCount, 0.0);
+    if (actions) actions->assign(stateCount, static_cast<uint8_t>(CombatAction::ATTACK));
+
+    // afterEnemy[k][state] = value of reaching state just before the enemy's turn (k = 1 when
+    // defending), i.e. the expectation over the enemy's hit. Filled one enemy-health row at a
+    // time, once the row's values are final.
+    std::vector<double> afterEnemy[2] = {std::vector<double>(stateCount, 0.0),
+                                         std::vector<double>(stateCount, 0.0)};
+
+    const int actionCount = static_cast<int>(CombatAction::COUNT);
+    int stride = maxStamina + 1;
+    std::vector<double> known(static_cast<size_t>(stride * actionCount));
+    std::vector<double> selfChance(static_cast<size_t>(stride * actionCount));
+    std::vector<int> nextStamina(static_cast<size_t>(stride * actionCount));
+    std::vector<uint8_t> allowed(static_cast<size_t>(stride * actionCount));
+
+    for (int e = 1; e <= maxEnemyHealth; ++e) {
+        for (int h = 1; h <= maxPlayerHealth; ++h) {
+            // Everything except the "nobody was hurt" branch only reaches solved layers
+            for (int s = 0; s <= maxStamina; ++s) {
+                for (int a = 0; a < actionCount; ++a) {
+                    CombatAction action = static_cast<CombatAction>(a);
+                    size_t slot = static_cast<size_t>(s * actionCount + a);
+                    allowed[slot] = optimal || choose(policy, s) == action;
+                    if (!allowed[slot]) continue;
+
+                    int next = staminaAfter(action, s);
+                    nextStamina[slot] = next;
+                    if (losesTurn(action, s)) {
+                        known[slot] = 0.0;
+                        selfChance[slot] = 1.0;
+                        continue;
+                    }
+
+                    int defending = action == CombatAction::DEFEND ? 1 : 0;
+                    double value = 0.0;
+                    double missChance = 0.0;
+                    for (const auto& hit : dealt[a]) {
+                        if (hit.first == 0) {
+                            missChance = hit.second;
+                        } else if (e - hit.first <= 0) {
+                            value += hit.second;
+                        } else {
+                            size_t target = index(e - hit.first, h, next);
+                            value += hit.second * afterEnemy[defending][target];
+                        }
+                    }
+
+                    double unhurtChance = 0.0;
+                    double hurtValue = 0.0;
+                    for (const auto& blow : taken[defending]) {
+                        if (blow.first == 0) {
+                            unhurtChance = blow.second;
+                        } else if (h - blow.first > 0) {
+                            hurtValue += blow.second * values[index(e, h - blow.first, next)];
+                        }
+                    }
+                    known[slot] = value + missChance * hurtValue;
+                    selfChance[slot] = missChance * unhurtChance;
+                }
+            }
+
+            // Same-layer fixed point over stamina (monotone from 0, so it converges to the
+            // least fixed point: the probability of eventually winning)
+            size_t layer = index(e, h, 0);
+            for (int sweep = 0; sweep < MAX_LAYER_SWEEPS; ++sweep) {
+                double change = 0.0;
+                for (int s = 0; s <= maxStamina; ++s) {
+                    double best = -1.0;
+                    int bestAction = 0;
+                    for (int a = 0; a < actionCount; ++a) {
+                        size_t slot = static_cast<size_t>(s * actionCount + a);
+                        if (!allowed[slot]) continue;
+                        double value =
+                            known[slot] + selfChance[slot] * values[layer + nextStamina[slot]];
+                        if (value > best + 1e-12) {
+                            best = value;
+                            bestAction = a;
+                        }
+                    }
+                    change = std::max(change, std::fabs(best - values[layer + s]));
+                    values[layer + s] = best;
+                    if (actions) (*actions)[layer + s] = static_cast<uint8_t>(bestAction);
+                }
+                if (change <= CONVERGENCE_TOLERANCE) break;
+            }
+        }
+
+        for (int defending = 0; defending < 2; ++defending) {
+            for (int h = 1; h <= maxPlayerHealth; ++h) {
+                for (int s = 0; s <= maxStamina; ++s) {
+                    double value = 0.0;
+                    for (const auto& blow : taken[defending]) {
+                        if (h - blow.first > 0) {
+                            value += blow.second * values[index(e, h - blow.first, s)];
+                        }
+                    }
+                    afterEnemy[defending][index(e, h, s)] = value;
+                }
+            }
+        }
+    }
+}
+
+template <typename ChooseAction>
+CombatDistribution CombatSolver::propagate(ChooseAction chooseAction, int maxTurns) const {
+    CombatDistribution result{0.0, 0.0, 0.0, {}, {}};
+    if (!isTractable()) return result;
+
+    // Probability mass per state, kept sparse through lists of the states that hold any
+    size_t stateCount = getStateCount();
+    std::vector<double> current(stateCount, 0.0);
+    std::vector<double> next(stateCount, 0.0);
+    std::vector<double> beforeEnemy[2] = {std::vector<double>(stateCount, 0.0),
+                                          std::vector<double>(stateCount, 0.0)};
+    std::vector<uint8_t> queued(stateCount, 0);
+    std::vector<uint8_t> queuedBeforeEnemy[2] = {std::vector<uint8_t>(stateCount, 0),
+                                                 std::vector<uint8_t>(stateCount, 0)};
+    std::vector<size_t> active;
+    std::vector<size_t> nextActive;
+    std::vector<size_t> waiting[2];
+
+    auto addNext = [&](size_t state, double mass) {
+        if (!queued[state]) {
+            queued[state] = 1;
+            nextActive.push_back(state);
+        }
+        next[state] += mass;
+    };
+
+    size_t start = index(maxEnemyHealth, maxPlayerHealth,
+                         std::min(std::max(setup.playerStamina, 0), maxStamina));
+    current[start] = 1.0;
+    active.push_back(start);
+
+    size_t healthStride = static_cast<size_t>(maxStamina + 1);
+    size_t enemyStride = static_cast<size_t>(maxPlayerHealth + 1) * healthStride;
+
+    for (int turn = 0; turn < maxTurns && !active.empty(); ++turn) {
+        double wins = 0.0;
+        double losses = 0.0;
+
+        // Player's action
+        for (size_t state : active) {
+            double mass = current[state];
+            current[state] = 0.0;
+            int e = static_cast<int>(state / enemyStride);
+            int h = static_cast<int>(state % enemyStride / healthStride);
+            int s = static_cast<int>(state % healthStride);
+
+            CombatAction action = chooseAction(state, s);
+            int stamina = staminaAfter(action, s);
+            if (losesTurn(action, s)) {
+                addNext(index(e, h, stamina), mass);  // The enemy doesn't get a turn either
+                continue;
+            }
+
+            int defending = action == CombatAction::DEFEND ? 1 : 0;
+            for (const auto& hit : dealt[static_cast<size_t>(action)]) {
+                double p = mass * hit.second;
+                if (e - hit.first <= 0) {
+                    wins += p;
+                    continue;
+                }
+                size_t target = index(e - hit.first, h, stamina);
+                if (!queuedBeforeEnemy[defending][target]) {
+                    queuedBeforeEnemy[defending][target] = 1;
+                    waiting[defending].push_back(target);
+                }
+                beforeEnemy[defending][target] += p;
+            }
+        }
+
+        // Enemy's turn
+        for (int defending = 0; defending < 2; ++defending) {
+            for (size_t state : waiting[defending]) {
+                double mass = beforeEnemy[defending][state];
+                beforeEnemy[defending][state] = 0.0;
+                queuedBeforeEnemy[defending][state] = 0;
+                int h = static_cast<int>(state % enemyStride / healthStride);
+                for (const auto& blow : taken[defending]) {
+                    double p = mass * blow.second;
+                    if (h - blow.first <= 0) {
+                        losses += p;
+                    } else {
+                        addNext(state - static_cast<size_t>(blow.first) * healthStride, p);
+                    }
+                }
+            }
+            waiting[defending].clear();
+        }
+
+        result.winProbability += wins;
+        result.lossProbability += losses;
+        result.winsByTurn.push_back(wins);
+        result.lossesByTurn.push_back(losses);
+
+        std::swap(current, next);
+        active.swap(nextActive);
+        nextActive.clear();
+        for (size_t state : active) queued[state] = 0;
+    }
+
+    for (size_t state : active) {
+        result.unresolvedProbability += current[state];
+    }
+    return result;
+}
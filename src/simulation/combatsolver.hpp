@@ -0,0 +1,88 @@
+//
+// Created by Connor on 19/10/2026.
+//
+
+#ifndef TERMINAL_RPG_COMBATSOLVER_HPP
+#define TERMINAL_RPG_COMBATSOLVER_HPP
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "batchcombat.hpp"
+
+enum class CombatAction : uint8_t { ATTACK, DEFEND, POWER_ATTACK, COUNT };
+
+const char* getCombatActionName(CombatAction action);
+
+// Exact outcome distribution of a fight under some policy
+struct CombatDistribution {
+    double winProbability;
+    double lossProbability;
+    double unresolvedProbability;     // Still fighting after the turn limit (e.g. a stalemate)
+    std::vector<double> winsByTurn;    // [t] = probability of winning on turn t + 1
+    std::vector<double> lossesByTurn;  // [t] = probability of losing on turn t + 1
+
+    // Mean fight length over the fights that finished within the turn limit
+    double getExpectedTurns() const;
+};
+
+// Solves a fight exactly over the discrete (player health, stamina, enemy health) state space,
+// with the same rules as the interactive combat loop and BatchCombat: weapon accuracy, uniform
+// damage ranges, the 10% crit, power attacks, defend halving and stamina recovery. Weapon wear
+// is not part of the state, so the weapon is assumed to last the whole fight.
+//
+// Policy values come from a memoized DP over layers (enemy health, player health) in increasing
+// order. Transitions only ever reach the same or an earlier layer; the same-layer part (nobody
+// took damage, only stamina changed) is resolved by iterating to a fixed point.
+class CombatSolver {
+public:
+    explicit CombatSolver(const FightSetup& setup);
+
+    // State spaces above this many states are refused (memory use is ~25 bytes per state)
+    static constexpr size_t MAX_STATES = size_t{1} << 23;
+
+    bool isTractable() const;
+    size_t getStateCount() const;
+
+    // Win probability under a fixed policy, no turn limit
+    double getPolicyWinProbability(BatchPolicy policy) const;
+
+    // Best achievable win probability, and the action that achieves it in a given state
+    double getOptimalWinProbability();
+    CombatAction getOptimalAction(int playerHealth, int stamina, int enemyHealth);
+
+    // Outcome and fight length distribution, propagating forward from the starting state
+    CombatDistribution evaluatePolicy(BatchPolicy policy, int maxTurns) const;
+    CombatDistribution evaluateOptimalPolicy(int maxTurns);
+
+private:
+    using Distribution = std::vector<std::pair<int, double>>;  // (value, probability)
+
+    FightSetup setup;
+    int maxEnemyHealth;
+    int maxPlayerHealth;
+    int maxStamina;
+    int powerCost;
+    int defendRecovery;
+    int regenRecovery;
+    Distribution dealt[static_cast<size_t>(CombatAction::COUNT)];  // Damage to the enemy
+    Distribution taken[2];  // Damage to the player: [0] normal, [1] defending
+
+    std::vector<double> optimalValues;
+    std::vector<uint8_t> optimalActions;
+
+    size_t index(int enemyHealth, int playerHealth, int stamina) const;
+    bool losesTurn(CombatAction action, int stamina) const;
+    int staminaAfter(CombatAction action, int stamina) const;
+    CombatAction choose(BatchPolicy policy, int stamina) const;
+
+    // Fills values (and actions when optimising) for every state
+    void solve(bool optimal, BatchPolicy policy, std::vector<double>& values,
+               std::vector<uint8_t>* actions) const;
+
+    template <typename ChooseAction>
+    CombatDistribution propagate(ChooseAction chooseAction, int maxTurns) const;
+};
+
+#endif  // TERMINAL_RPG_COMBATSOLVER_HPP
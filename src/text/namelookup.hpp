@@ -0,0 +1,142 @@
+//
+// Created by Connor on 19/10/2026.
+//
+
+#ifndef TERMINAL_RPG_NAMELOOKUP_HPP
+#define TERMINAL_RPG_NAMELOOKUP_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+// FNV-1a over the name, started from a seed. Usable at compile time.
+constexpr uint64_t hashName(std::string_view name, uint64_t seed = 0) {
+    uint64_t hash = 0xcbf29ce484222325ull ^ (seed * 0x9e3779b97f4a7c15ull);
+    for (char c : name) {
+        hash ^= static_cast<unsigned char>(c);
+        hash *= 0x100000001b3ull;
+    }
+    // FNV's low bits are its weakest and the tables below mask them off, so fold the top half in
+    return hash ^ (hash >> 32);
+}
+
+// Smallest power of two with room for four slots per name, so a collision-free seed turns up
+// within a few tries
+constexpr size_t perfectHashSlots(size_t count) {
+    size_t slots = 1;
+    while (slots < count * 4) slots <<= 1;
+    return slots;
+}
+
+// A perfect hash over a fixed list of names, worked out by the compiler: it tries seeds until
+// every name lands in a slot of its own. find() is then one hash and one compare.
+//
+//     constexpr PerfectNameHash<2> hash({"Iron Sword", "Bread"});
+//     static_assert(hash.isPerfect());
+//
+// A list with an empty or repeated name never becomes perfect, which the static_assert catches.
+template <size_t Count>
+class PerfectNameHash {
+public:
+    static_assert(Count > 0 && Count < 32768, "slot entries are int16_t");
+    static constexpr size_t SLOTS = perfectHashSlots(Count);
+
+    constexpr explicit PerfectNameHash(const std::array<std::string_view, Count>& names)
+        : names(names), slots{}, seed(0), perfect(false) {
+        for (uint64_t candidate = 0; candidate < MAX_SEEDS && !perfect; ++candidate) {
+            perfect = place(candidate);
+            seed = candidate;
+        }
+    }
+
+    // Position of name in the list, or -1 if it isn't in it
+    constexpr int find(std::string_view name) const {
+        int index = slots[hashName(name, seed) & (SLOTS - 1)];
+        return (index >= 0 && names[index] == name) ? index : -1;
+    }
+
+    constexpr bool isPerfect() const { return perfect; }
+    constexpr size_t size() const { return Count; }
+    constexpr std::string_view name(size_t index) const { return names[index]; }
+
+private:
+    static constexpr uint64_t MAX_SEEDS = 4096;
+
+    std::array<std::string_view, Count> names;
+    std::array<int16_t, SLOTS> slots;  // Index into names, or -1
+    uint64_t seed;
+    bool perfect;
+
+    constexpr bool place(uint64_t candidate) {
+        for (size_t i = 0; i < SLOTS; ++i) slots[i] = -1;
+        for (size_t i = 0; i < Count; ++i) {
+            if (names[i].empty()) return false;
+            size_t slot = hashName(names[i], candidate) & (SLOTS - 1);
+            if (slots[slot] >= 0) return false;
+            slots[slot] = static_cast<int16_t>(i);
+        }
+        return true;
+    }
+};
+
+// Open-addressing name -> T* map for names only known at run time. Linear probing over a
+// power-of-two table kept at most half full; each slot keeps the full hash so most misses never
+// compare text. Names are held as views, so they have to outlive the table (interned text does).
+template <typename T>
+class NameTable {
+public:
+    // Adds name, or points it at value if it's already there. value must not be nullptr.
+    void insert(std::string_view name, T* value) {
+        if ((count + 1) * 2 > slots.size()) grow();
+        uint64_t hash = hashName(name);
+        size_t index = probe(name, hash);
+        if (!slots[index].value) ++count;
+        slots[index] = {hash, name, value};
+    }
+
+    // nullptr if name was never inserted
+    T* find(std::string_view name) const {
+        if (slots.empty()) return nullptr;
+        return slots[probe(name, hashName(name))].value;
+    }
+
+    size_t size() const { return count; }
+
+    void clear() {
+        slots.clear();
+        count = 0;
+    }
+
+private:
+    struct Slot {
+        uint64_t hash = 0;
+        std::string_view name;
+        T* value = nullptr;  // nullptr marks an empty slot
+    };
+
+    std::vector<Slot> slots;
+    size_t count = 0;
+
+    // The slot holding name, or the empty slot where it would go
+    size_t probe(std::string_view name, uint64_t hash) const {
+        size_t mask = slots.size() - 1;
+        size_t index = hash & mask;
+        while (slots[index].value && (slots[index].hash != hash || slots[index].name != name)) {
+            index = (index + 1) & mask;
+        }
+        return index;
+    }
+
+    void grow() {
+        std::vector<Slot> old = std::move(slots);
+        slots.assign(old.empty() ? 16 : old.size() * 2, Slot{});
+        for (const Slot& slot : old) {
+            if (slot.value) slots[probe(slot.name, slot.hash)] = slot;
+        }
+    }
+};
+
+#endif  // TERMINAL_RPG_NAMELOOKUP_HPP
@@ -0,0 +1,38 @@
+//
+// Created by Connor on 19/10/2026.
+//
+
+#include "stringtable.hpp"
+
+StringTable& StringTable::getInstance() {
+    static StringTable instance;
+    return instance;
+}
+
+StringTable::StringTable() : count(0) { intern(""); }
+
+uint32_t StringTable::intern(std::string_view text) {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = ids.find(text);
+    if (it != ids.end()) return it->second;
+
+    uint32_t id = count.load(std::memory_order_relaxed);
+    if (id >= CHUNK_SIZE * MAX_CHUNKS) return 0;
+    std::unique_ptr<std::string_view[]>& chunk = chunks[id >> CHUNK_BITS];
+    if (!chunk) chunk = std::make_unique<std::string_view[]>(CHUNK_SIZE);
+
+    std::string_view stored = storage.emplace_back(text);
+    chunk[id & (CHUNK_SIZE - 1)] = stored;
+    ids.emplace(stored, id);
+    count.store(id + 1, std::memory_order_release);
+    return id;
+}
+
+std::string_view StringTable::get(uint32_t id) const {
+    if (id >= count.load(std::memory_order_acquire)) return {};
+    return chunks[id >> CHUNK_BITS][id & (CHUNK_SIZE - 1)];
+}
+
+size_t StringTable::size() const { return count.load(std::memory_order_acquire); }
+
+std::ostream& operator<<(std::ostream& out, InternedString text) { return out << text.view(); }
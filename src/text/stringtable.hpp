@@ -0,0 +1,76 @@
+//
+// Created by Connor on 19/10/2026.
+//
+
+#ifndef TERMINAL_RPG_STRINGTABLE_HPP
+#define TERMINAL_RPG_STRINGTABLE_HPP
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+// Every distinct piece of content text (item, enemy and level-title names and descriptions),
+// stored once for the life of the process. Append-only: an id, once handed out, always means
+// the same text, and the text never moves.
+class StringTable {
+public:
+    static StringTable& getInstance();
+
+    // The id for text, adding it the first time it's seen. Ids are dense from 0, which is the
+    // empty string. Safe from any thread. If the table is ever full, new text gets 0.
+    uint32_t intern(std::string_view text);
+
+    // The text for an id from intern(). Doesn't lock.
+    std::string_view get(uint32_t id) const;
+
+    size_t size() const;
+
+private:
+    // Views are kept in fixed-size chunks that are never reallocated, so get() can read them
+    // while intern() adds more
+    static constexpr uint32_t CHUNK_BITS = 10;
+    static constexpr uint32_t CHUNK_SIZE = 1u << CHUNK_BITS;
+    static constexpr uint32_t MAX_CHUNKS = 4096;
+
+    StringTable();
+    ~StringTable() = default;
+    StringTable(const StringTable&) = delete;
+    StringTable& operator=(const StringTable&) = delete;
+
+    mutable std::mutex mutex;
+    std::deque<std::string> storage;  // deque: adding never moves what's already there
+    std::unordered_map<std::string_view, uint32_t> ids;
+    std::array<std::unique_ptr<std::string_view[]>, MAX_CHUNKS> chunks;
+    std::atomic<uint32_t> count;
+};
+
+// A handle to text in the StringTable: 4 bytes, and two of them are equal exactly when their ids
+// are. Default-constructed it's the empty string.
+class InternedString {
+public:
+    InternedString() : id(0) {}
+    explicit InternedString(std::string_view text) : id(StringTable::getInstance().intern(text)) {}
+
+    std::string_view view() const { return StringTable::getInstance().get(id); }
+    uint32_t getId() const { return id; }
+    bool empty() const { return id == 0; }
+
+    friend bool operator==(InternedString a, InternedString b) { return a.id == b.id; }
+    friend bool operator!=(InternedString a, InternedString b) { return a.id != b.id; }
+    friend bool operator==(InternedString a, std::string_view b) { return a.view() == b; }
+    friend bool operator!=(InternedString a, std::string_view b) { return a.view() != b; }
+
+private:
+    uint32_t id;
+};
+
+std::ostream& operator<<(std::ostream& out, InternedString text);
+
+#endif  // TERMINAL_RPG_STRINGTABLE_HPP
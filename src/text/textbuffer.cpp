@@ -0,0 +1,42 @@
+//
+// Created by Connor on 19/10/2026.
+//
+
+#include "textbuffer.hpp"
+
+TextBuffer::TextBuffer() : sink(text) {}
+
+TextBuffer& TextBuffer::operator<<(std::string_view value) {
+    text.append(value);
+    return *this;
+}
+
+TextBuffer& TextBuffer::operator<<(InternedString value) {
+    text.append(value.view());
+    return *this;
+}
+
+std::string_view TextBuffer::view() const { return text; }
+
+bool TextBuffer::empty() const { return text.empty(); }
+
+void TextBuffer::clear() { text.clear(); }
+
+std::ostream& TextBuffer::stream() {
+    if (!adapter) adapter = std::make_unique<std::ostream>(&sink);
+    return *adapter;
+}
+
+TextBuffer::Sink::Sink(std::string& text) : text(text) {}
+
+TextBuffer::Sink::int_type TextBuffer::Sink::overflow(int_type c) {
+    if (!traits_type::eq_int_type(c, traits_type::eof())) {
+        text.push_back(traits_type::to_char_type(c));
+    }
+    return traits_type::not_eof(c);
+}
+
+std::streamsize TextBuffer::Sink::xsputn(const char* s, std::streamsize count) {
+    text.append(s, static_cast<size_t>(count));
+    return count;
+}
@@ -0,0 +1,94 @@
+//
+// Created by Connor on 19/10/2026.
+//
+
+#ifndef TERMINAL_RPG_TEXTBUFFER_HPP
+#define TERMINAL_RPG_TEXTBUFFER_HPP
+
+#include <charconv>
+#include <cstddef>
+#include <memory>
+#include <ostream>
+#include <streambuf>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+#include "stringtable.hpp"
+
+// Text built up with << or format() in one growing buffer. clear() keeps the capacity, so a
+// buffer that lives as long as its owner (one per session) stops allocating once it has held its
+// biggest frame. Numbers are written with std::to_chars: no locale, no stream state.
+class TextBuffer {
+public:
+    TextBuffer();
+
+    TextBuffer(const TextBuffer&) = delete;
+    TextBuffer& operator=(const TextBuffer&) = delete;
+
+    TextBuffer& operator<<(std::string_view text);
+    TextBuffer& operator<<(InternedString text);
+
+    // Integers only, chars as characters. Anything else (enums, floating point) has to be
+    // converted on purpose rather than quietly turning into a char.
+    template <typename T, std::enable_if_t<std::is_integral<T>::value, int> = 0>
+    TextBuffer& operator<<(T value) {
+        if constexpr (std::is_same<T, char>::value) {
+            text.push_back(value);
+        } else if constexpr (std::is_same<T, bool>::value) {
+            text.push_back(value ? '1' : '0');
+        } else {
+            char digits[24];  // Enough for any 64-bit value and its sign
+            std::to_chars_result result = std::to_chars(digits, digits + sizeof(digits), value);
+            text.append(digits, static_cast<size_t>(result.ptr - digits));
+        }
+        return *this;
+    }
+
+    // Writes pattern with each "{}" replaced by the next argument, as << would write it.
+    // Arguments past the last "{}" are dropped.
+    template <typename... Args>
+    TextBuffer& format(std::string_view pattern, const Args&... args) {
+        size_t start = 0;
+        (formatNext(pattern, start, args), ...);
+        text.append(pattern.substr(start));
+        return *this;
+    }
+
+    std::string_view view() const;
+    bool empty() const;
+    void clear();
+
+    // For code that only knows how to write to a std::ostream; writes land in this buffer. The
+    // stream is made on first use.
+    std::ostream& stream();
+
+private:
+    // Appends everything the stream adapter is given
+    class Sink : public std::streambuf {
+    public:
+        explicit Sink(std::string& text);
+
+    protected:
+        int_type overflow(int_type c) override;
+        std::streamsize xsputn(const char* s, std::streamsize count) override;
+
+    private:
+        std::string& text;
+    };
+
+    std::string text;
+    Sink sink;
+    std::unique_ptr<std::ostream> adapter;
+
+    template <typename T>
+    void formatNext(std::string_view pattern, size_t& start, const T& value) {
+        size_t slot = pattern.find("{}", start);
+        if (slot == std::string_view::npos) return;
+        text.append(pattern.substr(start, slot - start));
+        *this << value;
+        start = slot + 2;
+    }
+};
+
+#endif  // TERMINAL_RPG_TEXTBUFFER_HPP
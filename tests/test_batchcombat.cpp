@@ -0,0 +1,177 @@
+#include <catch2/catch_test_macros.hpp>
+#include <random>
+#include <vector>
+
+#include "../src/simulation/batchcombat.hpp"
+
+namespace {
+// Enemy that never dies and hits for a fixed amount
+FightSetup baseSetup() {
+    FightSetup setup{};
+    setup.playerHealth = 100;
+    setup.playerStamina = 50;
+    setup.playerMaxStamina = 50;
+    setup.playerDefence = 0;
+    setup.enemyHealth = 100000;
+    setup.enemyMinAttack = 10;
+    setup.enemyMaxAttack = 10;
+    setup.enemyDefence = 0;
+    setup.armed = false;
+    setup.policy = BatchPolicy::ATTACK;
+    setup.seed = 7;
+    return setup;
+}
+
+FightSetup randomSetup(std::mt19937& gen, uint32_t seed) {
+    std::uniform_int_distribution<> pick(0, 1000);
+    FightSetup setup{};
+    setup.playerMaxStamina = 20 + pick(gen) % 100;
+    setup.playerStamina = pick(gen) % (setup.playerMaxStamina + 1);
+    setup.playerHealth = 1 + pick(gen) % 200;
+    setup.playerDefence = pick(gen) % 8;
+    setup.enemyHealth = 1 + pick(gen) % 300;
+    setup.enemyMinAttack = pick(gen) % 20;
+    setup.enemyMaxAttack = setup.enemyMinAttack + pick(gen) % 30;
+    setup.enemyDefence = pick(gen) % 10;
+    setup.armed = pick(gen) % 4 != 0;
+    setup.weaponMinDamage = pick(gen) % 15;
+    setup.weaponMaxDamage = setup.weaponMinDamage + pick(gen) % 20;
+    setup.weaponAccuracy = 40 + pick(gen) % 70;
+    setup.weaponStaminaCost = pick(gen) % 12;
+    setup.weaponDurability = pick(gen) % 40;
+    setup.policy = static_cast<BatchPolicy>(pick(gen) % 3);
+    setup.seed = seed;
+    return setup;
+}
+
+BatchCombat runSingle(const FightSetup& setup, int turns) {
+    BatchCombat batch;
+    batch.setKernel(BatchKernel::SCALAR);
+    batch.addFight(setup);
+    batch.run(turns);
+    return batch;
+}
+}  // namespace
+
+TEST_CASE("Batch combat follows the interactive combat rules", "[batchcombat]") {
+    SECTION("Unarmed attack costs 5 stamina and can finish an enemy") {
+        FightSetup setup = baseSetup();
+        setup.enemyHealth = 1;
+        BatchCombat batch = runSingle(setup, 10);
+        REQUIRE(batch.getOutcome(0) == FightOutcome::PLAYER_WON);
+        REQUIRE(batch.getTurns(0) == 1);
+        REQUIRE(batch.getPlayerStamina(0) == 45);
+        REQUIRE(batch.getPlayerHealth(0) == 100);
+    }
+
+    SECTION("Attacking while exhausted loses the turn but the enemy doesn't attack") {
+        FightSetup setup = baseSetup();
+        setup.playerStamina = 0;
+        BatchCombat batch = runSingle(setup, 1);
+        REQUIRE(batch.getOutcome(0) == FightOutcome::ONGOING);
+        REQUIRE(batch.getPlayerHealth(0) == 100);
+        REQUIRE(batch.getPlayerStamina(0) == 3);  // 6% natural recovery
+        REQUIRE(batch.getEnemyHealth(0) == 100000);
+    }
+
+    SECTION("Defending recovers 30% stamina and halves the hit before defence") {
+        FightSetup setup = baseSetup();
+        setup.playerStamina = 0;
+        setup.playerDefence = 2;
+        setup.enemyMinAttack = 11;
+        setup.enemyMaxAttack = 11;
+        setup.policy = BatchPolicy::ATTACK_OR_DEFEND;
+        BatchCombat batch = runSingle(setup, 1);
+        REQUIRE(batch.getPlayerStamina(0) == 15);     // No natural recovery while defending
+        REQUIRE(batch.getPlayerHealth(0) == 100 - 3);  // 11 / 2 = 5, minus 2 defence
+    }
+
+    SECTION("Enemy defence can absorb a whole hit") {
+        FightSetup setup = baseSetup();
+        setup.enemyDefence = 100;
+        BatchCombat batch = runSingle(setup, 5);
+        REQUIRE(batch.getEnemyHealth(0) == 100000);
+        REQUIRE(batch.getPlayerHealth(0) == 50);
+    }
+
+    SECTION("Power attack doubles weapon damage, costs 3x stamina and wears 2 durability") {
+        FightSetup setup = baseSetup();
+        setup.armed = true;
+        setup.weaponMinDamage = 10;
+        setup.weaponMaxDamage = 10;
+        setup.weaponAccuracy = 110;  // Still a sure hit after the power attack penalty
+        setup.weaponStaminaCost = 5;
+        setup.weaponDurability = 3;
+        setup.policy = BatchPolicy::POWER_ATTACK_FIRST;
+
+        BatchCombat batch = runSingle(setup, 1);
+        REQUIRE(batch.getEnemyHealth(0) == 100000 - 20);
+        REQUIRE(batch.getPlayerStamina(0) == 50 - 15 + 3);
+        REQUIRE(batch.getWeaponDurability(0) == 1);
+        REQUIRE(batch.isArmed(0));
+
+        // The next power attack only has 1 durability left to take, and breaks the weapon
+        batch.run(1);
+        REQUIRE(batch.getWeaponDurability(0) == 0);
+        REQUIRE_FALSE(batch.isArmed(0));
+    }
+
+    SECTION("The fight is lost when health reaches zero") {
+        FightSetup setup = baseSetup();
+        setup.enemyMinAttack = 1000;
+        setup.enemyMaxAttack = 1000;
+        BatchCombat batch = runSingle(setup, 10);
+        REQUIRE(batch.getOutcome(0) == FightOutcome::PLAYER_LOST);
+        REQUIRE(batch.getTurns(0) == 1);
+        REQUIRE(batch.getPlayerHealth(0) == 0);
+    }
+
+    SECTION("Finished fights are left alone") {
+        FightSetup setup = baseSetup();
+        setup.enemyHealth = 1;
+        BatchCombat batch = runSingle(setup, 1);
+        REQUIRE(batch.run(100) == 0);
+        REQUIRE(batch.getTurns(0) == 1);
+    }
+}
+
+TEST_CASE("All batch combat kernels give identical results", "[batchcombat]") {
+    std::mt19937 gen(1234);
+    std::vector<FightSetup> setups;
+    for (uint32_t i = 0; i < 1003; ++i) {  // Not a multiple of the vector width
+        setups.push_back(randomSetup(gen, i));
+    }
+
+    auto simulate = [&setups](BatchKernel kernel) {
+        BatchCombat batch;
+        for (const FightSetup& setup : setups) batch.addFight(setup);
+        batch.setKernel(kernel);
+        // Several short runs, so fights pause and resume mid-way
+        for (int i = 0; i < 20; ++i) batch.run(7);
+        return batch;
+    };
+
+    BatchCombat reference = simulate(BatchKernel::SCALAR);
+    size_t finished = 0;
+    for (size_t i = 0; i < reference.getFightCount(); ++i) {
+        if (reference.getOutcome(i) != FightOutcome::ONGOING) ++finished;
+    }
+    REQUIRE(finished > setups.size() / 2);
+
+    for (BatchKernel kernel : {BatchKernel::SSE41, BatchKernel::AVX2}) {
+        if (!BatchCombat::isKernelSupported(kernel)) continue;
+        INFO("kernel " << getBatchKernelName(kernel));
+        BatchCombat batch = simulate(kernel);
+        REQUIRE(batch.getKernel() == kernel);
+        for (size_t i = 0; i < batch.getFightCount(); ++i) {
+            INFO("fight " << i);
+            REQUIRE(batch.getOutcome(i) == reference.getOutcome(i));
+            REQUIRE(batch.getTurns(i) == reference.getTurns(i));
+            REQUIRE(batch.getPlayerHealth(i) == reference.getPlayerHealth(i));
+            REQUIRE(batch.getPlayerStamina(i) == reference.getPlayerStamina(i));
+            REQUIRE(batch.getEnemyHealth(i) == reference.getEnemyHealth(i));
+            REQUIRE(batch.getWeaponDurability(i) == reference.getWeaponDurability(i));
+            REQUIRE(batch.isArmed(i) == reference.isArmed(i));
+        }
+    }
+}
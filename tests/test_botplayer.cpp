@@ -0,0 +1,72 @@
+#include <catch2/catch_test_macros.hpp>
+#include <string>
+
+#include "../src/enemies/enemydatabase.hpp"
+#include "../src/game/gamesession.hpp"
+#include "../src/items/itemdatabase.hpp"
+#include "../src/levels/leveldatabase.hpp"
+#include "../src/loadgen/botplayer.hpp"
+#include "../src/loot/loottable.hpp"
+#include "../src/merchants/pricingengine.hpp"
+
+TEST_CASE("Bot policies parse by name", "[botplayer]") {
+    BotPolicy policy;
+    REQUIRE(parseBotPolicy("aggressive", policy));
+    REQUIRE(policy == BotPolicy::AGGRESSIVE);
+    REQUIRE(parseBotPolicy("defensive", policy));
+    REQUIRE(policy == BotPolicy::DEFENSIVE);
+    REQUIRE(parseBotPolicy("merchant", policy));
+    REQUIRE(policy == BotPolicy::MERCHANT_HEAVY);
+    REQUIRE_FALSE(parseBotPolicy("pacifist", policy));
+}
+
+TEST_CASE("Frame helpers read stats and menus", "[botplayer]") {
+    std::string frame =
+        "Your Health: 40/100\nYour Stamina: 7/50\n"
+        "------ Merchant Inventory ------\n1. Iron Sword (50 gold)\n    Sharp\n"
+        "2. Steel Sword (90 gold)\nMerchant: hello\n1. Buy Item\n2. Sell Item\n3. Leave\n";
+
+    int current = 0, max = 0;
+    REQUIRE(parseFrameStat(frame, "Your Health: ", current, max));
+    REQUIRE(current == 40);
+    REQUIRE(max == 100);
+    REQUIRE(parseFrameStat(frame, "Your Stamina: ", current, max));
+    REQUIRE(current == 7);
+    REQUIRE_FALSE(parseFrameStat(frame, "Gold: ", current, max));
+
+    REQUIRE(countFrameOptions(frame, "------ Merchant Inventory ------") == 2);
+    REQUIRE(countFrameOptions(frame, "Merchant: hello") == 3);
+    REQUIRE(countFrameOptions(frame, "Not in frame") == 0);
+}
+
+TEST_CASE("Every bot policy can play full games", "[botplayer]") {
+    ItemDatabase::getInstance().initialize();
+    EnemyDatabase::getInstance().initialize();
+    LevelDatabase::getInstance().initialize();
+    LootTableDatabase::getInstance().initialize();
+    PricingEngine::getInstance().initialize();
+
+    for (int p = 0; p < static_cast<int>(BotPolicy::COUNT); ++p) {
+        BotPolicy policy = static_cast<BotPolicy>(p);
+        for (unsigned int seed = 1; seed <= 20; ++seed) {
+            GameSession session(seed);
+            BotPlayer bot(policy, seed, 10);
+            session.start();
+
+            std::string answer;
+            int turns = 0;
+            while (!session.isFinished() && turns < 5000) {
+                std::string frame = session.takeOutput();
+                INFO(getBotPolicyName(policy) << " seed " << seed << " frame:\n" << frame);
+                REQUIRE(bot.chooseAnswer(frame, answer));
+                REQUIRE_FALSE(bot.isGameOver());
+                session.handleInput(answer);
+                ++turns;
+            }
+
+            REQUIRE(session.isFinished());
+            REQUIRE(bot.chooseAnswer(session.takeOutput(), answer));
+            REQUIRE(bot.isGameOver());
+        }
+    }
+}
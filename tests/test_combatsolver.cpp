@@ -0,0 +1,112 @@
+#include <catch2/catch_test_macros.hpp>
+#include <cmath>
+
+#include "../src/simulation/batchcombat.hpp"
+#include "../src/simulation/combatsolver.hpp"
+
+namespace {
+FightSetup unarmedSetup(int enemyHealth, int enemyMinAttack, int enemyMaxAttack,
+                        int enemyDefence) {
+    FightSetup setup{};
+    setup.playerHealth = 100;
+    setup.playerStamina = 50;
+    setup.playerMaxStamina = 50;
+    setup.enemyHealth = enemyHealth;
+    setup.enemyMinAttack = enemyMinAttack;
+    setup.enemyMaxAttack = enemyMaxAttack;
+    setup.enemyDefence = enemyDefence;
+    setup.policy = BatchPolicy::ATTACK_OR_DEFEND;
+    return setup;
+}
+
+bool near(double actual, double expected, double margin = 1e-9) {
+    return std::abs(actual - expected) <= margin;
+}
+
+double total(const CombatDistribution& distribution) {
+    return distribution.winProbability + distribution.lossProbability +
+           distribution.unresolvedProbability;
+}
+}  // namespace
+
+TEST_CASE("Combat solver handles fights with a certain outcome", "[combatsolver]") {
+    SECTION("Any unarmed hit kills a 1 HP enemy on the first turn") {
+        CombatSolver solver(unarmedSetup(1, 5, 5, 0));
+        REQUIRE(solver.isTractable());
+        REQUIRE(near(solver.getPolicyWinProbability(BatchPolicy::ATTACK), 1.0));
+
+        CombatDistribution distribution = solver.evaluatePolicy(BatchPolicy::ATTACK, 100);
+        REQUIRE(distribution.winsByTurn.size() == 1);
+        REQUIRE(near(distribution.winsByTurn[0], 1.0));
+        REQUIRE(near(distribution.getExpectedTurns(), 1.0));
+    }
+
+    SECTION("An enemy nobody can hurt is a stalemate") {
+        CombatSolver solver(unarmedSetup(50, 0, 0, 100));
+        CombatDistribution distribution = solver.evaluatePolicy(BatchPolicy::ATTACK, 50);
+        REQUIRE(distribution.winProbability == 0.0);
+        REQUIRE(distribution.lossProbability == 0.0);
+        REQUIRE(near(distribution.unresolvedProbability, 1.0));
+        REQUIRE(solver.getOptimalWinProbability() == 0.0);
+    }
+
+    SECTION("Oversized state spaces are refused") {
+        FightSetup setup = unarmedSetup(100000, 1, 2, 0);
+        setup.playerHealth = 100000;
+        CombatSolver solver(setup);
+        REQUIRE_FALSE(solver.isTractable());
+        REQUIRE(solver.evaluatePolicy(BatchPolicy::ATTACK, 10).winsByTurn.empty());
+    }
+}
+
+TEST_CASE("Combat solver distributions are consistent", "[combatsolver]") {
+    // A close fight: an unarmed hero against a Dire Wolf
+    FightSetup setup = unarmedSetup(100, 12, 18, 2);
+
+    CombatSolver solver(setup);
+    for (BatchPolicy policy : {BatchPolicy::ATTACK, BatchPolicy::ATTACK_OR_DEFEND,
+                               BatchPolicy::POWER_ATTACK_FIRST}) {
+        CombatDistribution distribution = solver.evaluatePolicy(policy, 1000);
+        REQUIRE(near(total(distribution), 1.0));
+        REQUIRE(distribution.unresolvedProbability < 1e-9);
+        REQUIRE(near(distribution.winProbability, solver.getPolicyWinProbability(policy)));
+
+        // Optimal play can't do worse than any fixed policy
+        REQUIRE(solver.getOptimalWinProbability() >=
+                solver.getPolicyWinProbability(policy) - 1e-12);
+    }
+
+    CombatDistribution optimal = solver.evaluateOptimalPolicy(1000);
+    REQUIRE(near(optimal.winProbability, solver.getOptimalWinProbability()));
+    REQUIRE(near(total(optimal), 1.0));
+}
+
+TEST_CASE("Combat solver agrees with batch simulation", "[combatsolver]") {
+    FightSetup setup = unarmedSetup(100, 12, 18, 2);
+    setup.armed = true;
+    setup.weaponMinDamage = 8;
+    setup.weaponMaxDamage = 14;
+    setup.weaponAccuracy = 85;
+    setup.weaponStaminaCost = 4;
+    setup.weaponDurability = 1000;  // The solver assumes the weapon lasts the whole fight
+    setup.policy = BatchPolicy::POWER_ATTACK_FIRST;
+
+    CombatSolver solver(setup);
+    double exact = solver.getPolicyWinProbability(setup.policy);
+
+    const int fights = 20000;
+    BatchCombat batch;
+    for (int i = 0; i < fights; ++i) {
+        setup.seed = static_cast<uint32_t>(i);
+        batch.addFight(setup);
+    }
+    batch.run(1000);
+    int wins = 0;
+    for (size_t i = 0; i < batch.getFightCount(); ++i) {
+        if (batch.getOutcome(i) == FightOutcome::PLAYER_WON) ++wins;
+    }
+
+    REQUIRE(exact > 0.05);
+    REQUIRE(exact < 0.95);
+    REQUIRE(near(static_cast<double>(wins) / fights, exact, 0.02));
+}
@@ -0,0 +1,158 @@
+#include <catch2/catch_test_macros.hpp>
+#include <random>
+
+#include "../src/combat/damagepipeline.hpp"
+
+namespace {
+// Loaded dice: every roll of a kind comes up the same
+struct Dice {
+    int accuracy;
+    int damage;
+    int crit;
+};
+
+int rollDice(void* state, DamageRoll roll, int, int) {
+    const Dice& dice = *static_cast<const Dice*>(state);
+    switch (roll) {
+        case DamageRoll::ACCURACY:
+            return dice.accuracy;
+        case DamageRoll::DAMAGE:
+            return dice.damage;
+        case DamageRoll::CRIT:
+            return dice.crit;
+    }
+    return 0;
+}
+
+DamageContext swordStrike(Dice& dice, bool power) {
+    DamageContext context{};
+    context.roller = rollDice;
+    context.rollerState = &dice;
+    context.power = power;
+    context.armed = true;
+    context.minDamage = 5;
+    context.maxDamage = 10;
+    context.accuracy = 80;
+    context.durability = 20;
+    context.targetDefence = 3;
+    return context;
+}
+
+void addOne(DamageContext& context) { context.damage += 1; }
+void doubleIt(DamageContext& context) { context.damage *= 2; }
+}  // namespace
+
+TEST_CASE("Pipelines run their stages in order", "[DamagePipeline]") {
+    DamagePipeline pipeline;
+    REQUIRE(pipeline.addStage(addOne));
+    REQUIRE(pipeline.addStage(doubleIt));
+    DamageContext context{};
+    pipeline.run(context);
+    REQUIRE(context.damage == 2);
+
+    for (size_t i = pipeline.getStageCount(); i < DamagePipeline::MAX_STAGES; ++i) {
+        REQUIRE(pipeline.addStage(addOne));
+    }
+    REQUIRE_FALSE(pipeline.addStage(addOne));
+    REQUIRE(pipeline.getStageCount() == DamagePipeline::MAX_STAGES);
+}
+
+TEST_CASE("Weapon strikes roll, wear, crit and hit defence", "[DamagePipeline]") {
+    Dice dice{50, 7, 50};
+    DamageContext normal = swordStrike(dice, false);
+    getPlayerStrikePipeline().run(normal);
+    REQUIRE_FALSE(normal.missed);
+    REQUIRE_FALSE(normal.critical);
+    REQUIRE(normal.damage == 7);
+    REQUIRE(normal.dealt == 4);
+    REQUIRE(normal.wear == 1);
+    REQUIRE(normal.durability == 19);
+
+    // Power attacks double the roll and the wear, and never crit
+    dice.crit = 1;
+    DamageContext power = swordStrike(dice, true);
+    getPlayerStrikePipeline().run(power);
+    REQUIRE(power.damage == 14);
+    REQUIRE_FALSE(power.critical);
+    REQUIRE(power.wear == 2);
+
+    DamageContext critical = swordStrike(dice, false);
+    critical.damageBonus = 3;
+    getPlayerStrikePipeline().run(critical);
+    REQUIRE(critical.critical);
+    REQUIRE(critical.damage == (7 + 3) * 2);
+    REQUIRE(critical.dealt == 20 - 3);
+}
+
+TEST_CASE("Misses deal nothing and don't wear the weapon", "[DamagePipeline]") {
+    // 75 hits a normal attack but misses the power attack's -10 accuracy
+    Dice dice{75, 7, 1};
+    DamageContext normal = swordStrike(dice, false);
+    getPlayerStrikePipeline().run(normal);
+    REQUIRE_FALSE(normal.missed);
+
+    DamageContext power = swordStrike(dice, true);
+    power.damageBonus = 5;
+    getPlayerStrikePipeline().run(power);
+    REQUIRE(power.missed);
+    REQUIRE(power.damage == 0);
+    REQUIRE(power.dealt == 0);
+    REQUIRE(power.wear == 0);
+    REQUIRE(power.durability == 20);
+}
+
+TEST_CASE("Worn out weapons break", "[DamagePipeline]") {
+    Dice dice{1, 5, 100};
+    DamageContext strike = swordStrike(dice, true);
+    strike.durability = 1;
+    getPlayerStrikePipeline().run(strike);
+    REQUIRE(strike.wear == 1);
+    REQUIRE(strike.durability == 0);
+    REQUIRE(strike.weaponBroke);
+
+    // Durability 0 means the weapon doesn't wear at all
+    DamageContext unbreakable = swordStrike(dice, true);
+    unbreakable.durability = 0;
+    getPlayerStrikePipeline().run(unbreakable);
+    REQUIRE(unbreakable.wear == 0);
+    REQUIRE_FALSE(unbreakable.weaponBroke);
+}
+
+TEST_CASE("Bare hands always hit", "[DamagePipeline]") {
+    std::mt19937 rng(12);
+    for (int i = 0; i < 200; ++i) {
+        DamageContext normal = makeDamageContext(rng);
+        getPlayerStrikePipeline().run(normal);
+        REQUIRE_FALSE(normal.missed);
+        int rolled = normal.critical ? normal.damage / 2 : normal.damage;
+        REQUIRE(rolled >= 3);
+        REQUIRE(rolled <= 8);
+
+        DamageContext power = makeDamageContext(rng);
+        power.power = true;
+        getPlayerStrikePipeline().run(power);
+        REQUIRE(power.damage >= 6);
+        REQUIRE(power.damage <= 16);
+    }
+}
+
+TEST_CASE("Enemy attacks and spells", "[DamagePipeline]") {
+    Dice dice{0, 12, 0};
+    DamageContext hit{};
+    hit.roller = rollDice;
+    hit.rollerState = &dice;
+    hit.damageBonus = 4;
+    hit.targetDefence = 5;
+    hit.targetDefending = true;
+    getEnemyAttackPipeline().run(hit);
+    REQUIRE(hit.damage == 8);
+    REQUIRE(hit.dealt == 3);
+
+    // Spells stop before resistance, which the target's takeSpellDamage applies
+    DamageContext spell{};
+    spell.baseDamage = 15;
+    spell.targetDefence = 20;
+    getSpellPipeline().run(spell);
+    REQUIRE(spell.damage == 15);
+    REQUIRE(spell.dealt == 0);
+}
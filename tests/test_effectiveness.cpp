@@ -0,0 +1,152 @@
+#include <catch2/catch_test_macros.hpp>
+#include <sstream>
+#include <string>
+
+#include "../src/combat/effectiveness.hpp"
+#include "../src/enemies/encounter.hpp"
+#include "../src/player/player.hpp"
+#include "../src/simulation/batchcombat.hpp"
+
+namespace {
+Item* makeWeapon(WeaponType weaponType) {
+    Item* weapon = new Item(1, "Test Weapon", "", 10, 1, WEAPON, COMMON);
+    weapon->setWeaponData(WeaponData(10, 20, 90, 0, weaponType, 50, 5));
+    return weapon;
+}
+}  // namespace
+
+TEST_CASE("The built-in table is loaded by default", "[Effectiveness]") {
+    EffectivenessMatrix& matrix = EffectivenessMatrix::getInstance();
+    matrix.initialize();
+    for (size_t weapon = 0; weapon < WEAPON_TYPE_COUNT; ++weapon) {
+        for (size_t enemy = 0; enemy < ENEMY_TYPE_COUNT; ++enemy) {
+            WeaponType weaponType = static_cast<WeaponType>(weapon);
+            EnemyType enemyType = static_cast<EnemyType>(enemy);
+            int percent = matrix.getPercent(weaponType, enemyType);
+            REQUIRE(percent == EffectivenessMatrix::getDefaultPercent(weaponType, enemyType));
+            REQUIRE(percent > 0);
+            REQUIRE(percent <= EffectivenessMatrix::MAX_PERCENT);
+        }
+    }
+    REQUIRE(matrix.getPercent(MACE, EnemyType::UNDEAD) > matrix.getPercent(BOW, EnemyType::UNDEAD));
+    REQUIRE(getDamageChannel(STAFF) == DamageChannel::SPELL);
+    REQUIRE(getDamageChannel(HAMMER) == DamageChannel::PHYSICAL);
+}
+
+TEST_CASE("Designers can override entries", "[Effectiveness]") {
+    EffectivenessMatrix& matrix = EffectivenessMatrix::getInstance();
+    matrix.initialize();
+
+    REQUIRE(matrix.setPercent(SWORD, EnemyType::DEMON, 0));
+    REQUIRE(matrix.getPercent(SWORD, EnemyType::DEMON) == 0);
+    REQUIRE_FALSE(matrix.setPercent(SWORD, EnemyType::DEMON, -1));
+    REQUIRE_FALSE(matrix.setPercent(SWORD, EnemyType::DEMON, EffectivenessMatrix::MAX_PERCENT + 1));
+    REQUIRE(matrix.getPercent(SWORD, EnemyType::DEMON) == 0);
+
+    std::istringstream content(
+        "# Playtest tweaks\n"
+        "\n"
+        "DAGGER DRAGON 40\n"
+        "   HAMMER  ELEMENTAL 200   # golems\n");
+    std::string error;
+    REQUIRE(matrix.loadOverrides(content, error));
+    REQUIRE(matrix.getPercent(DAGGER, EnemyType::DRAGON) == 40);
+    REQUIRE(matrix.getPercent(HAMMER, EnemyType::ELEMENTAL) == 200);
+    REQUIRE(matrix.getPercent(SWORD, EnemyType::DEMON) == 0);
+
+    matrix.initialize();
+    REQUIRE(matrix.getPercent(SWORD, EnemyType::DEMON) ==
+            EffectivenessMatrix::getDefaultPercent(SWORD, EnemyType::DEMON));
+}
+
+TEST_CASE("Bad override files change nothing", "[Effectiveness]") {
+    EffectivenessMatrix& matrix = EffectivenessMatrix::getInstance();
+    matrix.initialize();
+    int before = matrix.getPercent(AXE, EnemyType::BEAST);
+
+    for (const char* content : {"AXE BEAST 150\nWAND BEAST 120\n", "AXE BEAST 150\nAXE SLIME 90\n",
+                                "AXE BEAST 150\nAXE BEAST\n", "AXE BEAST 150\nAXE BEAST 90 10\n",
+                                "AXE BEAST 150\nAXE BEAST 9000\n"}) {
+        std::istringstream in(content);
+        std::string error;
+        REQUIRE_FALSE(matrix.loadOverrides(in, error));
+        REQUIRE(error.find("line 2") == 0);
+        REQUIRE(matrix.getPercent(AXE, EnemyType::BEAST) == before);
+    }
+
+    std::string error;
+    REQUIRE_FALSE(matrix.loadOverridesFile("no/such/effectiveness.txt", error));
+    REQUIRE_FALSE(error.empty());
+}
+
+TEST_CASE("Strikes are aimed by weapon and enemy type", "[Effectiveness]") {
+    EffectivenessMatrix& matrix = EffectivenessMatrix::getInstance();
+    matrix.initialize();
+    REQUIRE(matrix.setPercent(MACE, EnemyType::UNDEAD, 150));
+    REQUIRE(matrix.setPercent(STAFF, EnemyType::UNDEAD, 50));
+
+    DamageContext mace{};
+    mace.armed = true;
+    mace.minDamage = 10;
+    mace.maxDamage = 21;
+    aimStrike(mace, MACE, EnemyType::UNDEAD, 4, 9);
+    REQUIRE(mace.minDamage == 15);
+    REQUIRE(mace.maxDamage == 31);
+    REQUIRE(mace.targetDefence == 4);
+
+    // Staves are magic: they go against resistance
+    DamageContext staff{};
+    staff.armed = true;
+    staff.minDamage = 10;
+    staff.maxDamage = 20;
+    aimStrike(staff, STAFF, EnemyType::UNDEAD, 4, 9);
+    REQUIRE(staff.minDamage == 5);
+    REQUIRE(staff.maxDamage == 10);
+    REQUIRE(staff.targetDefence == 9);
+
+    // Bare hands are physical and neutral
+    DamageContext fists{};
+    aimStrike(fists, STAFF, EnemyType::UNDEAD, 4, 9);
+    REQUIRE(fists.minDamage == 0);
+    REQUIRE(fists.targetDefence == 4);
+
+    matrix.initialize();
+}
+
+TEST_CASE("Encounters track resistance for spell strikes", "[Effectiveness]") {
+    Encounter encounter;
+    encounter.addEnemy(Enemy("Wraith", "", 3, 40, 2, 4, 1, 6, EnemyType::UNDEAD,
+                             EnemyRarity::COMMON));
+    encounter.addEnemy(Enemy("Rat", "", 1, 10, 1, 2, 0, 0, EnemyType::BEAST, EnemyRarity::COMMON));
+    REQUIRE(encounter.getResistance(0) == 6);
+    encounter.getStatusEffects(0).apply(StatusEffectType::RESISTANCE, 3, 2);
+    REQUIRE(encounter.getResistance(0) == 9);
+    REQUIRE(encounter.getDefence(0) == 1);
+
+    // Removing the dead keeps the survivor's resistance with it
+    encounter.loseHealth(1, 10);
+    std::vector<DefeatedEnemy> defeated;
+    encounter.getStatusEffects(0).clear();
+    REQUIRE(encounter.removeDefeated(defeated) == 1);
+    REQUIRE(encounter.getResistance(0) == 6);
+}
+
+TEST_CASE("Simulated fights see the loadout", "[Effectiveness]") {
+    EffectivenessMatrix::getInstance().initialize();
+    Enemy skeleton("Skeleton", "", 2, 30, 3, 5, 2, 7, EnemyType::UNDEAD, EnemyRarity::COMMON);
+
+    Player player("Test Player", 100, 100, 50, 50, 5, 3, 1, 0, 100, 100, 0);
+    Item* mace = player.addItemToInventory(makeWeapon(MACE));
+    player.setEquippedWeapon(mace);
+    FightSetup maceSetup = makeFightSetup(player, skeleton, BatchPolicy::ATTACK, 1);
+    int macePercent = EffectivenessMatrix::getDefaultPercent(MACE, EnemyType::UNDEAD);
+    REQUIRE(maceSetup.weaponMinDamage == applyEffectiveness(10, macePercent));
+    REQUIRE(maceSetup.enemyDefence == 2);
+
+    Item* staff = player.addItemToInventory(makeWeapon(STAFF));
+    player.setEquippedWeapon(staff);
+    FightSetup staffSetup = makeFightSetup(player, skeleton, BatchPolicy::ATTACK, 1);
+    int staffPercent = EffectivenessMatrix::getDefaultPercent(STAFF, EnemyType::UNDEAD);
+    REQUIRE(staffSetup.weaponMaxDamage == applyEffectiveness(20, staffPercent));
+    REQUIRE(staffSetup.enemyDefence == 7);
+}
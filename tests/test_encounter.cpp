@@ -0,0 +1,284 @@
+#include <catch2/catch_test_macros.hpp>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "../src/enemies/encounter.hpp"
+#include "../src/enemies/enemydatabase.hpp"
+
+namespace {
+Enemy makeGoblin(int health = 20, int attack = 4) {
+    return Enemy("Goblin", "A sneaky goblin.", 1, health, attack, attack, 2, 0,
+                 EnemyType::GOBLINOID, EnemyRarity::COMMON);
+}
+
+Player makePlayer() { return Player("Tester", 1000, 1000, 100, 100, 0, 0, 1, 0, 0, 100, 0); }
+}  // namespace
+
+TEST_CASE("Encounters copy enemies into their components", "[Encounter]") {
+    Encounter encounter;
+    REQUIRE(encounter.isEmpty());
+
+    REQUIRE(encounter.addEnemy(makeGoblin()) == 0);
+    REQUIRE(encounter.addEnemy(Enemy("Orc", "A strong orc.", 3, 60, 8, 14, 3, 1,
+                                     EnemyType::HUMANOID, EnemyRarity::UNCOMMON),
+                               EnemyAI::SWARM) == 1);
+
+    REQUIRE(encounter.getCount() == 2);
+    REQUIRE(encounter.getName(1) == "Orc");
+    REQUIRE(encounter.getHealth(1) == 60);
+    REQUIRE(encounter.getMaxHealth(1) == 60);
+    REQUIRE(encounter.getLevel(1) == 3);
+    REQUIRE(encounter.getDefence(1) == 3);
+    REQUIRE(encounter.getType(1) == EnemyType::HUMANOID);
+    REQUIRE(encounter.getRarity(1) == EnemyRarity::UNCOMMON);
+    REQUIRE(encounter.getAI(0) == EnemyAI::ATTACK);
+    REQUIRE(encounter.getAI(1) == EnemyAI::SWARM);
+
+    EnemyDatabase::getInstance().initialize();
+    const EnemyTemplate* goblin = EnemyDatabase::getInstance().getEnemyTemplate("Goblin");
+    REQUIRE(goblin != nullptr);
+    size_t index = encounter.addEnemy(*goblin);
+    REQUIRE(encounter.getName(index) == "Goblin");
+    REQUIRE(encounter.getHealth(index) == goblin->health);
+}
+
+TEST_CASE("Encounter damage works like Enemy::takeDamage", "[Encounter]") {
+    Encounter encounter;
+    encounter.addEnemy(makeGoblin(50));
+    Enemy reference = makeGoblin(50);
+
+    for (int hit : {10, 5, 1, 30, 50}) {
+        encounter.damage(0, hit);
+        reference.takeDamage(hit);
+        REQUIRE(encounter.getHealth(0) == reference.getHealth());
+    }
+    REQUIRE_FALSE(encounter.isAlive(0));
+    REQUIRE(encounter.isDefeated());
+
+    // Status effects count towards defence
+    encounter.addEnemy(makeGoblin(50));
+    encounter.getStatusEffects(1).apply(StatusEffectType::DEFENCE, 3, 2);
+    REQUIRE(encounter.damage(1, 10) == 5);
+}
+
+TEST_CASE("Encounter spells and heals work like Enemy's", "[Encounter]") {
+    Encounter encounter;
+    encounter.addEnemy(Enemy("Test Skeleton", "A bony skeleton.", 1, 40, 4, 8, 1, 3,
+                             EnemyType::UNDEAD, EnemyRarity::COMMON));
+    Enemy reference("Test Skeleton", "A bony skeleton.", 1, 40, 4, 8, 1, 3, EnemyType::UNDEAD,
+                    EnemyRarity::COMMON);
+
+    for (int spell : {10, 5}) {
+        encounter.takeSpellDamage(0, spell);
+        reference.takeSpellDamage(spell);
+        REQUIRE(encounter.getHealth(0) == reference.getHealth());
+    }
+    encounter.healEnemy(0, 6);
+    reference.healEnemy(6);
+    REQUIRE(encounter.getHealth(0) == reference.getHealth());
+
+    // Resistance buffs count, and a spell it absorbs completely does nothing
+    encounter.getStatusEffects(0).apply(StatusEffectType::RESISTANCE, 10, 2);
+    REQUIRE(encounter.takeSpellDamage(0, 12) == 0);
+    REQUIRE(encounter.takeSpellDamage(0, 100) == 37);
+    REQUIRE_FALSE(encounter.isAlive(0));
+}
+
+TEST_CASE("Area effects reach every enemy", "[Encounter]") {
+    Encounter encounter;
+    for (int i = 0; i < 5; ++i) encounter.addEnemy(makeGoblin(10 + i));
+
+    REQUIRE(encounter.damageAll(5) == 5 * 3);
+    for (size_t i = 0; i < encounter.getCount(); ++i) {
+        REQUIRE(encounter.getHealth(i) == 7 + static_cast<int>(i));
+    }
+
+    encounter.applyEffectToAll(StatusEffectType::POISON, 4, 2);
+    REQUIRE(encounter.tickEffects() == 5 * 4);
+    // The first goblin only has 3 health left to lose
+    REQUIRE(encounter.tickEffects() == 3 + 4 * 4);
+    REQUIRE(encounter.tickEffects() == 0);
+    REQUIRE_FALSE(encounter.isAlive(0));
+    REQUIRE(encounter.isAlive(4));
+}
+
+TEST_CASE("Defeated enemies are removed in order", "[Encounter]") {
+    Encounter encounter;
+    for (int i = 0; i < 6; ++i) {
+        encounter.addEnemy(Enemy("Rat " + std::to_string(i), "A rat.", i + 1, 10, 1, 1, 0, 0,
+                                 EnemyType::BEAST, EnemyRarity::COMMON));
+    }
+    encounter.getStatusEffects(4).apply(StatusEffectType::POISON, 2, 3);
+    encounter.damage(1, 100);
+    encounter.damage(2, 100);
+    encounter.damage(5, 100);
+
+    std::vector<DefeatedEnemy> defeated;
+    REQUIRE(encounter.removeDefeated(defeated) == 3);
+    REQUIRE(defeated.size() == 3);
+    REQUIRE(defeated[0].name == "Rat 1");
+    REQUIRE(defeated[1].name == "Rat 2");
+    REQUIRE(defeated[2].name == "Rat 5");
+    REQUIRE(defeated[2].level == 6);
+
+    // Survivors close up in spawn order, taking their status effects with them
+    REQUIRE(encounter.getCount() == 3);
+    REQUIRE(encounter.getName(0) == "Rat 0");
+    REQUIRE(encounter.getName(1) == "Rat 3");
+    REQUIRE(encounter.getName(2) == "Rat 4");
+    REQUIRE(encounter.getStatusEffects(2).getModifier(StatusEffectType::POISON) == 2);
+    REQUIRE(encounter.getStatusEffects(1).getActiveCount() == 0);
+
+    REQUIRE(encounter.removeDefeated(defeated) == 0);
+    REQUIRE(defeated.size() == 3);
+}
+
+TEST_CASE("A cleared encounter is refilled with fresh enemies", "[Encounter]") {
+    EnemyDatabase::getInstance().initialize();
+    const EnemyTemplate* goblin = EnemyDatabase::getInstance().getEnemyTemplate("Goblin");
+    REQUIRE(goblin != nullptr);
+
+    Encounter encounter;
+    for (int i = 0; i < 4; ++i) encounter.addEnemy(*goblin, EnemyAI::SWARM);
+    encounter.applyEffectToAll(StatusEffectType::POISON, 3, 5);
+    encounter.damage(0, 1000);
+    std::vector<DefeatedEnemy> defeated;
+    REQUIRE(encounter.removeDefeated(defeated) == 1);
+
+    encounter.clear();
+    REQUIRE(encounter.isEmpty());
+    REQUIRE(encounter.isDefeated());
+
+    // Slots left behind by the last fight come back without its damage or poison
+    for (int i = 0; i < 5; ++i) encounter.addEnemy(*goblin);
+    REQUIRE(encounter.getCount() == 5);
+    for (size_t i = 0; i < encounter.getCount(); ++i) {
+        REQUIRE(encounter.getHealth(i) == goblin->health);
+        REQUIRE(encounter.getAI(i) == EnemyAI::ATTACK);
+        REQUIRE(encounter.getStatusEffects(i).getActiveCount() == 0);
+    }
+    REQUIRE(encounter.tickEffects() == 0);
+
+    // A random pick stays in the level range, repeats for the same seed, and there's none
+    // outside every enemy's level
+    std::mt19937 rng(7);
+    std::mt19937 replay(7);
+    for (int i = 0; i < 20; ++i) {
+        const EnemyTemplate* picked =
+            EnemyDatabase::getInstance().getRandomTemplateByLevel(1, 3, rng);
+        REQUIRE(picked != nullptr);
+        REQUIRE(picked->level >= 1);
+        REQUIRE(picked->level <= 3);
+        REQUIRE(EnemyDatabase::getInstance().getRandomTemplateByLevel(1, 3, replay) == picked);
+    }
+    REQUIRE(EnemyDatabase::getInstance().getRandomTemplateByLevel(100000, 100001, rng) ==
+            nullptr);
+}
+
+TEST_CASE("Swarms take turns attacking", "[Encounter]") {
+    Player player = makePlayer();
+    std::mt19937 rng(7);
+    Encounter encounter;
+    for (int i = 0; i < 4; ++i) encounter.addEnemy(makeGoblin(20, 6), EnemyAI::SWARM);
+    encounter.addEnemy(makeGoblin(20, 6), EnemyAI::ATTACK);
+
+    // Two of the four pack members each turn, plus the one that always attacks
+    EncounterAttack first = encounter.attack(player, rng, false);
+    REQUIRE(first.attackers == 3);
+    REQUIRE(first.damage == 18);
+    REQUIRE(player.getHealth() == 1000 - 18);
+
+    EncounterAttack blocked = encounter.attack(player, rng, true);
+    REQUIRE(blocked.attackers == 3);
+    REQUIRE(blocked.damage == 9);
+
+    // The dead don't attack
+    for (size_t i = 0; i < 4; ++i) encounter.damage(i, 100);
+    REQUIRE(encounter.attack(player, rng, false).attackers == 1);
+}
+
+TEST_CASE("A twenty goblin ambush is fought to the end", "[Encounter]") {
+    Player player = makePlayer();
+    std::mt19937 rng(11);
+    Encounter ambush;
+    // Goblins flee when hurt; these ones stand and fight so every kill is counted
+    for (int i = 0; i < 20; ++i) {
+        ambush.addEnemy(makeGoblin(12, 1), EnemyAI::SWARM, makeAttackOnlyBehaviour());
+    }
+
+    std::vector<DefeatedEnemy> defeated;
+    ambush.applyEffectToAll(StatusEffectType::POISON, 3, 3);
+    int turns = 0;
+    while (!ambush.isEmpty() && turns < 100) {
+        ambush.attack(player, rng, false);
+        ambush.damage(0, 20);
+        ambush.tickEffects();
+        ambush.removeDefeated(defeated);
+        ++turns;
+    }
+
+    REQUIRE(ambush.isEmpty());
+    REQUIRE(defeated.size() == 20);
+    // One goblin falls to the sword each turn; the poison softens up the rest for free
+    REQUIRE(turns == 20);
+    REQUIRE(player.getHealth() > 0);
+}
+
+TEST_CASE("Enemies act on their behaviour tables", "[Encounter]") {
+    Player player = makePlayer();
+    std::mt19937 rng(3);
+
+    // One rule at a time, always taken
+    auto only = [](EnemyAction action, uint8_t power, uint8_t belowPercent, bool once) {
+        EnemyBehaviour behaviour = makeAttackOnlyBehaviour();
+        behaviour.belowPercent[0] = belowPercent;
+        behaviour.chance[0] = 100;
+        behaviour.action[0] = action;
+        behaviour.power[0] = power;
+        behaviour.onceMask = once ? 1 : 0;
+        return behaviour;
+    };
+
+    Encounter encounter;
+    encounter.addEnemy(makeGoblin(100, 10), EnemyAI::ATTACK, only(EnemyAction::HEAL, 25, 50, true));
+    encounter.addEnemy(makeGoblin(100, 10), EnemyAI::ATTACK,
+                       only(EnemyAction::CAST_SPELL, 150, 101, false));
+    encounter.addEnemy(makeGoblin(100, 10), EnemyAI::ATTACK,
+                       only(EnemyAction::ENRAGE, 50, 101, true));
+    encounter.addEnemy(makeGoblin(100, 10), EnemyAI::ATTACK, only(EnemyAction::FLEE, 0, 101, true));
+
+    // Healthy healer attacks; the others cast, enrage and run
+    encounter.damage(0, 40);  // 62 left after defence
+    EncounterAttack first = encounter.attack(player, rng, false);
+    REQUIRE(first.attackers == 1);
+    REQUIRE(first.damage == 10);
+    REQUIRE(first.casters == 1);
+    REQUIRE(first.spellDamage == 15);
+    REQUIRE(first.enraged == 1);
+    REQUIRE(first.fled == 1);
+    REQUIRE(player.getHealth() == 1000 - 10 - 15);
+    REQUIRE_FALSE(encounter.isAlive(3));
+    REQUIRE(encounter.hasFled(3));
+
+    // Once-only rules are spent: the healer heals once, the berserker now hits harder
+    encounter.damage(0, 20);  // 44 left
+    EncounterAttack second = encounter.attack(player, rng, false);
+    REQUIRE(second.healers == 1);
+    REQUIRE(second.healed == 25);
+    REQUIRE(encounter.getHealth(0) == 69);
+    REQUIRE(second.attackers == 1);
+    REQUIRE(second.damage == 15);
+    REQUIRE(second.casters == 1);
+
+    EncounterAttack third = encounter.attack(player, rng, true);
+    REQUIRE(third.attackers == 2);
+    REQUIRE(third.damage == 5 + 7);
+    REQUIRE(third.spellDamage == 7);
+
+    // Runaways leave no rewards behind
+    std::vector<DefeatedEnemy> defeated;
+    REQUIRE(encounter.removeDefeated(defeated) == 1);
+    REQUIRE(defeated.empty());
+    REQUIRE(encounter.getCount() == 3);
+}
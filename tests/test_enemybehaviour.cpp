@@ -0,0 +1,115 @@
+#include <catch2/catch_test_macros.hpp>
+#include <string>
+
+#include "../src/enemies/enemybehaviour.hpp"
+#include "../src/enemies/enemydatabase.hpp"
+
+namespace {
+// The rules written out as a plain if-chain, to check the packed evaluation against
+EnemyAction referenceAction(const EnemyBehaviour& behaviour, int health, int maxHealth,
+                            uint8_t spentMask, int roll) {
+    int healthPercent = health * 100 / maxHealth;
+    for (size_t i = 0; i < EnemyBehaviour::MAX_RULES; ++i) {
+        if (healthPercent >= behaviour.belowPercent[i]) continue;
+        if (roll >= behaviour.chance[i]) continue;
+        if ((behaviour.onceMask & spentMask) & (1u << i)) continue;
+        return behaviour.action[i];
+    }
+    return EnemyAction::ATTACK;
+}
+
+bool hasAction(const EnemyBehaviour& behaviour, EnemyAction action) {
+    for (size_t i = 0; i < EnemyBehaviour::MAX_RULES; ++i) {
+        if (behaviour.chance[i] > 0 && behaviour.action[i] == action) return true;
+    }
+    return false;
+}
+}  // namespace
+
+TEST_CASE("Attack-only enemies always attack", "[EnemyBehaviour]") {
+    EnemyBehaviour behaviour = makeAttackOnlyBehaviour();
+    size_t rule = 0;
+    for (int health = 1; health <= 100; health += 7) {
+        for (int roll = 0; roll < 100; roll += 3) {
+            REQUIRE(chooseEnemyAction(behaviour, health, 100, 0, roll, rule) ==
+                    EnemyAction::ATTACK);
+            REQUIRE(rule == EnemyBehaviour::MAX_RULES);
+        }
+    }
+}
+
+TEST_CASE("Goblins run when badly hurt, once", "[EnemyBehaviour]") {
+    EnemyBehaviour goblin = makeEnemyBehaviour(EnemyType::GOBLINOID, EnemyRarity::COMMON);
+    size_t rule = 0;
+
+    REQUIRE(chooseEnemyAction(goblin, 50, 100, 0, 0, rule) == EnemyAction::ATTACK);
+    REQUIRE(chooseEnemyAction(goblin, 29, 100, 0, 39, rule) == EnemyAction::FLEE);
+    REQUIRE(rule == 0);
+    REQUIRE(chooseEnemyAction(goblin, 29, 100, 0, 40, rule) == EnemyAction::ATTACK);
+    // Already used
+    REQUIRE(chooseEnemyAction(goblin, 29, 100, 1, 0, rule) == EnemyAction::ATTACK);
+
+    // Rarer goblins lose their nerve more often
+    EnemyBehaviour rareGoblin = makeEnemyBehaviour(EnemyType::GOBLINOID, EnemyRarity::RARE);
+    REQUIRE(chooseEnemyAction(rareGoblin, 29, 100, 0, 45, rule) == EnemyAction::FLEE);
+}
+
+TEST_CASE("Rules are taken in priority order", "[EnemyBehaviour]") {
+    // Humanoids try a potion before running
+    EnemyBehaviour humanoid = makeEnemyBehaviour(EnemyType::HUMANOID, EnemyRarity::COMMON);
+    size_t rule = 0;
+    REQUIRE(chooseEnemyAction(humanoid, 10, 100, 0, 0, rule) == EnemyAction::HEAL);
+    REQUIRE(chooseEnemyAction(humanoid, 10, 100, 1, 0, rule) == EnemyAction::FLEE);
+    REQUIRE(chooseEnemyAction(humanoid, 20, 100, 1, 0, rule) == EnemyAction::ATTACK);
+
+    // Spellcasters cast at any health
+    EnemyBehaviour elemental = makeEnemyBehaviour(EnemyType::ELEMENTAL, EnemyRarity::COMMON);
+    REQUIRE(chooseEnemyAction(elemental, 100, 100, 0, 0, rule) == EnemyAction::CAST_SPELL);
+    REQUIRE(elemental.power[rule] > 100);
+}
+
+TEST_CASE("Bosses enrage and never flee", "[EnemyBehaviour]") {
+    for (int type = 0; type <= static_cast<int>(EnemyType::GOBLINOID); ++type) {
+        EnemyBehaviour boss = makeEnemyBehaviour(static_cast<EnemyType>(type), EnemyRarity::BOSS);
+        REQUIRE(boss.action[0] == EnemyAction::ENRAGE);
+        REQUIRE_FALSE(hasAction(boss, EnemyAction::FLEE));
+        for (size_t i = 1; i < EnemyBehaviour::MAX_RULES; ++i) {
+            REQUIRE((boss.chance[i] == 0 || boss.action[i] != EnemyAction::ENRAGE));
+        }
+    }
+    REQUIRE_FALSE(hasAction(makeEnemyBehaviour(EnemyType::BEAST, EnemyRarity::LEGENDARY),
+                            EnemyAction::FLEE));
+}
+
+TEST_CASE("Packed evaluation matches the plain rule chain", "[EnemyBehaviour]") {
+    for (int type = 0; type <= static_cast<int>(EnemyType::GOBLINOID); ++type) {
+        for (int rarity = 0; rarity <= static_cast<int>(EnemyRarity::BOSS); ++rarity) {
+            EnemyBehaviour behaviour = makeEnemyBehaviour(static_cast<EnemyType>(type),
+                                                          static_cast<EnemyRarity>(rarity));
+            for (int health = 1; health <= 60; ++health) {
+                for (int roll = 0; roll < 100; ++roll) {
+                    for (uint8_t spent = 0; spent < 16; spent += 5) {
+                        size_t rule = 0;
+                        EnemyAction action =
+                            chooseEnemyAction(behaviour, health, 60, spent, roll, rule);
+                        REQUIRE(action == referenceAction(behaviour, health, 60, spent, roll));
+                    }
+                }
+            }
+        }
+    }
+}
+
+TEST_CASE("Templates carry their table from the database", "[EnemyBehaviour]") {
+    EnemyDatabase& database = EnemyDatabase::getInstance();
+    database.initialize();
+    for (const std::string& name : database.getAllEnemyNames()) {
+        const EnemyTemplate* enemyTemplate = database.getEnemyTemplate(name);
+        EnemyBehaviour expected = makeEnemyBehaviour(enemyTemplate->type, enemyTemplate->rarity);
+        for (size_t i = 0; i < EnemyBehaviour::MAX_RULES; ++i) {
+            REQUIRE(enemyTemplate->behaviour.chance[i] == expected.chance[i]);
+            REQUIRE(enemyTemplate->behaviour.action[i] == expected.action[i]);
+        }
+        REQUIRE(enemyTemplate->behaviour.onceMask == expected.onceMask);
+    }
+}
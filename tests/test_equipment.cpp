@@ -0,0 +1,169 @@
+#include <catch2/catch_test_macros.hpp>
+#include <random>
+
+#include "../src/combat/damagepipeline.hpp"
+#include "../src/enemies/encounter.hpp"
+#include "../src/player/equipment.hpp"
+#include "../src/player/player.hpp"
+
+namespace {
+Item* makeArmor(int armorValue, int durability) {
+    Item* armor = new Item(1, "Test Armor", "", 50, 10, ARMOR, COMMON);
+    armor->setArmorData(ArmorData(armorValue, durability));
+    return armor;
+}
+
+Item* makeWeapon(int durability) {
+    Item* weapon = new Item(2, "Test Sword", "", 50, 5, WEAPON, COMMON);
+    weapon->setWeaponData(WeaponData(5, 10, 100, 1000, SWORD, durability, 5));
+    return weapon;
+}
+}  // namespace
+
+TEST_CASE("Item types map onto slots", "[Equipment]") {
+    EquipmentSlot slot = EquipmentSlot::ARMOR;
+    REQUIRE(getEquipmentSlot(WEAPON, slot));
+    REQUIRE(slot == EquipmentSlot::WEAPON);
+    REQUIRE(getEquipmentSlot(ARMOR, slot));
+    REQUIRE(slot == EquipmentSlot::ARMOR);
+    REQUIRE_FALSE(getEquipmentSlot(POTION, slot));
+    REQUIRE_FALSE(getEquipmentSlot(CURRENCY, slot));
+    REQUIRE_FALSE(getEquipmentSlot(MISC, slot));
+}
+
+TEST_CASE("Equipment keeps flags and bonuses in step", "[Equipment]") {
+    Item* leather = makeArmor(2, 100);
+    Item* steel = makeArmor(4, 200);
+    Equipment equipment;
+    REQUIRE(equipment.getDefenceBonus() == 0);
+
+    REQUIRE(equipment.set(EquipmentSlot::ARMOR, leather) == nullptr);
+    REQUIRE(leather->isEquipped());
+    REQUIRE(equipment.getDefenceBonus() == 2);
+
+    REQUIRE(equipment.set(EquipmentSlot::ARMOR, steel) == leather);
+    REQUIRE_FALSE(leather->isEquipped());
+    REQUIRE(steel->isEquipped());
+    REQUIRE(equipment.getDefenceBonus() == 4);
+
+    EquipmentSlot slot = EquipmentSlot::WEAPON;
+    REQUIRE(equipment.find(steel, slot));
+    REQUIRE(slot == EquipmentSlot::ARMOR);
+    REQUIRE_FALSE(equipment.find(leather, slot));
+
+    REQUIRE(equipment.set(EquipmentSlot::ARMOR, nullptr) == steel);
+    REQUIRE(equipment.getDefenceBonus() == 0);
+
+    delete leather;
+    delete steel;
+}
+
+TEST_CASE("Gear wears down and breaks", "[Equipment]") {
+    Item* armor = makeArmor(3, 3);
+    Item* weapon = makeWeapon(0);
+    Equipment equipment;
+    equipment.set(EquipmentSlot::ARMOR, armor);
+    equipment.set(EquipmentSlot::WEAPON, weapon);
+
+    REQUIRE_FALSE(equipment.wear(EquipmentSlot::ARMOR, 2));
+    REQUIRE(armor->getArmorData().getDurability() == 1);
+    REQUIRE(equipment.wear(EquipmentSlot::ARMOR, 2));
+    REQUIRE(armor->getArmorData().getDurability() == 0);
+    // Still on until it's taken off, and still counted
+    REQUIRE(equipment.get(EquipmentSlot::ARMOR) == armor);
+    REQUIRE(equipment.getDefenceBonus() == 3);
+
+    // Durability 0 from the start: never wears
+    REQUIRE_FALSE(equipment.wear(EquipmentSlot::WEAPON, 5));
+    REQUIRE(weapon->getWeaponData().getDurability() == 0);
+
+    delete armor;
+    delete weapon;
+}
+
+TEST_CASE("Worn armour counts towards the player's defence", "[Equipment]") {
+    Player player("Test Player", 100, 100, 50, 50, 5, 3, 1, 0, 100, 100, 0);
+    Item* armor = player.addItemToInventory(makeArmor(4, 10));
+    REQUIRE(player.getDefence() == 5);
+
+    REQUIRE(player.equip(EquipmentSlot::ARMOR, armor) == nullptr);
+    REQUIRE(player.getEquippedArmor() == armor);
+    REQUIRE(player.getDefence() == 9);
+
+    player.changeDefence(2);
+    REQUIRE(player.getDefence() == 11);
+    player.getStatusEffects().apply(StatusEffectType::DEFENCE, 3, 2);
+    REQUIRE(player.getDefence() == 14);
+    player.getStatusEffects().clear();
+
+    // Breaking takes it off and throws it away
+    REQUIRE_FALSE(player.wearEquipped(EquipmentSlot::ARMOR, 9));
+    REQUIRE(player.wearEquipped(EquipmentSlot::ARMOR, 1));
+    player.breakEquipped(EquipmentSlot::ARMOR);
+    REQUIRE(player.getEquippedArmor() == nullptr);
+    REQUIRE(player.getInventory().empty());
+    REQUIRE(player.getDefence() == 7);
+}
+
+TEST_CASE("Gear leaving the inventory is taken off", "[Equipment]") {
+    Player player("Test Player", 100, 100, 50, 50, 0, 0, 1, 0, 100, 100, 0);
+    Item* armor = player.addItemToInventory(makeArmor(2, 10));
+    Item* weapon = player.addItemToInventory(makeWeapon(10));
+    player.setEquippedArmor(armor);
+    player.setEquippedWeapon(weapon);
+    REQUIRE(player.getDefence() == 2);
+
+    REQUIRE(player.removeItemFromInventory(armor));
+    REQUIRE(player.getEquippedArmor() == nullptr);
+    REQUIRE(player.getDefence() == 0);
+    REQUIRE(player.getEquippedWeapon() == weapon);
+
+    player.breakEquipped(EquipmentSlot::WEAPON);
+    REQUIRE(player.getEquippedWeapon() == nullptr);
+    REQUIRE(player.getInventory().empty());
+}
+
+TEST_CASE("Enemy hits wear armour through the damage pipeline", "[Equipment]") {
+    std::mt19937 rng(3);
+    DamageContext hit = makeDamageContext(rng);
+    hit.minDamage = 6;
+    hit.maxDamage = 6;
+    hit.targetDefence = 10;
+    hit.armorDurability = 1;
+    getEnemyAttackPipeline().run(hit);
+    // Absorbed completely, but it still landed on the armour
+    REQUIRE(hit.dealt == 0);
+    REQUIRE(hit.armorWear == 1);
+    REQUIRE(hit.armorBroke);
+
+    // Spells go around it
+    DamageContext spell{};
+    spell.baseDamage = 10;
+    spell.armorDurability = 5;
+    getSpellPipeline().run(spell);
+    REQUIRE(spell.armorWear == 0);
+
+    Player player("Test Player", 1000, 1000, 50, 50, 0, 0, 1, 0, 100, 100, 0);
+    Item* armor = player.addItemToInventory(makeArmor(1, 5));
+    player.setEquippedArmor(armor);
+
+    Encounter encounter;
+    for (int i = 0; i < 3; ++i) {
+        encounter.addEnemy(Enemy("Rat", "", 1, 10, 4, 4, 0, 0, EnemyType::BEAST,
+                                 EnemyRarity::COMMON),
+                           EnemyAI::ATTACK, makeAttackOnlyBehaviour());
+    }
+    EncounterAttack first = encounter.attack(player, rng, false);
+    REQUIRE(first.armorWear == 3);
+    REQUIRE_FALSE(first.armorBroke);
+    REQUIRE(armor->getArmorData().getDurability() == 2);
+    REQUIRE(player.getHealth() == 1000 - 3 * 3);
+
+    // Breaks part way through the turn: the rest of the pack doesn't wear it further
+    EncounterAttack second = encounter.attack(player, rng, false);
+    REQUIRE(second.armorWear == 2);
+    REQUIRE(second.armorBroke);
+    REQUIRE(player.getEquippedArmor() == armor);
+    player.breakEquipped(EquipmentSlot::ARMOR);
+    REQUIRE(player.getDefence() == 0);
+}
@@ -0,0 +1,150 @@
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <catch2/catch_test_macros.hpp>
+#include <cstring>
+#include <string>
+#include <thread>
+
+#include "../src/enemies/enemydatabase.hpp"
+#include "../src/items/itemdatabase.hpp"
+#include "../src/levels/leveldatabase.hpp"
+#include "../src/loot/loottable.hpp"
+#include "../src/merchants/pricingengine.hpp"
+#include "../src/server/gameserver.hpp"
+
+namespace {
+int connectTo(const std::string& path) {
+    int fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    std::strncpy(address.sun_path, path.c_str(), sizeof(address.sun_path) - 1);
+    if (::connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0) {
+        ::close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+// Reads one frame; returns false if the server closed the connection first
+bool readFrame(int fd, std::string& frame) {
+    frame.clear();
+    char c;
+    while (::recv(fd, &c, 1, 0) == 1) {
+        if (c == FRAME_TERMINATOR) return true;
+        frame.push_back(c);
+    }
+    return false;
+}
+
+void sendLine(int fd, const std::string& line) {
+    std::string data = line + "\n";
+    ::send(fd, data.data(), data.size(), MSG_NOSIGNAL);
+}
+
+void initializeContent() {
+    ItemDatabase::getInstance().initialize();
+    EnemyDatabase::getInstance().initialize();
+    LevelDatabase::getInstance().initialize();
+    LootTableDatabase::getInstance().initialize();
+    PricingEngine::getInstance().initialize();
+}
+
+GameServerConfig testConfig(const std::string& name) {
+    GameServerConfig config;
+    config.socketPath =
+        "/tmp/terminal_rpg_test_" + name + "_" + std::to_string(::getpid()) + ".sock";
+    config.workerCount = 2;
+    config.pinWorkers = false;
+    return config;
+}
+
+// Runs the server's accept loop for the lifetime of the scope, even if an assertion fails
+class ServerRunner {
+public:
+    explicit ServerRunner(GameServer& server)
+        : server(server), thread([&server] { server.run(); }) {}
+    ~ServerRunner() { stop(); }
+
+    void stop() {
+        if (!thread.joinable()) return;
+        server.stop();
+        thread.join();
+    }
+
+private:
+    GameServer& server;
+    std::thread thread;
+};
+}  // namespace
+
+TEST_CASE("GameServer serves sessions over a unix socket", "[gameserver]") {
+    initializeContent();
+    GameServerConfig config = testConfig("sessions");
+
+    GameServer server(config);
+    std::string error;
+    REQUIRE(server.start(error));
+    ServerRunner runner(server);
+
+    SECTION("Each connection gets its own session") {
+        int first = connectTo(config.socketPath);
+        int second = connectTo(config.socketPath);
+        REQUIRE(first >= 0);
+        REQUIRE(second >= 0);
+
+        std::string frame;
+        REQUIRE(readFrame(first, frame));
+        REQUIRE(frame.find("Enter your character's name: ") != std::string::npos);
+        REQUIRE(readFrame(second, frame));
+        REQUIRE(frame.find("Enter your character's name: ") != std::string::npos);
+
+        // Carriage returns from telnet-style clients are stripped
+        sendLine(first, "Alice\r");
+        REQUIRE(readFrame(first, frame));
+        REQUIRE(frame.find("Welcome, Alice!") != std::string::npos);
+
+        sendLine(second, "Bob");
+        REQUIRE(readFrame(second, frame));
+        REQUIRE(frame.find("Welcome, Bob!") != std::string::npos);
+
+        ::close(first);
+        ::close(second);
+    }
+
+    runner.stop();
+
+    GameServerStats stats = server.getStats();
+    REQUIRE(stats.connectionsAccepted == 2);
+    REQUIRE(stats.inputsHandled == 2);
+    REQUIRE(stats.activeSessions == 0);
+}
+
+TEST_CASE("GameServer answers input sent before a half-close", "[gameserver]") {
+    initializeContent();
+    GameServerConfig config = testConfig("halfclose");
+    GameServer server(config);
+    std::string error;
+    REQUIRE(server.start(error));
+    ServerRunner runner(server);
+
+    int fd = connectTo(config.socketPath);
+    REQUIRE(fd >= 0);
+    std::string frame;
+    REQUIRE(readFrame(fd, frame));
+
+    // The last line has no newline; the end of the stream finishes it
+    std::string data = "Carol\nl";
+    ::send(fd, data.data(), data.size(), MSG_NOSIGNAL);
+    ::shutdown(fd, SHUT_WR);
+
+    REQUIRE(readFrame(fd, frame));
+    REQUIRE(frame.find("Welcome, Carol!") != std::string::npos);
+    REQUIRE(readFrame(fd, frame));  // Whatever the random event made of the "l"
+    REQUIRE_FALSE(readFrame(fd, frame));  // Then the server closes
+    ::close(fd);
+
+    runner.stop();
+    REQUIRE(server.getStats().inputsHandled == 2);
+}
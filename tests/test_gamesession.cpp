@@ -0,0 +1,192 @@
+#include <catch2/catch_test_macros.hpp>
+#include <map>
+#include <string>
+
+#include "../src/enemies/enemydatabase.hpp"
+#include "../src/game/gamesession.hpp"
+#include "../src/game/sessionscheduler.hpp"
+#include "../src/items/itemdatabase.hpp"
+#include "../src/levels/leveldatabase.hpp"
+#include "../src/loot/loottable.hpp"
+#include "../src/merchants/pricingengine.hpp"
+
+namespace {
+void initializeDatabases() {
+    ItemDatabase::getInstance().initialize();
+    EnemyDatabase::getInstance().initialize();
+    LevelDatabase::getInstance().initialize();
+    LootTableDatabase::getInstance().initialize();
+    PricingEngine::getInstance().initialize();
+}
+
+// Simple scripted player: attacks when it can, opens chests, never trades
+std::string scriptedAnswer(const GameSession& session, int& continuesLeft) {
+    switch (session.getState()) {
+        case SessionState::AWAITING_NAME:
+            return "Tester";
+        case SessionState::AWAITING_CONTINUE:
+            return continuesLeft-- > 0 ? "y" : "n";
+        case SessionState::COMBAT_ACTION:
+            return session.getPlayer()->getStamina() >= 5 ? "1" : "2";
+        case SessionState::COMBAT_TARGET_CHOICE:
+            return "1";
+        case SessionState::COMBAT_PAUSE:
+            return "";
+        case SessionState::CHEST_PROMPT:
+            return "y";
+        case SessionState::MERCHANT_MENU:
+            return "3";
+        default:
+            return "0";
+    }
+}
+}  // namespace
+
+TEST_CASE("Input parsing mirrors stream extraction", "[GameSession]") {
+    int value = -1;
+    REQUIRE(parseIntInput("3", value));
+    REQUIRE(value == 3);
+    REQUIRE(parseIntInput("  12 extra", value));
+    REQUIRE(value == 12);
+    REQUIRE_FALSE(parseIntInput("abc", value));
+    REQUIRE_FALSE(parseIntInput("", value));
+
+    REQUIRE(firstCharInput("  y") == 'y');
+    REQUIRE(firstCharInput("No thanks") == 'N');
+    REQUIRE(firstCharInput("   ") == '\0');
+}
+
+TEST_CASE("GameSession asks for a name and then parks at a prompt", "[GameSession]") {
+    initializeDatabases();
+    GameSession session(42);
+    session.start();
+
+    REQUIRE(session.getState() == SessionState::AWAITING_NAME);
+    REQUIRE(session.takeOutput().find("Enter your character's name: ") != std::string::npos);
+    REQUIRE(session.getPlayer() == nullptr);
+
+    session.handleInput("Hero");
+    std::string frame = session.takeOutput();
+    REQUIRE(frame.find("Welcome, Hero!") != std::string::npos);
+    REQUIRE(session.getPlayer() != nullptr);
+    REQUIRE(session.getPlayer()->getName() == "Hero");
+    REQUIRE(session.getState() != SessionState::AWAITING_NAME);
+    REQUIRE_FALSE(session.isFinished());
+
+    // Output is handed over once
+    REQUIRE(session.takeOutput().empty());
+}
+
+TEST_CASE("GameSession ignores blank answers to numeric prompts", "[GameSession]") {
+    initializeDatabases();
+    GameSession session(7);
+    session.start();
+    session.handleInput("Hero");
+
+    int continuesLeft = 100;
+    for (int step = 0; step < 1000 && session.getState() != SessionState::COMBAT_ACTION; ++step) {
+        session.handleInput(scriptedAnswer(session, continuesLeft));
+    }
+    REQUIRE(session.getState() == SessionState::COMBAT_ACTION);
+
+    session.takeOutput();
+    session.handleInput("   ");
+    REQUIRE(session.getState() == SessionState::COMBAT_ACTION);
+    REQUIRE(session.takeOutput().empty());
+
+    PlayerCommand command;
+    REQUIRE_FALSE(session.takeCompletedCommand(command));
+    session.handleInput("2");
+    REQUIRE(session.takeCompletedCommand(command));
+    REQUIRE(command == PlayerCommand::COMBAT_DEFEND);
+    REQUIRE_FALSE(session.takeCompletedCommand(command));
+}
+
+TEST_CASE("GameSession plays through to the end without blocking", "[GameSession]") {
+    initializeDatabases();
+    GameSession session(1234);
+    session.start();
+
+    int continuesLeft = 20;
+    int steps = 0;
+    while (!session.isFinished() && steps < 20000) {
+        session.handleInput(scriptedAnswer(session, continuesLeft));
+        session.takeOutput();
+        ++steps;
+    }
+
+    REQUIRE(session.isFinished());
+    REQUIRE(session.getState() == SessionState::FINISHED);
+}
+
+TEST_CASE("GameSession awards experience for defeated enemies", "[GameSession]") {
+    initializeDatabases();
+
+    // Play seeds until someone wins a fight; the kill goes through the reward table
+    bool sawDefeat = false;
+    for (unsigned int seed = 1; seed <= 50 && !sawDefeat; ++seed) {
+        GameSession session(seed);
+        session.start();
+        int continuesLeft = 20;
+        for (int steps = 0; steps < 2000 && !session.isFinished() && !sawDefeat; ++steps) {
+            session.handleInput(scriptedAnswer(session, continuesLeft));
+            std::string frame = session.takeOutput();
+            if (frame.find("has been defeated!") == std::string::npos) continue;
+            sawDefeat = true;
+            REQUIRE(frame.find("Gained ") != std::string::npos);
+            REQUIRE(session.getPlayer()->getExperience() > 0);
+        }
+    }
+    REQUIRE(sawDefeat);
+}
+
+TEST_CASE("SessionScheduler multiplexes many sessions on one thread", "[SessionScheduler]") {
+    initializeDatabases();
+
+    std::map<SessionId, int> framesPerSession;
+    size_t finishedSessions = 0;
+    SessionScheduler scheduler([&](SessionId id, const std::string& frame, bool finished) {
+        REQUIRE_FALSE(frame.empty());
+        ++framesPerSession[id];
+        if (finished) ++finishedSessions;
+    });
+
+    const size_t sessionCount = 1000;
+    for (size_t i = 0; i < sessionCount; ++i) {
+        scheduler.openSession(static_cast<unsigned int>(i));
+    }
+    REQUIRE(scheduler.getSessionCount() == sessionCount);
+    REQUIRE(framesPerSession.size() == sessionCount);
+
+    // Every session gets its name, then one scripted answer per round
+    std::map<SessionId, int> continuesLeft;
+    for (int round = 0; round < 10; ++round) {
+        for (SessionId id = 1; id <= sessionCount; ++id) {
+            GameSession* session = scheduler.getSession(id);
+            if (!session) continue;
+            int& left = continuesLeft.emplace(id, 0).first->second;
+            scheduler.submitInput(id, scriptedAnswer(*session, left));
+        }
+        scheduler.runPending();
+        REQUIRE_FALSE(scheduler.hasPendingInput());
+    }
+
+    // Every session answered its name and moved on
+    for (const auto& entry : framesPerSession) {
+        REQUIRE(entry.second >= 2);
+    }
+    // Finished sessions are dropped by the scheduler
+    REQUIRE(scheduler.getSessionCount() == sessionCount - finishedSessions);
+    REQUIRE(finishedSessions > 0);
+
+    // Closing a session drops queued input for it
+    SessionId open = 0;
+    for (SessionId id = 1; id <= sessionCount && !open; ++id) {
+        if (scheduler.getSession(id)) open = id;
+    }
+    REQUIRE(open != 0);
+    scheduler.submitInput(open, "1");
+    scheduler.closeSession(open);
+    REQUIRE(scheduler.getSession(open) == nullptr);
+    REQUIRE(scheduler.runPending() == 0);
+}
@@ -126,4 +126,21 @@ TEST_CASE("Item equipped state toggles correctly", "[Item]") {
     REQUIRE(item.isEquipped() == true);
     item.setEquipped(false);
     REQUIRE(item.isEquipped() == false);
-}
\ No newline at end of file
+}
+TEST_CASE("Only potions, currency and misc items stack", "[Item]") {
+    Item potion(1, "Minor Healing Potion", "Heals.", 10, 1, POTION, COMMON);
+    Item otherPotion(2, "Minor Healing Potion", "Heals.", 10, 1, POTION, COMMON);
+    Item staminaPotion(3, "Stamina Potion", "Restores.", 10, 1, POTION, COMMON);
+    Item sword(4, "Sword", "Sharp.", 100, 5, WEAPON, COMMON);
+    Item otherSword(5, "Sword", "Sharp.", 100, 5, WEAPON, COMMON);
+
+    REQUIRE(potion.getQuantity() == 1);
+    REQUIRE(potion.isStackable());
+    REQUIRE(potion.stacksWith(otherPotion));
+    REQUIRE_FALSE(potion.stacksWith(staminaPotion));
+    REQUIRE_FALSE(sword.isStackable());
+    REQUIRE_FALSE(sword.stacksWith(otherSword));
+
+    potion.setQuantity(4);
+    REQUIRE(potion.getStackWeight() == 4);
+}
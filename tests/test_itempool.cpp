@@ -0,0 +1,53 @@
+#include <catch2/catch_test_macros.hpp>
+#include <set>
+#include <thread>
+#include <vector>
+
+#include "../src/items/item.hpp"
+#include "../src/items/itempool.hpp"
+
+TEST_CASE("Items come from the pool and their blocks are reused", "[itempool]") {
+    REQUIRE(ItemPool::getBlockSize() >= sizeof(Item));
+
+    Item* first = new Item(1, "Pebble", "A small stone", 1, 1, MISC, COMMON);
+    REQUIRE(ItemPool::getReservedCount() >= ItemPool::BLOCKS_PER_CHUNK);
+    const void* firstBlock = first;
+    delete first;
+
+    // The most recently freed block is handed out next
+    Item* second = new Item(2, "Stick", "A short stick", 1, 1, MISC, COMMON);
+    REQUIRE(static_cast<const void*>(second) == firstBlock);
+    REQUIRE(second->getName() == "Stick");
+    delete second;
+}
+
+TEST_CASE("The pool grows in chunks and keeps items apart", "[itempool]") {
+    const size_t count = ItemPool::BLOCKS_PER_CHUNK * 3;
+    std::vector<Item*> items;
+    std::set<Item*> distinct;
+    for (size_t i = 0; i < count; ++i) {
+        items.push_back(new Item(static_cast<int>(i), "Coin", "", 1, 0, CURRENCY, COMMON));
+        distinct.insert(items.back());
+    }
+    REQUIRE(distinct.size() == count);
+    REQUIRE(ItemPool::getReservedCount() >= count);
+    for (size_t i = 0; i < count; ++i) {
+        REQUIRE(items[i]->getId() == static_cast<int>(i));
+    }
+
+    // Items can be freed on a different thread than they were created on
+    std::thread worker([&items]() {
+        for (Item* item : items) delete item;
+    });
+    worker.join();
+
+    // Blocks the worker left behind are picked up again instead of reserving more
+    size_t reserved = ItemPool::getReservedCount();
+    std::thread reuse([count]() {
+        std::vector<Item*> again;
+        for (size_t i = 0; i < count; ++i) again.push_back(new Item());
+        for (Item* item : again) delete item;
+    });
+    reuse.join();
+    REQUIRE(ItemPool::getReservedCount() == reserved);
+}
@@ -0,0 +1,90 @@
+#include <catch2/catch_test_macros.hpp>
+#include <cstdint>
+#include <limits>
+#include <string>
+
+#include "../src/metrics/latencyhistogram.hpp"
+
+TEST_CASE("LatencyHistogram records exact values below the first sub-bucket range",
+          "[LatencyHistogram]") {
+    LatencyHistogram histogram;
+    for (uint64_t value = 1; value <= 100; ++value) {
+        histogram.record(value);
+    }
+
+    REQUIRE(histogram.getCount() == 100);
+    REQUIRE(histogram.getMin() == 1);
+    REQUIRE(histogram.getMax() == 100);
+    REQUIRE(histogram.getValueAtPercentile(50.0) == 50);
+    REQUIRE(histogram.getValueAtPercentile(99.0) == 99);
+    REQUIRE(histogram.getValueAtPercentile(100.0) == 100);
+}
+
+TEST_CASE("LatencyHistogram bucket indices are monotonic and bounded", "[LatencyHistogram]") {
+    size_t previous = 0;
+    for (uint64_t value = 0; value < 1000000; value += 7) {
+        size_t index = LatencyHistogram::bucketIndexFor(value);
+        REQUIRE(index >= previous);
+        REQUIRE(LatencyHistogram::highestEquivalentValue(index) >= value);
+        previous = index;
+    }
+
+    size_t lastIndex = LatencyHistogram::bucketIndexFor(std::numeric_limits<uint64_t>::max());
+    REQUIRE(LatencyHistogram::highestEquivalentValue(lastIndex) ==
+            std::numeric_limits<uint64_t>::max());
+}
+
+TEST_CASE("LatencyHistogram keeps relative error under two percent", "[LatencyHistogram]") {
+    for (uint64_t value = 1000; value < 100000000000ULL; value = value * 3 + 17) {
+        uint64_t reported =
+            LatencyHistogram::highestEquivalentValue(LatencyHistogram::bucketIndexFor(value));
+        REQUIRE(reported >= value);
+        REQUIRE((reported - value) * 64 <= value);
+    }
+}
+
+TEST_CASE("LatencyHistogram exposes the tail separately from the median", "[LatencyHistogram]") {
+    LatencyHistogram histogram;
+    for (int i = 0; i < 990; ++i) histogram.record(1000);      // 1 us turns
+    for (int i = 0; i < 10; ++i) histogram.record(50000000);  // 50 ms stalls
+
+    REQUIRE(histogram.getValueAtPercentile(50.0) >= 1000);
+    REQUIRE(histogram.getValueAtPercentile(50.0) < 1016);
+    REQUIRE(histogram.getValueAtPercentile(99.0) < 1016);
+    REQUIRE(histogram.getValueAtPercentile(99.9) == 50000000);  // Clamped to the recorded max
+}
+
+TEST_CASE("LatencyHistogram merges and resets", "[LatencyHistogram]") {
+    LatencyHistogram a;
+    LatencyHistogram b;
+    a.record(10);
+    b.record(20);
+    b.record(30);
+
+    a.merge(b);
+    REQUIRE(a.getCount() == 3);
+    REQUIRE(a.getMin() == 10);
+    REQUIRE(a.getMax() == 30);
+    REQUIRE(a.getMean() == 20.0);
+
+    a.reset();
+    REQUIRE(a.getCount() == 0);
+    REQUIRE(a.getMin() == 0);
+    REQUIRE(a.getValueAtPercentile(99.0) == 0);
+}
+
+TEST_CASE("CommandLatencyTracker reports only commands with samples", "[LatencyHistogram]") {
+    CommandLatencyTracker tracker;
+    REQUIRE(tracker.formatReport().find("no commands recorded") != std::string::npos);
+
+    tracker.record(PlayerCommand::COMBAT_ATTACK, 2000);
+    tracker.record(PlayerCommand::MERCHANT_BUY, 5000);
+
+    REQUIRE(tracker.getHistogram(PlayerCommand::COMBAT_ATTACK).getCount() == 1);
+    REQUIRE(tracker.getHistogram(PlayerCommand::COMBAT_FLEE).getCount() == 0);
+
+    std::string report = tracker.formatReport();
+    REQUIRE(report.find("combat.attack") != std::string::npos);
+    REQUIRE(report.find("merchant.buy") != std::string::npos);
+    REQUIRE(report.find("combat.flee") == std::string::npos);
+}
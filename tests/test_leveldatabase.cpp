@@ -1,7 +1,11 @@
 #include <catch2/catch_test_macros.hpp>
+#include <algorithm>
 #include <climits>
 
+#include "../src/enemies/enemydatabase.hpp"
+#include "../src/levels/experiencecurve.hpp"
 #include "../src/levels/leveldatabase.hpp"
+#include "../src/player/player.hpp"
 
 TEST_CASE("LevelDatabase singleton pattern works correctly", "[LevelDatabase]") {
     LevelDatabase& db1 = LevelDatabase::getInstance();
@@ -287,46 +291,199 @@ TEST_CASE("LevelTemplate constructor works correctly", "[LevelTemplate]") {
     REQUIRE(template1.defenceBonus == 2);
     REQUIRE(template1.resistanceBonus == 1);
     REQUIRE(template1.levelTitle == "Warrior");
-    REQUIRE(template1.healthMultiplier == 1.0);
-    REQUIRE(template1.staminaMultiplier == 1.0);
-    REQUIRE(template1.defenceMultiplier == 1.0);
-    REQUIRE(template1.resistanceMultiplier == 1.0);
-
-    // Test with custom multipliers
-    LevelTemplate template2(10, 1000, 4100, 60, 30, 5, 4, "Elite Warrior", 1.2, 1.1, 1.1, 1.1);
-
-    REQUIRE(template2.healthMultiplier == 1.2);
-    REQUIRE(template2.staminaMultiplier == 1.1);
-    REQUIRE(template2.defenceMultiplier == 1.1);
-    REQUIRE(template2.resistanceMultiplier == 1.1);
+    REQUIRE(template1.healthMultiplier == PERMILLE_ONE);
+    REQUIRE(template1.staminaMultiplier == PERMILLE_ONE);
+    REQUIRE(template1.defenceMultiplier == PERMILLE_ONE);
+    REQUIRE(template1.resistanceMultiplier == PERMILLE_ONE);
+
+    // Test with custom multipliers (thousandths)
+    LevelTemplate template2(10, 1000, 4100, 60, 30, 5, 4, "Elite Warrior", 1200, 1100, 1100, 1100);
+
+    REQUIRE(template2.healthMultiplier == 1200);
+    REQUIRE(template2.staminaMultiplier == 1100);
+    REQUIRE(template2.defenceMultiplier == 1100);
+    REQUIRE(template2.resistanceMultiplier == 1100);
 }
 
 TEST_CASE("ExperienceReward constructors work correctly", "[ExperienceReward]") {
     // Test default constructor
     ExperienceReward defaultReward;
     REQUIRE(defaultReward.baseExperience == 20);
-    REQUIRE(defaultReward.levelDifferenceMultiplier == 1.0);
-    REQUIRE(defaultReward.rarityMultiplier == 1.0);
+    REQUIRE(defaultReward.levelDifferenceMultiplier == PERMILLE_ONE);
+    REQUIRE(defaultReward.rarityMultiplier == PERMILLE_ONE);
     REQUIRE(defaultReward.minExperience == 1);
     REQUIRE(defaultReward.maxExperience == 1000);
 
     // Test parameterized constructor
-    ExperienceReward customReward(50, 1.5, 2.0, 5, 2000);
+    ExperienceReward customReward(50, 1500, 2000, 5, 2000);
     REQUIRE(customReward.baseExperience == 50);
-    REQUIRE(customReward.levelDifferenceMultiplier == 1.5);
-    REQUIRE(customReward.rarityMultiplier == 2.0);
+    REQUIRE(customReward.levelDifferenceMultiplier == 1500);
+    REQUIRE(customReward.rarityMultiplier == 2000);
     REQUIRE(customReward.minExperience == 5);
     REQUIRE(customReward.maxExperience == 2000);
 
     // Test parameterized constructor with defaults
     ExperienceReward partialReward(30);
     REQUIRE(partialReward.baseExperience == 30);
-    REQUIRE(partialReward.levelDifferenceMultiplier == 1.0);
-    REQUIRE(partialReward.rarityMultiplier == 1.0);
+    REQUIRE(partialReward.levelDifferenceMultiplier == PERMILLE_ONE);
+    REQUIRE(partialReward.rarityMultiplier == PERMILLE_ONE);
     REQUIRE(partialReward.minExperience == 1);
     REQUIRE(partialReward.maxExperience == 1000);
 }
 
+TEST_CASE("Experience rewards are exact fixed-point products", "[LevelDatabase]") {
+    LevelDatabase& db = LevelDatabase::getInstance();
+    db.initialize();
+
+    // 20 * 2.35 * 2.0 = 94 exactly; the old double maths came out just under and gave 93
+    REQUIRE(db.calculateExperienceReward(1, 10, false) == 94);
+    // 20 * 1.45 * 1.4 * 5 = 203
+    REQUIRE(db.calculateExperienceReward(1, 4, true) == 203);
+    // Clamped at 25%: 20 * 0.25 * 1.1 = 5.5, rounded down
+    REQUIRE(db.calculateExperienceReward(100, 1, false) == 5);
+
+    for (int playerLevel = 1; playerLevel <= 100; ++playerLevel) {
+        for (int enemyLevel = 1; enemyLevel <= 100; ++enemyLevel) {
+            int64_t levelModifier = std::min<int64_t>(
+                std::max<int64_t>(1000 + (enemyLevel - playerLevel) * 150, 250), 3000);
+            int64_t numerator = 20 * levelModifier * (1000 + enemyLevel * 100);
+            int64_t expected = std::min<int64_t>(std::max<int64_t>(numerator / 1000000, 1), 1000);
+            REQUIRE(db.calculateExperienceReward(playerLevel, enemyLevel, false) == expected);
+        }
+    }
+}
+
+TEST_CASE("Experience rewards outside the table fall back to the formula", "[LevelDatabase]") {
+    EnemyDatabase::getInstance().initialize();
+    REQUIRE(EnemyDatabase::getInstance().getMaxLevel() >= 1);
+    LevelDatabase& db = LevelDatabase::getInstance();
+    db.initialize();
+
+    // In the table: 20 * 1.0 * 1.5 * 5
+    REQUIRE(db.calculateExperienceReward(5, 5, true) == 150);
+    REQUIRE(db.calculateExperienceReward(100, 100, true) == 1000);
+
+    // Past the level cap on either side
+    REQUIRE(db.calculateExperienceReward(150, 1, false) == 5);
+    REQUIRE(db.calculateExperienceReward(100, 101, false) == 255);
+    REQUIRE(db.calculateExperienceReward(101, 100, false) == 187);
+    // Nonsense levels still give something sensible
+    REQUIRE(db.calculateExperienceReward(0, 0, false) == 20);
+    REQUIRE(db.calculateExperienceReward(1, -20, false) == 1);
+}
+
+TEST_CASE("Experience requirements use integer maths", "[LevelDatabase]") {
+    LevelDatabase& db = LevelDatabase::getInstance();
+    db.initialize();
+
+    // floor(100 * 11^1.8) + 11 * 50 = 7490 + 550
+    REQUIRE(db.getExperienceForLevel(11) - db.getExperienceForLevel(10) == 8040);
+    // 32^1.8 is exactly 512: a whole number, which pow() may land either side of
+    REQUIRE(db.getExperienceForLevel(32) - db.getExperienceForLevel(31) == 51200 + 1600);
+}
+
+TEST_CASE("Endless levels follow the endgame curves past the table", "[LevelDatabase]") {
+    LevelDatabase& db = LevelDatabase::getInstance();
+    db.initialize();
+    REQUIRE_FALSE(db.setLevelCap(99));
+    REQUIRE_FALSE(db.setLevelCap(LevelDatabase::MAX_LEVEL_CAP + 1));
+    REQUIRE(db.getMaxLevel() == 100);
+    REQUIRE(db.setLevelCap(LevelDatabase::MAX_LEVEL_CAP));
+    REQUIRE(db.getMaxLevel() == LevelDatabase::MAX_LEVEL_CAP);
+
+    // No templates are made for them
+    REQUIRE(db.getLevelTemplate(101) == nullptr);
+    REQUIRE(db.getLevelTitle(101) == "Prestige 1");
+    REQUIRE(db.getExperienceForNextLevel(LevelDatabase::MAX_LEVEL_CAP) == 0);
+    REQUIRE(db.getExperienceForLevel(LevelDatabase::MAX_LEVEL_CAP + 1) == 0);
+
+    // Experience keeps to floor(100 * level^1.8) + level * 50 per level, exactly, in 64 bits
+    // (expected values worked out with arbitrary-precision integers)
+    auto requirement = [&db](int level) {
+        return db.getExperienceForLevel(level) - db.getExperienceForLevel(level - 1);
+    };
+    REQUIRE(requirement(101) == 410351);
+    REQUIRE(requirement(12345) == 2316326176ull);
+    REQUIRE(requirement(LevelDatabase::MAX_LEVEL_CAP) == 6309623444801ull);
+    REQUIRE(db.getExperienceForLevel(2000) - db.getExperienceForLevel(100) == 62606952647ull);
+    for (int level : {4095, 4096, 4097, 4096 * 7 + 2048, 4096 * 7 + 2049}) {
+        REQUIRE(requirement(level) == curvePower(level) + static_cast<uint64_t>(level) * 50);
+    }
+    REQUIRE(db.getExperienceForLevel(LevelDatabase::MAX_LEVEL_CAP) > UINT_MAX);
+
+    for (int level : {101, 102, 12345, 500000, LevelDatabase::MAX_LEVEL_CAP}) {
+        uint64_t total = db.getExperienceForLevel(level);
+        REQUIRE(db.getLevelFromExperience(total) == level);
+        REQUIRE(db.getLevelFromExperience(total - 1) == level - 1);
+    }
+    REQUIRE(db.getLevelFromExperience(UINT64_MAX) == LevelDatabase::MAX_LEVEL_CAP);
+
+    // Bonuses carry on along the endgame lines
+    unsigned int health, stamina, defence, resistance;
+    db.getStatBonuses(100, health, stamina, defence, resistance);
+    uint64_t expectedHealth = health;
+    uint64_t expectedDefence = defence;
+    for (int level = 101; level <= 300; ++level) {
+        expectedHealth += 100 + (level - 50) * 20;
+        expectedDefence += 8 + (level - 50) / 2;
+    }
+    db.getStatBonuses(300, health, stamina, defence, resistance);
+    REQUIRE(health == expectedHealth);
+    REQUIRE(defence == expectedDefence);
+    db.getStatBonuses(LevelDatabase::MAX_LEVEL_CAP, health, stamina, defence, resistance);
+    REQUIRE(health == UINT_MAX);
+
+    // initialize() goes back to the table's cap
+    db.initialize();
+    REQUIRE(db.getMaxLevel() == 100);
+    REQUIRE(db.getExperienceForLevel(101) == 0);
+}
+
+TEST_CASE("The experience curve's checkpoints are its exact running totals", "[LevelDatabase]") {
+    REQUIRE(curvePower(1) == 100);
+    REQUIRE(curvePower(32) == 51200);
+
+    // Walk every level, as the checkpoints were made, and check each one on the way
+    uint64_t sum = 0;
+    uint64_t power = 0;
+    size_t checked = 1;
+    REQUIRE(getCurveCheckpoint(0) == 0);
+    for (int level = 1; level <= CURVE_MAX_LEVEL; ++level) {
+        uint64_t guess = nextCurvePowerGuess(level - 1, power);
+        power = curvePower(level, guess);
+        if (level % 1000 == 0) REQUIRE(power == curvePower(level));
+        sum += power;
+        if (level % CURVE_CHECKPOINT_SPACING == 0) {
+            REQUIRE(getCurveCheckpoint(checked) == sum);
+            ++checked;
+        }
+        // Sums between checkpoints come from either side of them
+        if (level == 5000 || level == 8000 || level == 999999) {
+            REQUIRE(curvePowerSum(level) == sum);
+        }
+    }
+    REQUIRE(checked == getCurveCheckpointCount());
+}
+
+TEST_CASE("Fixed-point multipliers round toward zero", "[LevelDatabase]") {
+    REQUIRE(applyPermille(1000, 1100) == 1100);
+    REQUIRE(applyPermille(7, 1500) == 10);
+    REQUIRE(applyPermille(-7, 1500) == -10);
+
+    // Stamina recovery at 30% and 6%
+    REQUIRE(getStaminaRecovery(50, DEFEND_STAMINA_RECOVERY) == 15);
+    REQUIRE(getStaminaRecovery(50, TURN_STAMINA_RECOVERY) == 3);
+    REQUIRE(getStaminaRecovery(49, TURN_STAMINA_RECOVERY) == 2);
+    REQUIRE(getStaminaRecovery(0, DEFEND_STAMINA_RECOVERY) == 0);
+
+    // The level table's multipliers are whole thousandths
+    LevelDatabase& db = LevelDatabase::getInstance();
+    db.initialize();
+    REQUIRE(db.getLevelTemplate(10)->healthMultiplier == 1200);
+    REQUIRE(db.getLevelTemplate(20)->staminaMultiplier == 1250);
+    REQUIRE(db.getLevelTemplate(100)->healthMultiplier == 3000);
+}
+
 TEST_CASE("LevelDatabase experience calculation boundary conditions", "[LevelDatabase]") {
     LevelDatabase& db = LevelDatabase::getInstance();
     db.initialize();
@@ -0,0 +1,231 @@
+#include <algorithm>
+#include <catch2/catch_test_macros.hpp>
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include "../src/items/itemdatabase.hpp"
+#include "../src/loot/loottable.hpp"
+
+namespace {
+void initializeDatabases() {
+    ItemDatabase::getInstance().initialize();
+    LootTableDatabase::getInstance().initialize();
+}
+
+double probabilityOf(const LootTable& table, const ItemTemplate* item) {
+    for (size_t i = 0; i < table.getOutcomeCount(); ++i) {
+        if (table.getOutcome(i) == item) return table.getProbability(i);
+    }
+    return 0.0;
+}
+
+double probabilityOfType(const LootTable& table, ItemType type) {
+    double probability = 0.0;
+    for (size_t i = 0; i < table.getOutcomeCount(); ++i) {
+        const ItemTemplate* item = table.getOutcome(i);
+        if (item && item->type == type) probability += table.getProbability(i);
+    }
+    return probability;
+}
+}  // namespace
+
+TEST_CASE("Built-in chest tables are compiled for every tier", "[loottable]") {
+    initializeDatabases();
+    LootTableDatabase& db = LootTableDatabase::getInstance();
+
+    REQUIRE(LootTableDatabase::getChestTierForLevel(1) == ChestTier::WOODEN);
+    REQUIRE(LootTableDatabase::getChestTierForLevel(5) == ChestTier::IRON);
+    REQUIRE(LootTableDatabase::getChestTierForLevel(12) == ChestTier::GOLDEN);
+
+    for (ChestTier tier : {ChestTier::WOODEN, ChestTier::IRON, ChestTier::GOLDEN}) {
+        const LootTable* table = db.getChestTable(tier);
+        REQUIRE(table != nullptr);
+        REQUIRE(table->getName() == LootTableDatabase::getChestTableName(tier));
+
+        double total = 0.0;
+        for (size_t i = 0; i < table->getOutcomeCount(); ++i) {
+            REQUIRE(table->getOutcome(i) != nullptr);
+            total += table->getProbability(i);
+        }
+        REQUIRE(std::abs(total - 1.0) < 1e-9);
+    }
+
+    // Wooden chests keep the old item type split, but favour common items within a type
+    const LootTable& wooden = *db.getChestTable(ChestTier::WOODEN);
+    REQUIRE(std::abs(probabilityOfType(wooden, CURRENCY) - 0.40) < 1e-9);
+    REQUIRE(std::abs(probabilityOfType(wooden, POTION) - 0.25) < 1e-9);
+    REQUIRE(std::abs(probabilityOfType(wooden, WEAPON) - 0.20) < 1e-9);
+    REQUIRE(std::abs(probabilityOfType(wooden, ARMOR) - 0.10) < 1e-9);
+    REQUIRE(std::abs(probabilityOfType(wooden, MISC) - 0.05) < 1e-9);
+
+    ItemDatabase& items = ItemDatabase::getInstance();
+    REQUIRE(probabilityOf(wooden, items.getItemTemplate("Iron Sword")) >
+            probabilityOf(wooden, items.getItemTemplate("Steel Sword")));
+
+    // Golden chests lean towards rarer gear than wooden ones
+    const LootTable& golden = *db.getChestTable(ChestTier::GOLDEN);
+    const ItemTemplate* steelArmor = items.getItemTemplate("Steel Armor");
+    REQUIRE(steelArmor != nullptr);
+    REQUIRE(probabilityOf(golden, steelArmor) > probabilityOf(wooden, steelArmor));
+}
+
+TEST_CASE("Nested loot tables are flattened into one distribution", "[loottable]") {
+    initializeDatabases();
+    LootTableDatabase& db = LootTableDatabase::getInstance();
+    ItemDatabase& items = ItemDatabase::getInstance();
+
+    LootTableDefinition inner;
+    inner.name = "Test Inner";
+    inner.entries = {LootEntry::item("Healing Potion", 3), LootEntry::nothing(1)};
+    REQUIRE(db.addTable(inner));
+
+    LootTableDefinition outer;
+    outer.name = "Test Outer";
+    outer.entries = {LootEntry::item("Iron Sword", 1), LootEntry::table("Test Inner", 1)};
+    REQUIRE(db.addTable(outer));
+
+    const LootTable* table = db.getTable("Test Outer");
+    REQUIRE(table != nullptr);
+    REQUIRE(table->getOutcomeCount() == 3);
+    REQUIRE(std::abs(probabilityOf(*table, items.getItemTemplate("Iron Sword")) - 0.5) < 1e-12);
+    REQUIRE(std::abs(probabilityOf(*table, items.getItemTemplate("Healing Potion")) - 0.375) <
+            1e-12);
+    REQUIRE(std::abs(probabilityOf(*table, nullptr) - 0.125) < 1e-12);
+
+    SECTION("Rarity weights of zero leave those items out") {
+        LootTableDefinition commonOnly;
+        commonOnly.name = "Test Common Weapons";
+        commonOnly.entries = {LootEntry::ofType(WEAPON, 1)};
+        commonOnly.rarityWeights = {1.0, 0.0, 0.0, 0.0, 0.0, 0.0};
+        REQUIRE(db.addTable(commonOnly));
+
+        const LootTable* weapons = db.getTable("Test Common Weapons");
+        REQUIRE(weapons != nullptr);
+        REQUIRE(weapons->getOutcomeCount() == 3);
+        for (size_t i = 0; i < weapons->getOutcomeCount(); ++i) {
+            REQUIRE(weapons->getOutcome(i)->rarity == COMMON);
+        }
+    }
+
+    SECTION("Tables that can't be compiled are rejected") {
+        LootTableDefinition unknown;
+        unknown.name = "Test Unknown";
+        unknown.entries = {LootEntry::item("Not An Item", 1)};
+        REQUIRE_FALSE(db.addTable(unknown));
+        REQUIRE(db.getTable("Test Unknown") == nullptr);
+
+        // Pointing the inner table back at the outer one would make a cycle
+        LootTableDefinition cycle = inner;
+        cycle.entries.push_back(LootEntry::table("Test Outer", 1));
+        REQUIRE_FALSE(db.addTable(cycle));
+
+        // The old definitions are left alone
+        REQUIRE(db.getTable("Test Outer") == table);
+        REQUIRE(table->getOutcomeCount() == 3);
+    }
+}
+
+TEST_CASE("Alias sampling matches the table's probabilities", "[loottable]") {
+    initializeDatabases();
+    const LootTable& table = *LootTableDatabase::getInstance().getChestTable(ChestTier::GOLDEN);
+
+    const size_t draws = 400000;
+    std::vector<uint32_t> outcomes(draws);
+    std::mt19937 rng(2024);
+    table.drawBatch(rng, outcomes.data(), outcomes.size());
+
+    std::vector<size_t> counts(table.getOutcomeCount() + 1, 0);
+    for (uint32_t outcome : outcomes) {
+        ++counts[std::min<size_t>(outcome, table.getOutcomeCount())];
+    }
+    REQUIRE(counts.back() == 0);  // Every draw lands on a real outcome
+    counts.pop_back();
+    for (size_t i = 0; i < counts.size(); ++i) {
+        double observed = static_cast<double>(counts[i]) / draws;
+        REQUIRE(std::abs(observed - table.getProbability(i)) < 0.005);
+    }
+
+    // Batched and single draws consume the generator the same way
+    std::mt19937 batchRng(7);
+    std::mt19937 singleRng(7);
+    std::vector<uint32_t> batch(1000);
+    table.drawBatch(batchRng, batch.data(), batch.size());
+    for (uint32_t outcome : batch) {
+        REQUIRE(table.drawIndex(singleRng) == outcome);
+    }
+}
+
+TEST_CASE("Loot tables survive the databases being re-initialized", "[loottable]") {
+    initializeDatabases();
+    const LootTable* table = LootTableDatabase::getInstance().getChestTable(ChestTier::WOODEN);
+    const ItemTemplate* sword = ItemDatabase::getInstance().getItemTemplate("Iron Sword");
+
+    initializeDatabases();
+    REQUIRE(LootTableDatabase::getInstance().getChestTable(ChestTier::WOODEN) == table);
+    REQUIRE(ItemDatabase::getInstance().getItemTemplate("Iron Sword") == sword);
+    REQUIRE(probabilityOf(*table, sword) > 0.0);
+
+    Item* item = ItemDatabase::getInstance().createItem(*sword, 3);
+    REQUIRE(item->getName() == "Iron Sword");
+    REQUIRE(item->getWeaponData().getMinDamage() == 8);
+    delete item;
+}
+
+TEST_CASE("Enemy drop tables cover every type and rarity", "[loottable]") {
+    initializeDatabases();
+    const LootTableDatabase& db = LootTableDatabase::getInstance();
+
+    for (size_t type = 0; type < ENEMY_TYPE_COUNT; ++type) {
+        for (size_t rarity = 0; rarity < ENEMY_RARITY_COUNT; ++rarity) {
+            EnemyType enemyType = static_cast<EnemyType>(type);
+            EnemyRarity enemyRarity = static_cast<EnemyRarity>(rarity);
+            const LootTable* table = db.getEnemyDropTable(enemyType, enemyRarity);
+            REQUIRE(table != nullptr);
+            REQUIRE(table ==
+                    db.getTable(LootTableDatabase::getEnemyDropTableName(enemyType, enemyRarity)));
+        }
+    }
+    REQUIRE(LootTableDatabase::getEnemyDropTableName(EnemyType::DRAGON, EnemyRarity::BOSS) ==
+            "Dragon Drops (Boss)");
+
+    // Bosses always drop something on every roll, common enemies usually don't
+    const LootTable* boss = db.getEnemyDropTable(EnemyType::DEMON, EnemyRarity::BOSS);
+    REQUIRE(probabilityOf(*boss, nullptr) == 0.0);
+    const LootTable* common = db.getEnemyDropTable(EnemyType::BEAST, EnemyRarity::COMMON);
+    REQUIRE(std::abs(probabilityOf(*common, nullptr) - 0.75) < 1e-9);
+
+    // Beasts don't carry weapons
+    REQUIRE(probabilityOfType(*common, WEAPON) == 0.0);
+}
+
+TEST_CASE("Enemy drops are reproducible with a fixed seed", "[loottable]") {
+    initializeDatabases();
+    const LootTableDatabase& db = LootTableDatabase::getInstance();
+
+    auto rollKills = [&db](EnemyType type, EnemyRarity rarity, unsigned int seed, int kills) {
+        std::mt19937 rng(seed);
+        std::vector<const ItemTemplate*> all;
+        for (int kill = 0; kill < kills; ++kill) {
+            const ItemTemplate* drops[LootTableDatabase::MAX_DROP_ROLLS];
+            int dropCount = db.rollEnemyDrops(type, rarity, rng, drops);
+            REQUIRE(dropCount >= 0);
+            REQUIRE(dropCount <= LootTableDatabase::getDropRolls(rarity));
+            all.insert(all.end(), drops, drops + dropCount);
+        }
+        return all;
+    };
+
+    auto first = rollKills(EnemyType::GOBLINOID, EnemyRarity::COMMON, 99, 10000);
+    auto second = rollKills(EnemyType::GOBLINOID, EnemyRarity::COMMON, 99, 10000);
+    REQUIRE(first == second);
+    // One roll at a 25% drop chance
+    REQUIRE(first.size() > 2200);
+    REQUIRE(first.size() < 2800);
+
+    auto bossDrops = rollKills(EnemyType::DRAGON, EnemyRarity::BOSS, 5, 100);
+    REQUIRE(bossDrops.size() == 100 * LootTableDatabase::MAX_DROP_ROLLS);
+    for (const ItemTemplate* drop : bossDrops) {
+        REQUIRE(drop->rarity != COMMON);
+    }
+}
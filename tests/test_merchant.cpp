@@ -0,0 +1,95 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "../src/items/itemdatabase.hpp"
+#include "../src/merchants/merchant.hpp"
+
+namespace {
+size_t findEntry(const Merchant& merchant, const std::string& itemName) {
+    const std::vector<MerchantStockEntry>& stock = merchant.getStock();
+    for (size_t i = 0; i < stock.size(); ++i) {
+        if (stock[i].item->name == itemName) return i;
+    }
+    return stock.size();
+}
+}  // namespace
+
+TEST_CASE("Merchants stock every template of their specialty", "[merchant]") {
+    ItemDatabase::getInstance().initialize();
+    Merchant merchant(WEAPON, 0);
+
+    REQUIRE(merchant.getSpecialty() == WEAPON);
+    size_t weaponCount = ItemDatabase::getInstance().getItemsByType(WEAPON).size();
+    REQUIRE(merchant.getStock().size() == weaponCount);
+    for (const MerchantStockEntry& entry : merchant.getStock()) {
+        REQUIRE(entry.item->type == WEAPON);
+        REQUIRE(entry.price == entry.item->value);
+        REQUIRE(entry.quantity == entry.maxQuantity);
+        REQUIRE(entry.quantity >= 1);
+    }
+
+    // Common items are stocked deeper than rare ones
+    size_t ironSword = findEntry(merchant, "Iron Sword");
+    REQUIRE(ironSword < merchant.getStock().size());
+    REQUIRE(merchant.getStock()[ironSword].maxQuantity == 3);
+}
+
+TEST_CASE("Items are only created when bought", "[merchant]") {
+    ItemDatabase::getInstance().initialize();
+    Merchant merchant(WEAPON, 0);
+    size_t entry = findEntry(merchant, "Iron Sword");
+
+    for (int bought = 0; bought < 3; ++bought) {
+        Item* item = merchant.takeItem(entry, 7);
+        REQUIRE(item != nullptr);
+        REQUIRE(item->getName() == "Iron Sword");
+        REQUIRE(item->getId() == 7);
+        REQUIRE(item->getWeaponData().getMinDamage() == 8);
+        delete item;
+    }
+    REQUIRE(merchant.getStock()[entry].quantity == 0);
+    REQUIRE(merchant.takeItem(entry, 1) == nullptr);
+    REQUIRE(merchant.takeItem(merchant.getStock().size(), 1) == nullptr);
+
+    // Items sold to the merchant go back on the shelf, if it's something they deal in
+    const ItemTemplate* sword = ItemDatabase::getInstance().getItemTemplate("Iron Sword");
+    const ItemTemplate* potion = ItemDatabase::getInstance().getItemTemplate("Healing Potion");
+    REQUIRE(merchant.acceptItem(*sword));
+    REQUIRE(merchant.getStock()[entry].quantity == 1);
+    REQUIRE_FALSE(merchant.acceptItem(*potion));
+}
+
+TEST_CASE("Merchants restock a little at a time", "[merchant]") {
+    ItemDatabase::getInstance().initialize();
+    Merchant merchant(WEAPON, 10);
+    size_t entry = findEntry(merchant, "Iron Sword");
+    for (int i = 0; i < 3; ++i) delete merchant.takeItem(entry, 1);
+
+    // Not a full interval yet
+    merchant.restock(10 + Merchant::RESTOCK_INTERVAL - 1);
+    REQUIRE(merchant.getStock()[entry].quantity == 0);
+
+    // The partial interval counts towards the next restock
+    merchant.restock(10 + Merchant::RESTOCK_INTERVAL);
+    REQUIRE(merchant.getStock()[entry].quantity == 1);
+
+    // Time running backwards does nothing, and restocking stops at the maximum
+    merchant.restock(0);
+    REQUIRE(merchant.getStock()[entry].quantity == 1);
+    merchant.restock(10 + 100 * Merchant::RESTOCK_INTERVAL);
+    REQUIRE(merchant.getStock()[entry].quantity == 3);
+}
+
+TEST_CASE("The roster keeps one persistent merchant per item type", "[merchant]") {
+    ItemDatabase::getInstance().initialize();
+    MerchantRoster roster(0);
+
+    for (ItemType type : {WEAPON, ARMOR, POTION, CURRENCY, MISC}) {
+        REQUIRE(roster.getMerchant(type).getSpecialty() == type);
+    }
+
+    Merchant& potions = roster.getMerchant(POTION);
+    delete potions.takeItem(0, 1);
+    REQUIRE(&roster.getMerchant(POTION) == &potions);
+    REQUIRE(roster.getMerchant(POTION).getStock()[0].quantity ==
+            roster.getMerchant(POTION).getStock()[0].maxQuantity - 1);
+}
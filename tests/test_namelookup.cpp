@@ -0,0 +1,86 @@
+#include <catch2/catch_test_macros.hpp>
+#include <array>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "../src/enemies/enemydatabase.hpp"
+#include "../src/items/itemdatabase.hpp"
+#include "../src/text/namelookup.hpp"
+
+namespace {
+
+constexpr std::array<std::string_view, 4> NAMES = {"Iron Sword", "Bread", "Torch", "Goblin"};
+constexpr PerfectNameHash<4> HASH(NAMES);
+
+}  // namespace
+
+TEST_CASE("Perfect hash finds every listed name at compile time", "[NameLookup]") {
+    static_assert(HASH.isPerfect());
+    static_assert(HASH.find("Iron Sword") == 0);
+    static_assert(HASH.find("Goblin") == 3);
+    static_assert(HASH.find("Iron Swor") == -1);
+
+    for (size_t i = 0; i < NAMES.size(); ++i) {
+        REQUIRE(HASH.find(std::string(NAMES[i])) == static_cast<int>(i));
+    }
+    REQUIRE(HASH.find("") == -1);
+    REQUIRE(HASH.find("Dragon Egg") == -1);
+}
+
+TEST_CASE("A name list with a repeat has no perfect hash", "[NameLookup]") {
+    constexpr PerfectNameHash<3> repeated({"Bread", "Torch", "Bread"});
+    static_assert(!repeated.isPerfect());
+    constexpr PerfectNameHash<2> blank({"Bread", ""});
+    static_assert(!blank.isPerfect());
+}
+
+TEST_CASE("Name table inserts, replaces and grows", "[NameLookup]") {
+    NameTable<int> table;
+    REQUIRE(table.find("anything") == nullptr);
+
+    std::vector<std::string> names;
+    std::vector<int> values(200);
+    for (int i = 0; i < 200; ++i) {
+        names.push_back("Creature " + std::to_string(i));
+        values[i] = i;
+    }
+    for (int i = 0; i < 200; ++i) table.insert(names[i], &values[i]);
+    REQUIRE(table.size() == 200);
+    for (int i = 0; i < 200; ++i) {
+        REQUIRE(table.find(names[i]) == &values[i]);
+    }
+    REQUIRE(table.find("Creature 200") == nullptr);
+
+    int replacement = -1;
+    table.insert(names[7], &replacement);
+    REQUIRE(table.size() == 200);
+    REQUIRE(table.find("Creature 7") == &replacement);
+
+    table.clear();
+    REQUIRE(table.size() == 0);
+    REQUIRE(table.find("Creature 7") == nullptr);
+}
+
+TEST_CASE("Every built-in item and enemy is on the compile-time list", "[NameLookup]") {
+    ItemDatabase& items = ItemDatabase::getInstance();
+    items.initialize();
+    std::vector<std::string> itemNames = items.getAllItemNames();
+    REQUIRE(itemNames.size() == ItemDatabase::BUILTIN_ITEM_COUNT);
+    for (const std::string& name : itemNames) {
+        const ItemTemplate* itemTemplate = items.getItemTemplate(name);
+        REQUIRE(itemTemplate != nullptr);
+        REQUIRE(itemTemplate->name == name);
+    }
+
+    EnemyDatabase& enemies = EnemyDatabase::getInstance();
+    enemies.initialize();
+    std::vector<std::string> enemyNames = enemies.getAllEnemyNames();
+    REQUIRE(enemyNames.size() == EnemyDatabase::BUILTIN_ENEMY_COUNT);
+    for (const std::string& name : enemyNames) {
+        const EnemyTemplate* enemyTemplate = enemies.getEnemyTemplate(name);
+        REQUIRE(enemyTemplate != nullptr);
+        REQUIRE(enemyTemplate->name == name);
+    }
+    REQUIRE(enemies.getEnemyTemplate("Goblin Queen") == nullptr);
+}
@@ -1,4 +1,5 @@
 #include <catch2/catch_test_macros.hpp>
+#include <sstream>
 
 #include "../src/levels/leveldatabase.hpp"
 #include "../src/player/player.hpp"
@@ -111,6 +112,22 @@ TEST_CASE("Player gains experience and levels up correctly", "[Player]") {
     REQUIRE(player.getNextLevelExp() == 450);  // Next level at 450 experience
 }
 
+TEST_CASE("Player levels past the table in endless mode", "[Player]") {
+    LevelDatabase& db = LevelDatabase::getInstance();
+    db.initialize();
+    REQUIRE(db.setLevelCap(LevelDatabase::MAX_LEVEL_CAP));
+
+    Player player("Test Player", 100, 100, 50, 50, 5, 3, 1, 0, 100, 100, 0);
+    std::ostringstream out;
+    for (int i = 0; i < 4; ++i) player.gainExperience(4000000000u, out);
+    REQUIRE(player.getExperience() == 16000000000ull);
+    REQUIRE(player.getLevel() > 100);
+    REQUIRE(player.getNextLevelExp() > player.getExperience());
+    REQUIRE(out.str().find("Prestige") != std::string::npos);
+    REQUIRE(player.getHealth() == static_cast<int>(player.getMaxHealth()));
+    db.initialize();
+}
+
 TEST_CASE("Player inventory management works correctly", "[Player]") {
     Player player("Test Player", 100, 100, 50, 50, 5, 3, 1, 0, 100, 100, 0);
     Item* sword = new Item(1, "Sword", "A sharp blade.", 100, 5, WEAPON, COMMON);
@@ -153,4 +170,52 @@ TEST_CASE("Player equips and unequips items correctly", "[Player]") {
 
     delete sword;
     delete shield;
-}
\ No newline at end of file
+}
+TEST_CASE("Identical stackable items share one inventory slot", "[Player]") {
+    Player player("Test Player", 100, 100, 50, 50, 5, 3, 1, 0, 100, 100, 0);
+    Item* first = new Item(1, "Minor Healing Potion", "Heals.", 10, 2, POTION, COMMON);
+    Item* sword = new Item(2, "Sword", "A sharp blade.", 100, 5, WEAPON, COMMON);
+
+    REQUIRE(player.addItemToInventory(first) == first);
+    REQUIRE(player.addItemToInventory(sword) == sword);
+    for (int i = 0; i < 19; ++i) {
+        Item* potion = new Item(3 + i, "Minor Healing Potion", "Heals.", 10, 2, POTION, COMMON);
+        REQUIRE(player.addItemToInventory(potion) == first);
+    }
+    REQUIRE(player.getInventory().size() == 2);
+    REQUIRE(first->getQuantity() == 20);
+    REQUIRE(player.getTotalWeight() == 20 * 2 + 5);
+
+    // Using one only takes it off the stack
+    REQUIRE(player.removeItemFromInventory(first));
+    REQUIRE(first->getQuantity() == 19);
+    REQUIRE(player.getTotalWeight() == 19 * 2 + 5);
+
+    // Taking the rest empties the slot
+    REQUIRE(player.removeItemFromInventory(first, 19));
+    REQUIRE(player.getInventory().size() == 1);
+    REQUIRE(player.getInventory()[0] == sword);
+    REQUIRE(player.getTotalWeight() == 5);
+
+    // Weapons never stack
+    Item* otherSword = new Item(30, "Sword", "A sharp blade.", 100, 5, WEAPON, COMMON);
+    REQUIRE(player.addItemToInventory(otherSword) == otherSword);
+    REQUIRE(player.getInventory().size() == 2);
+
+    REQUIRE(player.removeItemFromInventory(sword));
+    REQUIRE(player.removeItemFromInventory(otherSword));
+    REQUIRE(player.getInventory().empty());
+    Item notCarried;
+    REQUIRE_FALSE(player.removeItemFromInventory(&notCarried));
+}
+
+TEST_CASE("Picking up a currency stack pays out every coin", "[Player]") {
+    Player player("Test Player", 100, 100, 50, 50, 5, 3, 1, 0, 100, 100, 0);
+    Item* coins = new Item(1, "Gold Coin", "Shiny.", 5, 0, CURRENCY, COMMON);
+    coins->setQuantity(7);
+
+    std::ostringstream out;
+    REQUIRE(player.pickupItem(coins, out));
+    REQUIRE(player.getGold() == 100 + 35);
+    REQUIRE(player.getInventory().empty());
+}
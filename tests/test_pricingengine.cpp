@@ -0,0 +1,159 @@
+#include <catch2/catch_test_macros.hpp>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "../src/items/itemdatabase.hpp"
+#include "../src/merchants/merchant.hpp"
+#include "../src/merchants/pricingengine.hpp"
+
+namespace {
+const ItemTemplate& getTemplate(const std::string& name) {
+    return *ItemDatabase::getInstance().getItemTemplate(name);
+}
+
+void initializePricing() {
+    ItemDatabase::getInstance().initialize();
+    PricingEngine::getInstance().initialize();
+}
+}  // namespace
+
+TEST_CASE("Templates get dense indices", "[pricing]") {
+    ItemDatabase::getInstance().initialize();
+    const ItemDatabase& itemDatabase = ItemDatabase::getInstance();
+
+    REQUIRE(itemDatabase.getTemplateCount() > 0);
+    for (size_t i = 0; i < itemDatabase.getTemplateCount(); ++i) {
+        REQUIRE(itemDatabase.getTemplateByIndex(i)->index == i);
+    }
+    REQUIRE(itemDatabase.getTemplateByIndex(itemDatabase.getTemplateCount()) == nullptr);
+}
+
+TEST_CASE("Prices start at the template value", "[pricing]") {
+    initializePricing();
+    PricingEngine& pricing = PricingEngine::getInstance();
+    const ItemDatabase& itemDatabase = ItemDatabase::getInstance();
+
+    REQUIRE(pricing.getSnapshotVersion() == 1);
+    for (size_t i = 0; i < itemDatabase.getTemplateCount(); ++i) {
+        const ItemTemplate& item = *itemDatabase.getTemplateByIndex(i);
+        REQUIRE(pricing.getPrice(item) == item.value);
+    }
+
+    // Nothing traded, so a recompute leaves every price alone
+    pricing.recompute();
+    REQUIRE(pricing.getSnapshotVersion() == 2);
+    for (size_t i = 0; i < itemDatabase.getTemplateCount(); ++i) {
+        const ItemTemplate& item = *itemDatabase.getTemplateByIndex(i);
+        REQUIRE(pricing.getPrice(item) == item.value);
+    }
+}
+
+TEST_CASE("Demand raises prices and supply lowers them", "[pricing]") {
+    initializePricing();
+    PricingEngine& pricing = PricingEngine::getInstance();
+    const ItemTemplate& ironSword = getTemplate("Iron Sword");
+    const ItemTemplate& steelSword = getTemplate("Steel Sword");
+
+    pricing.recordPurchase(ironSword, 10);
+    pricing.recordSale(steelSword, 10);
+    // Trades only show up once the prices are recomputed
+    REQUIRE(pricing.getPrice(ironSword) == ironSword.value);
+    pricing.recompute();
+    int ironPrice = pricing.getPrice(ironSword);
+    int steelPrice = pricing.getPrice(steelSword);
+    REQUIRE(ironPrice > ironSword.value);
+    REQUIRE(steelPrice < steelSword.value);
+
+    // No matter how lopsided trading gets, prices stay within the swing of the base value
+    for (int i = 0; i < 50; ++i) {
+        pricing.recordPurchase(ironSword, 1000);
+        pricing.recordSale(steelSword, 1000);
+        pricing.recompute();
+    }
+    REQUIRE(pricing.getPrice(ironSword) <= ironSword.value * 3 / 2);
+    REQUIRE(pricing.getPrice(ironSword) > ironPrice);
+    REQUIRE(pricing.getPrice(steelSword) >= steelSword.value / 2);
+    REQUIRE(pricing.getPrice(steelSword) < steelPrice);
+
+    // Once trading stops, prices drift back to the base value
+    for (int i = 0; i < 200; ++i) pricing.recompute();
+    REQUIRE(pricing.getPrice(ironSword) == ironSword.value);
+    REQUIRE(pricing.getPrice(steelSword) == steelSword.value);
+}
+
+TEST_CASE("Merchants price their stock from the current snapshot", "[pricing]") {
+    initializePricing();
+    PricingEngine& pricing = PricingEngine::getInstance();
+    const ItemTemplate& ironSword = getTemplate("Iron Sword");
+    Merchant merchant(WEAPON, 0);
+
+    pricing.recordPurchase(ironSword, 20);
+    pricing.recompute();
+    merchant.updatePrices(pricing);
+    for (const MerchantStockEntry& entry : merchant.getStock()) {
+        REQUIRE(entry.price == pricing.getPrice(*entry.item));
+        if (entry.item == &ironSword) {
+            REQUIRE(entry.price > ironSword.value);
+        } else {
+            REQUIRE(entry.price == entry.item->value);
+        }
+    }
+}
+
+TEST_CASE("Recomputing only happens once the interval has passed", "[pricing]") {
+    initializePricing();
+    PricingEngine& pricing = PricingEngine::getInstance();
+
+    pricing.setRecomputeInterval(std::chrono::hours(1));
+    REQUIRE_FALSE(pricing.recomputeIfDue());
+    REQUIRE(pricing.getSnapshotVersion() == 1);
+
+    pricing.setRecomputeInterval(std::chrono::milliseconds(0));
+    REQUIRE(pricing.recomputeIfDue());
+    REQUIRE(pricing.getSnapshotVersion() == 2);
+
+    pricing.setRecomputeInterval(std::chrono::seconds(1));
+}
+
+TEST_CASE("Readers never see a half-published snapshot", "[pricing]") {
+    initializePricing();
+    PricingEngine& pricing = PricingEngine::getInstance();
+    const ItemDatabase& itemDatabase = ItemDatabase::getInstance();
+
+    std::vector<const ItemTemplate*> items;
+    for (size_t i = 0; i < itemDatabase.getTemplateCount(); ++i) {
+        items.push_back(itemDatabase.getTemplateByIndex(i));
+    }
+    const ItemTemplate& ironSword = getTemplate("Iron Sword");
+
+    std::atomic<bool> done{false};
+    std::atomic<int> badReads{0};
+    std::vector<std::thread> readers;
+    for (int t = 0; t < 3; ++t) {
+        readers.emplace_back([&] {
+            std::vector<int> prices(items.size());
+            while (!done.load()) {
+                pricing.readPrices(items.data(), items.size(), prices.data());
+                for (size_t i = 0; i < items.size(); ++i) {
+                    int base = items[i]->value;
+                    if (prices[i] < base / 2 || prices[i] > base * 3 / 2 + 1) ++badReads;
+                }
+            }
+        });
+    }
+
+    uint64_t lastVersion = pricing.getSnapshotVersion();
+    for (int i = 0; i < 2000; ++i) {
+        pricing.recordPurchase(ironSword, i % 7);
+        pricing.recordSale(ironSword, i % 5);
+        pricing.recompute();
+        uint64_t version = pricing.getSnapshotVersion();
+        REQUIRE(version > lastVersion);
+        lastVersion = version;
+    }
+    done = true;
+    for (std::thread& reader : readers) reader.join();
+
+    REQUIRE(badReads.load() == 0);
+}
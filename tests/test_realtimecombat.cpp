@@ -0,0 +1,248 @@
+#include <algorithm>
+#include <catch2/catch_test_macros.hpp>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "../src/enemies/encounter.hpp"
+#include "../src/enemies/enemydatabase.hpp"
+#include "../src/game/gamesession.hpp"
+#include "../src/game/realtimecombat.hpp"
+#include "../src/items/itemdatabase.hpp"
+#include "../src/levels/leveldatabase.hpp"
+#include "../src/loot/loottable.hpp"
+#include "../src/merchants/pricingengine.hpp"
+
+namespace {
+Player makePlayer() { return Player("Tester", 100, 100, 1000, 1000, 0, 0, 1, 0, 0, 100, 0); }
+
+// Never hits back and takes forever to kill
+Encounter makeDummy() {
+    Encounter encounter;
+    encounter.addEnemy(Enemy("Dummy", "A training dummy", 1, 1000000, 0, 0, 0, 0,
+                             EnemyType::HUMANOID, EnemyRarity::COMMON));
+    return encounter;
+}
+
+int countSwings(const std::vector<RealTimeEvent>& events) {
+    int swings = 0;
+    for (const RealTimeEvent& event : events) {
+        if (event.type == RealTimeEventType::PLAYER_HIT ||
+            event.type == RealTimeEventType::PLAYER_CRIT ||
+            event.type == RealTimeEventType::PLAYER_MISSED) {
+            ++swings;
+        }
+    }
+    return swings;
+}
+
+// Keeps an attack queued at all times for the given simulated time
+int swingsWith(const std::string& weaponName, int seconds) {
+    ItemDatabase::getInstance().initialize();
+    Player player = makePlayer();
+    Encounter dummy = makeDummy();
+    Item* weapon = ItemDatabase::getInstance().createItem(weaponName, 1);
+    player.addItemToInventory(weapon);
+    player.setEquippedWeapon(weapon);
+
+    std::mt19937 rng(5);
+    RealTimeCombat combat(player, dummy, rng);
+    std::vector<RealTimeEvent> events;
+    int swings = 0;
+    int ticks = seconds * 1000 / static_cast<int>(RealTimeCombat::TICK.count());
+    for (int i = 0; i < ticks; ++i) {
+        if (combat.getQueuedAction() == RealTimeAction::NONE) {
+            combat.queueAction(RealTimeAction::ATTACK);
+        }
+        combat.runTicks(1);
+        combat.takeEvents(events);
+        swings += countSwings(events);
+    }
+    player.removeItemFromInventory(weapon);
+    return swings;
+}
+}  // namespace
+
+TEST_CASE("Weapon cooldowns set the attack rate", "[RealTimeCombat]") {
+    // 500 ms vs 2000 ms cooldowns over 10 simulated seconds
+    REQUIRE(swingsWith("Rusty Dagger", 10) == 20);
+    REQUIRE(swingsWith("Battle Axe", 10) == 5);
+}
+
+TEST_CASE("Queued actions wait for the weapon to be ready", "[RealTimeCombat]") {
+    ItemDatabase::getInstance().initialize();
+    Player player = makePlayer();
+    Encounter dummy = makeDummy();
+    Item* axe = ItemDatabase::getInstance().createItem("Battle Axe", 1);
+    player.addItemToInventory(axe);
+    player.setEquippedWeapon(axe);
+
+    std::mt19937 rng(9);
+    RealTimeCombat combat(player, dummy, rng);
+    std::vector<RealTimeEvent> events;
+
+    combat.queueAction(RealTimeAction::ATTACK);
+    combat.runTicks(1);
+    combat.takeEvents(events);
+    REQUIRE(countSwings(events) == 1);
+    REQUIRE(axe->getWeaponData().isOnCooldown());
+    REQUIRE(combat.getPlayerReadyInMs() == 2000);
+
+    // Queued straight away, but it only lands once the axe is ready again
+    combat.queueAction(RealTimeAction::ATTACK);
+    combat.runTicks(39);
+    combat.takeEvents(events);
+    REQUIRE(countSwings(events) == 0);
+    REQUIRE(combat.getQueuedAction() == RealTimeAction::ATTACK);
+
+    combat.runTicks(1);
+    combat.takeEvents(events);
+    REQUIRE(countSwings(events) == 1);
+    REQUIRE(events.front().timeMs == 2050);
+
+    player.removeItemFromInventory(axe);
+}
+
+TEST_CASE("The clock runs in fixed steps whatever the frame rate", "[RealTimeCombat]") {
+    Player player = makePlayer();
+    Encounter dummy = makeDummy();
+    std::mt19937 rng(1);
+    RealTimeCombat combat(player, dummy, rng);
+
+    // Small frames add up to whole ticks
+    int ticks = 0;
+    for (int i = 0; i < 120; ++i) ticks += combat.advance(std::chrono::milliseconds(1));
+    REQUIRE(ticks == 2);
+    REQUIRE(combat.getTimeMs() == 100);
+    REQUIRE(combat.advance(std::chrono::milliseconds(30)) == 1);
+    REQUIRE(combat.getTimeMs() == 150);
+
+    // A long stall only catches up a bounded amount
+    REQUIRE(combat.advance(std::chrono::seconds(10)) == RealTimeCombat::MAX_CATCH_UP_TICKS);
+    REQUIRE(combat.getTimeMs() == 150 + RealTimeCombat::MAX_CATCH_UP_TICKS * 50);
+}
+
+TEST_CASE("Enemies attack on their own clock and blocking halves the hit", "[RealTimeCombat]") {
+    Player player("Tester", 100, 100, 50, 50, 0, 0, 1, 0, 0, 100, 0);
+    Encounter brute;
+    brute.addEnemy(Enemy("Brute", "Hits hard", 1, 1000, 10, 10, 0, 0, EnemyType::HUMANOID,
+                         EnemyRarity::COMMON));
+    std::mt19937 rng(3);
+    RealTimeCombat combat(player, brute, rng);
+    std::vector<RealTimeEvent> events;
+
+    combat.runTicks(30);  // 1.5 s
+    combat.takeEvents(events);
+    REQUIRE(events.size() == 1);
+    REQUIRE(events[0].type == RealTimeEventType::ENEMY_HIT);
+    REQUIRE(events[0].amount == 10);
+    REQUIRE(player.getHealth() == 90);
+
+    combat.queueAction(RealTimeAction::DEFEND);
+    combat.runTicks(30);
+    combat.takeEvents(events);
+    REQUIRE(events.size() == 2);
+    REQUIRE(events[0].type == RealTimeEventType::PLAYER_DEFENDING);
+    REQUIRE(events[1].type == RealTimeEventType::ENEMY_BLOCKED);
+    REQUIRE(player.getHealth() == 85);
+}
+
+TEST_CASE("Poison ticks once a second and can finish a fight", "[RealTimeCombat]") {
+    Player player = makePlayer();
+    Encounter weakling;
+    weakling.addEnemy(Enemy("Weakling", "Barely alive", 1, 5, 0, 0, 0, 0, EnemyType::BEAST,
+                            EnemyRarity::COMMON));
+    weakling.getStatusEffects(0).apply(StatusEffectType::POISON, 2, 5);
+    std::mt19937 rng(3);
+    RealTimeCombat combat(player, weakling, rng);
+
+    combat.runTicks(1000);
+    REQUIRE(combat.getOutcome() == RealTimeOutcome::VICTORY);
+    REQUIRE(combat.getTimeMs() == 3000);
+}
+
+TEST_CASE("Real-time attacks work through a pack in order", "[RealTimeCombat]") {
+    Player player = makePlayer();
+    Encounter pack;
+    for (int i = 0; i < 3; ++i) {
+        pack.addEnemy(Enemy("Rat", "Small and angry", 1, 4, 0, 0, 0, 0, EnemyType::BEAST,
+                            EnemyRarity::COMMON),
+                      EnemyAI::SWARM, makeAttackOnlyBehaviour());
+    }
+    std::mt19937 rng(4);
+    RealTimeCombat combat(player, pack, rng);
+    std::vector<RealTimeEvent> events;
+
+    // Unarmed hits always do at least 3, so every rat takes two swings at most
+    std::vector<size_t> targets;
+    for (int i = 0; i < 1000 && combat.getOutcome() == RealTimeOutcome::ONGOING; ++i) {
+        if (combat.getQueuedAction() == RealTimeAction::NONE) {
+            combat.queueAction(RealTimeAction::ATTACK);
+        }
+        combat.runTicks(1);
+        combat.takeEvents(events);
+        for (const RealTimeEvent& event : events) {
+            if (event.type == RealTimeEventType::PLAYER_HIT ||
+                event.type == RealTimeEventType::PLAYER_CRIT) {
+                targets.push_back(event.enemy);
+            }
+        }
+    }
+    REQUIRE(combat.getOutcome() == RealTimeOutcome::VICTORY);
+    REQUIRE(pack.isDefeated());
+    REQUIRE(std::is_sorted(targets.begin(), targets.end()));
+    REQUIRE(targets.back() == 2);
+}
+
+TEST_CASE("Sessions can fight in real time", "[RealTimeCombat]") {
+    ItemDatabase::getInstance().initialize();
+    EnemyDatabase::getInstance().initialize();
+    LevelDatabase::getInstance().initialize();
+    LootTableDatabase::getInstance().initialize();
+    PricingEngine::getInstance().initialize();
+
+    GameSession session(99);
+    session.setRealTimeCombat(true);
+    session.start();
+
+    int continuesLeft = 30;
+    int realTimeInputs = 0;
+    bool sawTurnBasedCombat = false;
+    for (int steps = 0; steps < 100000 && !session.isFinished(); ++steps) {
+        switch (session.getState()) {
+            case SessionState::AWAITING_NAME:
+                session.handleInput("Tester");
+                break;
+            case SessionState::AWAITING_CONTINUE:
+                session.handleInput(continuesLeft-- > 0 ? "y" : "n");
+                break;
+            case SessionState::CHEST_PROMPT:
+                session.handleInput("y");
+                break;
+            case SessionState::MERCHANT_MENU:
+                session.handleInput("3");
+                break;
+            case SessionState::COMBAT_REALTIME:
+                REQUIRE(session.needsUpdates());
+                if (steps % 10 == 0) {
+                    ++realTimeInputs;
+                    session.handleInput(session.getPlayer()->getStamina() >= 5 ? "a" : "d");
+                }
+                session.update(RealTimeCombat::TICK);
+                break;
+            case SessionState::COMBAT_ACTION:
+                sawTurnBasedCombat = true;
+                session.handleInput("1");
+                break;
+            default:
+                session.handleInput("0");
+                break;
+        }
+        session.takeOutput();
+    }
+
+    REQUIRE(session.isFinished());
+    REQUIRE(realTimeInputs > 0);
+    REQUIRE_FALSE(sawTurnBasedCombat);
+    REQUIRE_FALSE(session.needsUpdates());
+}
@@ -0,0 +1,136 @@
+#include <catch2/catch_test_macros.hpp>
+#include <random>
+#include <vector>
+
+#include "../src/effects/statuseffects.hpp"
+#include "../src/enemies/enemy.hpp"
+#include "../src/player/player.hpp"
+
+TEST_CASE("Effects last exactly their duration", "[StatusEffects]") {
+    StatusEffects effects;
+    effects.apply(StatusEffectType::DEFENCE, 4, 3);
+    effects.apply(StatusEffectType::DEFENCE, 2, 1);
+    REQUIRE(effects.getModifier(StatusEffectType::DEFENCE) == 6);
+    REQUIRE(effects.getActiveCount() == 2);
+
+    effects.tick();
+    REQUIRE(effects.getModifier(StatusEffectType::DEFENCE) == 4);
+    effects.tick();
+    REQUIRE(effects.getModifier(StatusEffectType::DEFENCE) == 4);
+    effects.tick();
+    REQUIRE(effects.getModifier(StatusEffectType::DEFENCE) == 0);
+    REQUIRE(effects.getActiveCount() == 0);
+    REQUIRE(effects.getTurn() == 3);
+
+    // Zero-length effects never start
+    effects.apply(StatusEffectType::DAMAGE_BOOST, 5, 0);
+    REQUIRE(effects.getActiveCount() == 0);
+}
+
+TEST_CASE("Poison and regen are reported on every turn they're active", "[StatusEffects]") {
+    StatusEffects effects;
+    effects.apply(StatusEffectType::POISON, 3, 2);
+    effects.apply(StatusEffectType::STAMINA_REGEN, 5, 1);
+
+    StatusTick first = effects.tick();
+    REQUIRE(first.poisonDamage == 3);
+    REQUIRE(first.staminaRegen == 5);
+    StatusTick second = effects.tick();
+    REQUIRE(second.poisonDamage == 3);
+    REQUIRE(second.staminaRegen == 0);
+    StatusTick third = effects.tick();
+    REQUIRE(third.poisonDamage == 0);
+}
+
+TEST_CASE("Long effects cascade through the outer wheel", "[StatusEffects]") {
+    StatusEffects effects;
+    // Land well off a lap boundary so the cascade has to re-slot them
+    for (int i = 0; i < 10; ++i) effects.tick();
+    effects.apply(StatusEffectType::RESISTANCE, 1, 100);
+    effects.apply(StatusEffectType::RESISTANCE, 10, 1000);
+    effects.apply(StatusEffectType::RESISTANCE, 100, 1000000);  // Clamped
+
+    for (uint32_t turn = 1; turn <= StatusEffects::MAX_DURATION; ++turn) {
+        effects.tick();
+        int expected = (turn < 100 ? 1 : 0) + (turn < 1000 ? 10 : 0) +
+                       (turn < StatusEffects::MAX_DURATION ? 100 : 0);
+        REQUIRE(effects.getModifier(StatusEffectType::RESISTANCE) == expected);
+    }
+    REQUIRE(effects.getActiveCount() == 0);
+}
+
+TEST_CASE("The wheel agrees with a naive list of effects", "[StatusEffects]") {
+    struct NaiveEffect {
+        StatusEffectType type;
+        int magnitude;
+        uint64_t expiresAt;
+    };
+
+    std::mt19937 rng(1234);
+    StatusEffects effects;
+    std::vector<NaiveEffect> naive;
+    for (uint64_t turn = 0; turn < 20000; ++turn) {
+        if (rng() % 3 == 0) {
+            auto type = static_cast<StatusEffectType>(rng() % STATUS_EFFECT_TYPE_COUNT);
+            int magnitude = static_cast<int>(rng() % 20) - 5;
+            uint32_t duration = 1 + rng() % (rng() % 4 == 0 ? 5000 : 80);
+            if (duration > StatusEffects::MAX_DURATION) duration = StatusEffects::MAX_DURATION;
+            effects.apply(type, magnitude, duration);
+            naive.push_back({type, magnitude, turn + duration});
+        }
+
+        effects.tick();
+        std::vector<NaiveEffect> stillActive;
+        for (const NaiveEffect& effect : naive) {
+            if (effect.expiresAt > turn + 1) stillActive.push_back(effect);
+        }
+        naive.swap(stillActive);
+
+        int expected[STATUS_EFFECT_TYPE_COUNT] = {};
+        for (const NaiveEffect& effect : naive) {
+            expected[static_cast<size_t>(effect.type)] += effect.magnitude;
+        }
+        for (size_t i = 0; i < STATUS_EFFECT_TYPE_COUNT; ++i) {
+            REQUIRE(effects.getModifier(static_cast<StatusEffectType>(i)) == expected[i]);
+        }
+        REQUIRE(effects.getActiveCount() == naive.size());
+    }
+}
+
+TEST_CASE("Clearing drops every effect", "[StatusEffects]") {
+    StatusEffects effects;
+    effects.apply(StatusEffectType::DAMAGE_BOOST, 3, 5);
+    effects.apply(StatusEffectType::POISON, 2, 500);
+    effects.clear();
+
+    REQUIRE(effects.getActiveCount() == 0);
+    REQUIRE(effects.getModifier(StatusEffectType::DAMAGE_BOOST) == 0);
+    for (int i = 0; i < 600; ++i) REQUIRE(effects.tick().poisonDamage == 0);
+}
+
+TEST_CASE("Players and enemies see their effects in their stats", "[StatusEffects]") {
+    Player player("Test Player", 100, 100, 50, 50, 5, 3, 1, 0, 100, 100, 0);
+    player.getStatusEffects().apply(StatusEffectType::DEFENCE, 10, 2);
+    REQUIRE(player.getDefence() == 15);
+    player.takeDamage(20);
+    REQUIRE(player.getHealth() == 95);
+
+    // Debuffs count too
+    player.getStatusEffects().apply(StatusEffectType::RESISTANCE, -2, 2);
+    REQUIRE(player.getResistance() == 1);
+
+    player.getStatusEffects().tick();
+    player.getStatusEffects().tick();
+    REQUIRE(player.getDefence() == 5);
+    REQUIRE(player.getResistance() == 3);
+
+    Enemy enemy("Goblin", "A small goblin.", 1, 30, 2, 4, 2, 1, EnemyType::GOBLINOID,
+                EnemyRarity::COMMON);
+    enemy.getStatusEffects().apply(StatusEffectType::DEFENCE, 3, 1);
+    enemy.takeDamage(10);
+    REQUIRE(enemy.getHealth() == 25);
+
+    // Poison ignores defence
+    enemy.loseHealth(4);
+    REQUIRE(enemy.getHealth() == 21);
+}
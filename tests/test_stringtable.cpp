@@ -0,0 +1,85 @@
+#include <catch2/catch_test_macros.hpp>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../src/enemies/enemydatabase.hpp"
+#include "../src/items/itemdatabase.hpp"
+#include "../src/levels/leveldatabase.hpp"
+#include "../src/text/stringtable.hpp"
+
+TEST_CASE("Interning gives one stable id per distinct text", "[StringTable]") {
+    StringTable& table = StringTable::getInstance();
+    REQUIRE(table.get(0).empty());
+    REQUIRE(table.intern("") == 0);
+
+    uint32_t first = table.intern("Test Interned Name");
+    std::string copy = "Test Interned Name";
+    REQUIRE(table.intern(copy) == first);
+    REQUIRE(table.get(first) == "Test Interned Name");
+    REQUIRE(table.intern("Test Interned Other") != first);
+
+    // Ids out of range read as empty
+    REQUIRE(table.get(static_cast<uint32_t>(table.size())).empty());
+}
+
+TEST_CASE("Interned strings compare by id", "[StringTable]") {
+    InternedString empty;
+    REQUIRE(empty.empty());
+    REQUIRE(empty == "");
+    REQUIRE(sizeof(InternedString) == 4);
+
+    InternedString a("Test Goblin");
+    InternedString b(std::string("Test Goblin"));
+    InternedString c("Test Goblin Chief");
+    REQUIRE(a == b);
+    REQUIRE(a.getId() == b.getId());
+    REQUIRE(a != c);
+    REQUIRE(a == "Test Goblin");
+    REQUIRE(a != "Test Goblin Chief");
+    REQUIRE(c.view() == "Test Goblin Chief");
+}
+
+TEST_CASE("Content shares one copy of repeated text", "[StringTable]") {
+    LevelDatabase& levels = LevelDatabase::getInstance();
+    levels.initialize();
+    REQUIRE(levels.getLevelTemplate(11)->levelTitle == levels.getLevelTemplate(15)->levelTitle);
+    REQUIRE(levels.getLevelTemplate(11)->levelTitle.getId() ==
+            levels.getLevelTemplate(12)->levelTitle.getId());
+
+    ItemDatabase& items = ItemDatabase::getInstance();
+    items.initialize();
+    const ItemTemplate* sword = items.getItemTemplate("Iron Sword");
+    Item* first = items.createItem("Iron Sword", 1);
+    Item* second = items.createItem(*sword, 2);
+    REQUIRE(first->getName() == "Iron Sword");
+    REQUIRE(first->getName().data() == second->getName().data());
+    REQUIRE(first->getDescription().data() == sword->description.view().data());
+    delete first;
+    delete second;
+
+    EnemyDatabase& enemies = EnemyDatabase::getInstance();
+    enemies.initialize();
+    std::unique_ptr<Enemy> wolf = enemies.createEnemy("Forest Wolf");
+    REQUIRE(wolf->getInternedName() == enemies.getEnemyTemplate("Forest Wolf")->name);
+}
+
+TEST_CASE("Interning is safe across threads", "[StringTable]") {
+    std::vector<std::thread> threads;
+    std::vector<uint32_t> ids(4);
+    for (size_t t = 0; t < ids.size(); ++t) {
+        threads.emplace_back([t, &ids]() {
+            for (int i = 0; i < 500; ++i) {
+                InternedString text("Test Thread Name " + std::to_string(i));
+                if (text.view() != "Test Thread Name " + std::to_string(i)) return;
+            }
+            ids[t] = StringTable::getInstance().intern("Test Thread Name 499");
+        });
+    }
+    for (std::thread& thread : threads) thread.join();
+    for (uint32_t id : ids) {
+        REQUIRE(id != 0);
+        REQUIRE(id == ids[0]);
+    }
+}
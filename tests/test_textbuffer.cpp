@@ -0,0 +1,49 @@
+#include <catch2/catch_test_macros.hpp>
+#include <climits>
+#include <cstdint>
+#include <string>
+
+#include "../src/text/textbuffer.hpp"
+
+TEST_CASE("Text and numbers are appended in order", "[TextBuffer]") {
+    TextBuffer out;
+    REQUIRE(out.empty());
+    std::string name = "Goblin";
+    out << "A " << name << " (Level " << 3 << ")" << '\n';
+    out << -42 << ' ' << 7u << ' ' << UINT64_MAX << ' ' << INT64_MIN;
+    REQUIRE(out.view() ==
+            "A Goblin (Level 3)\n-42 7 18446744073709551615 -9223372036854775808");
+}
+
+TEST_CASE("format fills placeholders in order", "[TextBuffer]") {
+    TextBuffer out;
+    out.format("You deal {} damage to {}!", 12, "the Goblin");
+    REQUIRE(out.view() == "You deal 12 damage to the Goblin!");
+
+    out.clear();
+    out.format("{}/{} HP", 5, 10, 99);  // Extra arguments are dropped
+    out.format(" [{}]", std::string("ok"));
+    out.format(" no slots");
+    REQUIRE(out.view() == "5/10 HP [ok] no slots");
+
+    out.clear();
+    out.format("{} of {}", 1);  // Missing arguments leave the placeholder
+    REQUIRE(out.view() == "1 of {}");
+}
+
+TEST_CASE("Clearing keeps the buffer for the next frame", "[TextBuffer]") {
+    TextBuffer out;
+    for (int i = 0; i < 100; ++i) out << "line " << i << '\n';
+    out.clear();
+    REQUIRE(out.empty());
+    out << "next";
+    REQUIRE(out.view() == "next");
+}
+
+TEST_CASE("Stream writers land in the buffer", "[TextBuffer]") {
+    TextBuffer out;
+    out << "before ";
+    out.stream() << "streamed " << 3 << '\n';
+    out << "after";
+    REQUIRE(out.view() == "before streamed 3\nafter");
+}